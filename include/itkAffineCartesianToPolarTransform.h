@@ -0,0 +1,202 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAffineCartesianToPolarTransform_h
+#define itkAffineCartesianToPolarTransform_h
+
+#include "itkCartesianToPolarTransform.h"
+#include "itkCompositeTransform.h"
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+class PolarToCartesianAffineTransform;
+
+/** \class AffineCartesianToPolarTransform
+ *
+ * \brief Affine pre-alignment followed by a CartesianToPolarTransform, fused into one transform.
+ *
+ * Maps a point x to the polar coordinates of \f$ y = A x + t \f$, with the
+ * Matrix A and the Offset t. It equals a CompositeTransform of an affine
+ * transform followed by a CartesianToPolarTransform, but costs one virtual
+ * call per point instead of two, and the batch TransformPoints() apply the
+ * matrix and the polar kernel to a block of points in one pass, with the
+ * Offset folded into the Center of the kernel. SetFromCompositeTransform()
+ * collapses such a CompositeTransform.
+ *
+ * Center, AngleOffset, ConstArcIncr, AngleEvaluation and UseLegacyConvention
+ * are those of the polar mapping, in the space of y. The transform has no parameters.
+ *
+ * \sa PolarToCartesianAffineTransform
+ *
+ * \ingroup Transforms
+ * \ingroup PolarTransform
+ */
+template <typename TParametersValueType = double, // Data type for scalars (float or double)
+          unsigned int NDimensions = 3>           // Number of dimensions
+class ITK_TEMPLATE_EXPORT AffineCartesianToPolarTransform
+  : public CartesianToPolarTransform<TParametersValueType, NDimensions>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(AffineCartesianToPolarTransform);
+
+  /** Standard class type alias. */
+  using Self = AffineCartesianToPolarTransform;
+  using Superclass = CartesianToPolarTransform<TParametersValueType, NDimensions>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** New macro for creation of through the object factory.*/
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(AffineCartesianToPolarTransform);
+
+  /** Dimension of the domain space. */
+  static constexpr unsigned int SpaceDimension = NDimensions;
+
+  using ScalarType = typename Superclass::ScalarType;
+  using JacobianPositionType = typename Superclass::JacobianPositionType;
+  using InverseJacobianPositionType = typename Superclass::InverseJacobianPositionType;
+  using InputPointType = typename Superclass::InputPointType;
+  using OutputPointType = typename Superclass::OutputPointType;
+  using InputVectorType = typename Superclass::InputVectorType;
+
+  /** Type of the affine pre-alignment. */
+  using MatrixType = Matrix<TParametersValueType, NDimensions, NDimensions>;
+  using OffsetType = InputVectorType;
+
+  /** CompositeTransform that SetFromCompositeTransform() collapses. */
+  using CompositeTransformType = CompositeTransform<TParametersValueType, NDimensions>;
+
+  /** Inverse transform type alias. */
+  using InverseTransformType = PolarToCartesianAffineTransform<TParametersValueType, NDimensions>;
+  using InverseTransformBasePointer = typename Superclass::InverseTransformBasePointer;
+
+  /** Method to transform a point.
+   * Applies the Matrix and the Offset, and then the polar mapping of CartesianToPolarTransform.
+   */
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override;
+
+  /** Method to transform a batch of points stored contiguously (array of structures).
+   *
+   * Applies the affine mapping to blocks of points and passes them to the
+   * vectorized kernel of CartesianToPolarTransform. The output may be the
+   * same buffer as the input.
+   */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
+  /** Method to transform a batch of points stored as a structure of arrays.
+   *
+   * inputComponents[d][i] is coordinate d of point i. Each output component
+   * may be the same buffer as the corresponding input component.
+   */
+  void
+  TransformPoints(const ScalarType * const * inputComponents,
+                  ScalarType * const *       outputComponents,
+                  SizeValueType              numberOfPoints) const override;
+
+  /** Compute the Jacobian of the transform with respect to the cartesian input point.
+   *
+   * It is the Jacobian of CartesianToPolarTransform at \f$ A x + t \f$ times
+   * the Matrix.
+   */
+  void
+  ComputeJacobianWithRespectToPosition(const InputPointType & point, JacobianPositionType & jacobian) const override;
+
+  /** Compute the inverse of the Jacobian with respect to the cartesian input point.
+   *
+   * Throws if the Matrix is singular.
+   */
+  void
+  ComputeInverseJacobianWithRespectToPosition(const InputPointType &        point,
+                                              InverseJacobianPositionType & jacobian) const override;
+
+  using Superclass::ComputeJacobianWithRespectToPosition;
+  using Superclass::ComputeInverseJacobianWithRespectToPosition;
+
+  /** Fill a PolarToCartesianAffineTransform with the polar settings of this transform and the inverse of the
+   * affine mapping. Returns false if the Matrix is singular. */
+  bool
+  GetInverse(InverseTransformType * inverse) const;
+
+  /** Return a PolarToCartesianAffineTransform inverting this transform. */
+  InverseTransformBasePointer
+  GetInverseTransform() const override;
+
+  /** Compute a bounding box of the polar points that the cartesian box [inputMinimum,inputMaximum] maps to.
+   *
+   * The bounding box of the affine image of the box is passed to
+   * CartesianToPolarTransform::ComputeOutputBoundingBox(), so the bounds are
+   * not tight unless the Matrix maps the axes onto the axes.
+   */
+  void
+  ComputeOutputBoundingBox(const InputPointType & inputMinimum,
+                           const InputPointType & inputMaximum,
+                           OutputPointType &      outputMinimum,
+                           OutputPointType &      outputMaximum) const;
+
+  /** Take the settings from a CompositeTransform that applies one or more
+   * transforms derived from MatrixOffsetTransformBase, e.g. AffineTransform,
+   * Euler3DTransform or Similarity2DTransform, and then a
+   * CartesianToPolarTransform, i.e. the CartesianToPolarTransform was added
+   * first. The affine transforms are multiplied into one.
+   *
+   * Returns false and leaves this transform unchanged if the composite has
+   * any other structure.
+   */
+  bool
+  SetFromCompositeTransform(const CompositeTransformType * composite);
+
+  /** Set/Get the matrix A of the affine pre-alignment. Defaults to the identity. */
+  itkSetMacro(Matrix, MatrixType);
+  itkGetConstReferenceMacro(Matrix, MatrixType);
+
+  /** Set/Get the translation t of the affine pre-alignment. Defaults to 0. */
+  itkSetMacro(Offset, OffsetType);
+  itkGetConstReferenceMacro(Offset, OffsetType);
+
+protected:
+  AffineCartesianToPolarTransform();
+  ~AffineCartesianToPolarTransform() override = default;
+
+  /** Print contents of an AffineCartesianToPolarTransform. */
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Kernel settings with the Offset folded into the Center, for points mapped by the Matrix only. */
+  PolarTransformKernels::Parameters<ScalarType>
+  GetFusedKernelParameters() const;
+
+private:
+  MatrixType m_Matrix;
+  OffsetType m_Offset;
+}; // class AffineCartesianToPolarTransform
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkAffineCartesianToPolarTransform.hxx"
+#endif
+
+#endif
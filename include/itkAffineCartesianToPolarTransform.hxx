@@ -0,0 +1,314 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkAffineCartesianToPolarTransform_hxx
+#define itkAffineCartesianToPolarTransform_hxx
+
+#include "itkMatrixOffsetTransformBase.h"
+#include "itkPolarToCartesianAffineTransform.h"
+#include <algorithm>
+#include <typeinfo>
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::AffineCartesianToPolarTransform()
+{
+  m_Matrix.SetIdentity();
+  m_Offset.Fill(0.0);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Matrix: " << std::endl;
+  os << m_Matrix;
+  os << indent << "Offset: " << m_Offset << std::endl;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+typename AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::OutputPointType
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::TransformPoint(
+  const InputPointType & inputPoint) const
+{
+  return Superclass::TransformPoint(m_Matrix * inputPoint + m_Offset);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  constexpr SizeValueType BlockSize = 256;
+
+  ScalarType mapped[SpaceDimension][BlockSize];
+  ScalarType alpha[BlockSize];
+  ScalarType radius[BlockSize];
+
+  const PolarTransformKernels::Parameters<ScalarType> parameters = this->GetFusedKernelParameters();
+
+  PolarTransformTally tally;
+  auto                start = PolarTransformTally::Now();
+
+  for (SizeValueType begin = 0; begin < numberOfPoints; begin += BlockSize)
+  {
+    const SizeValueType count = std::min(BlockSize, numberOfPoints - begin);
+    for (unsigned int r = 0; r < SpaceDimension; ++r)
+    {
+      for (SizeValueType i = 0; i < count; ++i)
+      {
+        ScalarType value = 0.0;
+        for (unsigned int c = 0; c < SpaceDimension; ++c)
+        {
+          value += m_Matrix[r][c] * inputPoints[begin + i][c];
+        }
+        mapped[r][i] = value;
+      }
+    }
+
+    PolarTransformKernels::CartesianToPolar(mapped[0], mapped[1], alpha, radius, count, parameters);
+    tally.CountPolarOutputs(alpha, radius, count);
+
+    // The block is read completely before it is written, so the output may be the input.
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      OutputPointType & outputPoint = outputPoints[begin + i];
+      outputPoint[0] = alpha[i];
+      outputPoint[1] = radius[i];
+      for (unsigned int d = 2; d < SpaceDimension; ++d)
+      {
+        outputPoint[d] = mapped[d][i] + m_Offset[d];
+      }
+    }
+  }
+
+  tally.AddTransformTime(start);
+  this->AddEvaluationTally(tally);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const ScalarType * const * inputComponents,
+  ScalarType * const *       outputComponents,
+  SizeValueType              numberOfPoints) const
+{
+  constexpr SizeValueType BlockSize = 256;
+
+  ScalarType mapped[SpaceDimension][BlockSize];
+
+  const PolarTransformKernels::Parameters<ScalarType> parameters = this->GetFusedKernelParameters();
+
+  PolarTransformTally tally;
+  auto                start = PolarTransformTally::Now();
+
+  for (SizeValueType begin = 0; begin < numberOfPoints; begin += BlockSize)
+  {
+    const SizeValueType count = std::min(BlockSize, numberOfPoints - begin);
+    for (unsigned int r = 0; r < SpaceDimension; ++r)
+    {
+      std::fill_n(mapped[r], count, ScalarType{});
+      for (unsigned int c = 0; c < SpaceDimension; ++c)
+      {
+        const ScalarType   coefficient = m_Matrix[r][c];
+        const ScalarType * component = inputComponents[c] + begin;
+        for (SizeValueType i = 0; i < count; ++i)
+        {
+          mapped[r][i] += coefficient * component[i];
+        }
+      }
+    }
+
+    PolarTransformKernels::CartesianToPolar(
+      mapped[0], mapped[1], outputComponents[0] + begin, outputComponents[1] + begin, count, parameters);
+    tally.CountPolarOutputs(outputComponents[0] + begin, outputComponents[1] + begin, count);
+
+    for (unsigned int d = 2; d < SpaceDimension; ++d)
+    {
+      ScalarType * component = outputComponents[d] + begin;
+      for (SizeValueType i = 0; i < count; ++i)
+      {
+        component[i] = mapped[d][i] + m_Offset[d];
+      }
+    }
+  }
+
+  tally.AddTransformTime(start);
+  this->AddEvaluationTally(tally);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::ComputeJacobianWithRespectToPosition(
+  const InputPointType & point,
+  JacobianPositionType & jacobian) const
+{
+  JacobianPositionType polarJacobian;
+  Superclass::ComputeJacobianWithRespectToPosition(m_Matrix * point + m_Offset, polarJacobian);
+  jacobian = polarJacobian * m_Matrix.GetVnlMatrix();
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::ComputeInverseJacobianWithRespectToPosition(
+  const InputPointType &        point,
+  InverseJacobianPositionType & jacobian) const
+{
+  InverseJacobianPositionType polarJacobian;
+  Superclass::ComputeInverseJacobianWithRespectToPosition(m_Matrix * point + m_Offset, polarJacobian);
+  jacobian = m_Matrix.GetInverse() * polarJacobian;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::GetInverse(InverseTransformType * inverse) const
+{
+  if (!inverse)
+  {
+    return false;
+  }
+
+  MatrixType inverseMatrix;
+  try
+  {
+    inverseMatrix = m_Matrix.GetInverse();
+  }
+  catch (const ExceptionObject &)
+  {
+    return false;
+  }
+
+  Superclass::GetInverse(inverse);
+  inverse->SetMatrix(inverseMatrix);
+  inverse->SetOffset(-(inverseMatrix * m_Offset));
+  return true;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::GetInverseTransform() const
+  -> InverseTransformBasePointer
+{
+  const auto inverse = InverseTransformType::New();
+  return this->GetInverse(inverse) ? inverse.GetPointer() : nullptr;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::ComputeOutputBoundingBox(
+  const InputPointType & inputMinimum,
+  const InputPointType & inputMaximum,
+  OutputPointType &      outputMinimum,
+  OutputPointType &      outputMaximum) const
+{
+  InputPointType mappedMinimum;
+  InputPointType mappedMaximum;
+  mappedMinimum.Fill(NumericTraits<ScalarType>::max());
+  mappedMaximum.Fill(NumericTraits<ScalarType>::NonpositiveMin());
+  for (unsigned int corner = 0; corner < (1u << SpaceDimension); ++corner)
+  {
+    InputPointType point;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      point[d] = ((corner >> d) & 1) ? inputMaximum[d] : inputMinimum[d];
+    }
+    const InputPointType mapped = m_Matrix * point + m_Offset;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      mappedMinimum[d] = std::min(mappedMinimum[d], mapped[d]);
+      mappedMaximum[d] = std::max(mappedMaximum[d], mapped[d]);
+    }
+  }
+  Superclass::ComputeOutputBoundingBox(mappedMinimum, mappedMaximum, outputMinimum, outputMaximum);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::SetFromCompositeTransform(
+  const CompositeTransformType * composite)
+{
+  using AffineType = MatrixOffsetTransformBase<TParametersValueType, NDimensions, NDimensions>;
+
+  if (composite == nullptr || composite->GetNumberOfTransforms() == 0)
+  {
+    return false;
+  }
+
+  // The queue is applied from the back to the front, so the polar transform is at the front.
+  const auto * polar = composite->GetNthTransformConstPointer(0);
+  if (polar == nullptr || typeid(*polar) != typeid(Superclass))
+  {
+    return false;
+  }
+
+  MatrixType matrix;
+  matrix.SetIdentity();
+  OffsetType offset;
+  offset.Fill(0.0);
+  for (SizeValueType n = composite->GetNumberOfTransforms() - 1; n > 0; --n)
+  {
+    const auto * affine = dynamic_cast<const AffineType *>(composite->GetNthTransformConstPointer(n));
+    if (affine == nullptr)
+    {
+      return false;
+    }
+    matrix = affine->GetMatrix() * matrix;
+    offset = affine->GetMatrix() * offset + affine->GetOffset();
+  }
+
+  const auto * polarTransform = static_cast<const Superclass *>(polar);
+  this->SetCenter(polarTransform->GetCenter());
+  this->SetAngleOffset(polarTransform->GetAngleOffset());
+  this->SetConstArcIncr(polarTransform->GetConstArcIncr());
+  this->SetAngleEvaluation(polarTransform->GetAngleEvaluation());
+  this->SetUseLegacyConvention(polarTransform->GetUseLegacyConvention());
+  this->SetMatrix(matrix);
+  this->SetOffset(offset);
+  return true;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+AffineCartesianToPolarTransform<TParametersValueType, NDimensions>::GetFusedKernelParameters() const
+  -> PolarTransformKernels::Parameters<ScalarType>
+{
+  // (A x + t) - c = A x - (c - t)
+  PolarTransformKernels::Parameters<ScalarType> parameters = this->GetKernelParameters();
+  parameters.CenterX -= m_Offset[0];
+  parameters.CenterY -= m_Offset[1];
+  return parameters;
+}
+
+} // namespace itk
+
+#endif
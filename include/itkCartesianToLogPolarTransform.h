@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCartesianToLogPolarTransform_h
+#define itkCartesianToLogPolarTransform_h
+
+#include "itkCartesianToPolarTransform.h"
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+class LogPolarToCartesianTransform;
+
+/** \class CartesianToLogPolarTransform
+ *
+ * \brief Log-polar transformation of a vector space (e.g. space coordinates).
+ *
+ * Transforms the first two coordinates from cartesian coordinates to
+ * log-polar coordinates <alpha,rho>, where rho is the natural logarithm of
+ * the distance to the Center:
+ * \f[          \rho = \log \sqrt{ x_0^2 + x_1^2 } \f]
+ * \f[          x_n = x_n, \mbox{n >= 2} \f]
+ * The angle alpha is that of CartesianToPolarTransform, and the Center maps
+ * to rho = -inf.
+ *
+ * \par
+ * The transform is a CartesianToPolarTransform followed by the logarithm of
+ * the radius, so Center, AngleOffset, ConstArcIncr and AngleEvaluation have
+ * the same meaning and the batch TransformPoints() use its batch path. It
+ * inverts a LogPolarToCartesianTransform with the same settings.
+ *
+ * \sa LogPolarToCartesianTransform
+ *
+ * \ingroup Transforms
+ * \ingroup PolarTransform
+ */
+template <typename TParametersValueType = double, // Data type for scalars (float or double)
+          unsigned int NDimensions = 3>           // Number of dimensions
+class ITK_TEMPLATE_EXPORT CartesianToLogPolarTransform
+  : public CartesianToPolarTransform<TParametersValueType, NDimensions>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CartesianToLogPolarTransform);
+
+  /** Standard class type alias. */
+  using Self = CartesianToLogPolarTransform;
+  using Superclass = CartesianToPolarTransform<TParametersValueType, NDimensions>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** New macro for creation of through the object factory.*/
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(CartesianToLogPolarTransform);
+
+  /** Dimension of the domain space. */
+  static constexpr unsigned int SpaceDimension = NDimensions;
+
+  using ScalarType = typename Superclass::ScalarType;
+  using JacobianPositionType = typename Superclass::JacobianPositionType;
+  using InverseJacobianPositionType = typename Superclass::InverseJacobianPositionType;
+  using InputPointType = typename Superclass::InputPointType;
+  using OutputPointType = typename Superclass::OutputPointType;
+
+  /** Inverse transform type alias. */
+  using InverseTransformType = LogPolarToCartesianTransform<TParametersValueType, NDimensions>;
+  using InverseTransformBasePointer = typename Superclass::InverseTransformBasePointer;
+
+  /** Method to transform a point.
+   * This method transforms first two dimensions of a point from cartesian
+   * coordinates to log-polar coordinates <alpha,rho>.
+   */
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override;
+
+  /** Method to transform a batch of points stored contiguously (array of structures).
+   *
+   * Uses the batch path of CartesianToPolarTransform and takes the logarithm
+   * of the radius. The output may be the same buffer as the input.
+   */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
+  /** Method to transform a batch of points stored as a structure of arrays.
+   *
+   * inputComponents[d][i] is coordinate d of point i. Each output component
+   * may be the same buffer as the corresponding input component.
+   */
+  void
+  TransformPoints(const ScalarType * const * inputComponents,
+                  ScalarType * const *       outputComponents,
+                  SizeValueType              numberOfPoints) const override;
+
+  /** Compute the Jacobian of the transform with respect to the cartesian input point.
+   *
+   * It is the Jacobian of CartesianToPolarTransform with the radius row
+   * divided by \f$ r \f$. The Jacobian is not defined at the Center.
+   */
+  void
+  ComputeJacobianWithRespectToPosition(const InputPointType & point, JacobianPositionType & jacobian) const override;
+
+  /** Compute the inverse of the Jacobian with respect to the cartesian input point in closed form. */
+  void
+  ComputeInverseJacobianWithRespectToPosition(const InputPointType &        point,
+                                              InverseJacobianPositionType & jacobian) const override;
+
+  using Superclass::ComputeJacobianWithRespectToPosition;
+  using Superclass::ComputeInverseJacobianWithRespectToPosition;
+
+  /** Fill a LogPolarToCartesianTransform with the Center, AngleOffset, ConstArcIncr and AngleEvaluation of this
+   * transform. */
+  bool
+  GetInverse(InverseTransformType * inverse) const;
+
+  /** Return a LogPolarToCartesianTransform inverting this transform. */
+  InverseTransformBasePointer
+  GetInverseTransform() const override;
+
+  /** Compute the bounding box of the log-polar points <alpha,rho> that the cartesian box
+   * [inputMinimum,inputMaximum] maps to.
+   *
+   * The logarithm is monotonic, so the rho range is the logarithm of the
+   * radius range of CartesianToPolarTransform::ComputeOutputBoundingBox(). It
+   * starts at -inf when the box contains the Center.
+   */
+  void
+  ComputeOutputBoundingBox(const InputPointType & inputMinimum,
+                           const InputPointType & inputMaximum,
+                           OutputPointType &      outputMinimum,
+                           OutputPointType &      outputMaximum) const;
+
+protected:
+  CartesianToLogPolarTransform() = default;
+  ~CartesianToLogPolarTransform() override = default;
+}; // class CartesianToLogPolarTransform
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCartesianToLogPolarTransform.hxx"
+#endif
+
+#endif
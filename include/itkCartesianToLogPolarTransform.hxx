@@ -0,0 +1,133 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCartesianToLogPolarTransform_hxx
+#define itkCartesianToLogPolarTransform_hxx
+
+#include "itkLogPolarToCartesianTransform.h"
+#include <cmath>
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+typename CartesianToLogPolarTransform<TParametersValueType, NDimensions>::OutputPointType
+CartesianToLogPolarTransform<TParametersValueType, NDimensions>::TransformPoint(const InputPointType & inputPoint) const
+{
+  OutputPointType result = Superclass::TransformPoint(inputPoint);
+  result[1] = std::log(result[1]); // rho = log(r)
+  return result;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToLogPolarTransform<TParametersValueType, NDimensions>::TransformPoints(const InputPointType * inputPoints,
+                                                                                 OutputPointType *      outputPoints,
+                                                                                 SizeValueType numberOfPoints) const
+{
+  Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    outputPoints[i][1] = std::log(outputPoints[i][1]); // rho = log(r)
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToLogPolarTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const ScalarType * const * inputComponents,
+  ScalarType * const *       outputComponents,
+  SizeValueType              numberOfPoints) const
+{
+  Superclass::TransformPoints(inputComponents, outputComponents, numberOfPoints);
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    outputComponents[1][i] = std::log(outputComponents[1][i]); // rho = log(r)
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToLogPolarTransform<TParametersValueType, NDimensions>::ComputeJacobianWithRespectToPosition(
+  const InputPointType & point,
+  JacobianPositionType & jacobian) const
+{
+  Superclass::ComputeJacobianWithRespectToPosition(point, jacobian);
+
+  // drho/dr = 1/r
+  const ScalarType dx = point[0] - this->GetCenter()[0];
+  const ScalarType dy = point[1] - this->GetCenter()[1];
+  const ScalarType radius = std::sqrt(dx * dx + dy * dy);
+  jacobian(1, 0) /= radius;
+  jacobian(1, 1) /= radius;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToLogPolarTransform<TParametersValueType, NDimensions>::ComputeInverseJacobianWithRespectToPosition(
+  const InputPointType &        point,
+  InverseJacobianPositionType & jacobian) const
+{
+  Superclass::ComputeInverseJacobianWithRespectToPosition(point, jacobian);
+
+  // dr/drho = r
+  const ScalarType dx = point[0] - this->GetCenter()[0];
+  const ScalarType dy = point[1] - this->GetCenter()[1];
+  const ScalarType radius = std::sqrt(dx * dx + dy * dy);
+  jacobian(0, 1) *= radius;
+  jacobian(1, 1) *= radius;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+CartesianToLogPolarTransform<TParametersValueType, NDimensions>::GetInverse(InverseTransformType * inverse) const
+{
+  return Superclass::GetInverse(inverse);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+CartesianToLogPolarTransform<TParametersValueType, NDimensions>::GetInverseTransform() const
+  -> InverseTransformBasePointer
+{
+  const auto inverse = InverseTransformType::New();
+  return this->GetInverse(inverse) ? inverse.GetPointer() : nullptr;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToLogPolarTransform<TParametersValueType, NDimensions>::ComputeOutputBoundingBox(
+  const InputPointType & inputMinimum,
+  const InputPointType & inputMaximum,
+  OutputPointType &      outputMinimum,
+  OutputPointType &      outputMaximum) const
+{
+  Superclass::ComputeOutputBoundingBox(inputMinimum, inputMaximum, outputMinimum, outputMaximum);
+  outputMinimum[1] = std::log(outputMinimum[1]);
+  outputMaximum[1] = std::log(outputMaximum[1]);
+}
+
+} // namespace itk
+
+#endif
@@ -0,0 +1,372 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCartesianToPolarImageFilter_h
+#define itkCartesianToPolarImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkInterpolateImageFunction.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkPolarToCartesianTransform.h"
+#include "itkPolarTransformEnums.h"
+#include "itkPolarTransformInstrumentation.h"
+#include <vector>
+
+namespace itk
+{
+
+/** \class CartesianToPolarImageFilter
+ *
+ * \brief Resample a cartesian image onto a regular polar grid <alpha,radius>.
+ *
+ * With SetAngleEvaluation(Exact) the filter produces the same output as a
+ * ResampleImageFilter driven by a PolarToCartesianTransform with the same
+ * Center, AngleOffset and ConstArcIncr settings. With the default,
+ * Incremental, the sine and cosine of the output angles differ from those of
+ * the transform within the bounds documented in
+ * PolarTransformEnums::AngleEvaluation. In either mode the filter does not
+ * evaluate the transform for every output pixel. Along the first output axis
+ * (alpha) the output grid is regular, and so is the second axis (radius), so
+ * cos/sin of every angle column and the radius of every row are computed once
+ * in BeforeThreadedGenerateData() and shared by all threads. Together with the
+ * physical point to index matrix of the input, every output pixel then costs
+ * two multiply-adds per dimension plus the interpolation.
+ *
+ * When ConstArcIncr is On the angle of a pixel depends on both its arc length
+ * and its radius, so cos/sin are evaluated per pixel in that mode. The angles
+ * of a scanline still form a uniform grid, so by default (AngleEvaluation
+ * Incremental) cos/sin are advanced along the scanline by a fixed rotation,
+ * reseeded with std::sin() and std::cos() at regular intervals. With
+ * AngleEvaluation set to Approximate, they are computed for a whole scanline
+ * at once with the vectorized PolarTransformKernels instead, and with Exact
+ * by std::sin() and std::cos() for every pixel.
+ *
+ * The filter supports streaming: it requests only the bounding region of the
+ * annulus sector that the requested output region maps to, see
+ * PolarToCartesianTransform::ComputeOutputBoundingBox().
+ *
+ * For volumes and time series whose first two input dimensions are
+ * independent of the others, UseInPlaneMap computes the cartesian input
+ * position of every pixel of one output slice once and reuses it for all
+ * slices.
+ *
+ * A scanline of the polar output follows a circle through the input, so at
+ * large radii consecutive pixels lie on distant input rows, and the rows read
+ * for one scanline are evicted before the next scanline needs them again.
+ * UseTiledTraversal resamples every work unit in tiles of consecutive angles
+ * and radii whose input footprint fits into TileCacheSize bytes instead.
+ *
+ * With LogPolar On the second output axis is the natural logarithm of the
+ * radius, matching a ResampleImageFilter driven by a
+ * LogPolarToCartesianTransform. The exponential is tabulated once per output
+ * row, so the log-polar path costs the same per pixel as the polar one.
+ *
+ * The output grid is defined by Size, OutputStartIndex, OutputOrigin and
+ * OutputSpacing. The direction of the polar output image is always identity.
+ * Dimensions other than the first two are left unchanged. Only scalar pixel
+ * types are supported.
+ *
+ * \sa PolarToCartesianTransform
+ * \sa LogPolarToCartesianTransform
+ * \sa PolarToCartesianImageFilter
+ *
+ * \ingroup GeometricTransform
+ * \ingroup PolarTransform
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage, typename TInterpolatorPrecisionType = double>
+class ITK_TEMPLATE_EXPORT CartesianToPolarImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CartesianToPolarImageFilter);
+
+  /** Standard class type alias. */
+  using Self = CartesianToPolarImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(CartesianToPolarImageFilter);
+
+  /** Image related type alias. */
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputImagePointer = typename InputImageType::Pointer;
+  using InputImageConstPointer = typename InputImageType::ConstPointer;
+  using InputImageRegionType = typename InputImageType::RegionType;
+  using OutputImagePointer = typename OutputImageType::Pointer;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using PixelType = typename OutputImageType::PixelType;
+
+  /** Number of dimensions. */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+  static_assert(ImageDimension >= 2, "Dimension must be at least 2.");
+  static_assert(TInputImage::ImageDimension == ImageDimension, "Input and output dimensions must agree.");
+
+  /** Interpolator type alias. */
+  using InterpolatorType = InterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+  using InterpolatorPointerType = typename InterpolatorType::Pointer;
+  using InterpolatorOutputType = typename InterpolatorType::OutputType;
+  using DefaultInterpolatorType = LinearInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+  using ContinuousIndexType = typename InterpolatorType::ContinuousIndexType;
+
+  /** Output grid type alias. */
+  using SizeType = typename OutputImageType::SizeType;
+  using IndexType = typename OutputImageType::IndexType;
+  using SpacingType = typename OutputImageType::SpacingType;
+  using OriginPointType = typename OutputImageType::PointType;
+
+  /** Scalar type used for the polar mapping. */
+  using ScalarType = TInterpolatorPrecisionType;
+
+  /** Point type of the cartesian input space. */
+  using PointType = typename InputImageType::PointType;
+
+  /** Transform mapping the polar output grid to the cartesian input, used for the input requested region. */
+  using PolarToCartesianTransformType = PolarToCartesianTransform<ScalarType, ImageDimension>;
+
+  using AngleEvaluationEnum = PolarTransformEnums::AngleEvaluation;
+
+  /** Set/Get the interpolator. Defaults to LinearInterpolateImageFunction. */
+  itkSetObjectMacro(Interpolator, InterpolatorType);
+  itkGetModifiableObjectMacro(Interpolator, InterpolatorType);
+
+  /** Set/Get the pixel value assigned to output pixels that map outside the input. */
+  itkSetMacro(DefaultPixelValue, PixelType);
+  itkGetConstReferenceMacro(DefaultPixelValue, PixelType);
+
+  /** Set/Get the size of the polar output image. */
+  itkSetMacro(Size, SizeType);
+  itkGetConstReferenceMacro(Size, SizeType);
+
+  /** Set/Get the start index of the polar output image. */
+  itkSetMacro(OutputStartIndex, IndexType);
+  itkGetConstReferenceMacro(OutputStartIndex, IndexType);
+
+  /** Set/Get the spacing of the polar output image, i.e. the angle and radius increments. */
+  itkSetMacro(OutputSpacing, SpacingType);
+  itkGetConstReferenceMacro(OutputSpacing, SpacingType);
+
+  /** Set/Get the origin of the polar output image, i.e. the first angle and radius. */
+  itkSetMacro(OutputOrigin, OriginPointType);
+  itkGetConstReferenceMacro(OutputOrigin, OriginPointType);
+
+  /** Set/Get the location of the center of the polar coordinate system in the input space. */
+  itkSetMacro(Center, PointType);
+  itkGetConstReferenceMacro(Center, PointType);
+
+  /** Set/Get an angular offset for the polar coordinate system.
+   *
+   * Defaults to 0.0
+   */
+  itkSetMacro(AngleOffset, ScalarType);
+  itkGetConstMacro(AngleOffset, ScalarType);
+
+  /** Enable/Disable to use constant arc increment instead of constant angular increment.
+   *
+   * Defaults to Off
+   */
+  itkSetMacro(ConstArcIncr, bool);
+  itkGetConstMacro(ConstArcIncr, bool);
+  itkBooleanMacro(ConstArcIncr);
+
+  /** Enable/Disable log-polar output, where the second output axis is log(radius) instead of radius.
+   *
+   * Defaults to Off
+   */
+  itkSetMacro(LogPolar, bool);
+  itkGetConstMacro(LogPolar, bool);
+  itkBooleanMacro(LogPolar);
+
+  /** Select how cos/sin of the output angles are evaluated.
+   *
+   * Exact calls std::sin() and std::cos() for every angle, and gives output
+   * identical to ResampleImageFilter up to the rounding of the index
+   * arithmetic. Incremental advances cos/sin along the uniform angle grid of
+   * the per column tables and of the scanlines of ConstArcIncr mode by a
+   * rotation. Approximate uses the polynomial approximation of
+   * PolarTransformKernels for the per pixel angles of ConstArcIncr mode, and
+   * exact per column tables. See PolarTransformEnums::AngleEvaluation for the
+   * error bounds. The result does not depend on how the output is split into
+   * threads or streamed regions.
+   *
+   * Defaults to Incremental
+   */
+  itkSetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+  itkGetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+
+  /** Enable/Disable reusing the in-plane mapping for all slices of a volume.
+   *
+   * The cartesian coordinates depend on the first two dimensions only. When
+   * the input direction does not mix them with the others, the filter computes
+   * the in-plane input index of every pixel of one slice of the requested
+   * output region once per update, and the threads resampling the slices and
+   * time points share it read-only. In ConstArcIncr mode the cos/sin are then
+   * evaluated once per in-plane pixel instead of once per voxel. Ignored for
+   * 2-D images and for input directions coupling the first two dimensions
+   * with the others.
+   *
+   * Defaults to Off
+   */
+  itkSetMacro(UseInPlaneMap, bool);
+  itkGetConstMacro(UseInPlaneMap, bool);
+  itkBooleanMacro(UseInPlaneMap);
+
+  /** Enable/Disable the cache-blocked traversal of the output.
+   *
+   * Every work unit is split into bands of radii no wider than a tile, and
+   * every band into runs of angles whose arc at the outer radius is no longer
+   * than a tile, so that the bounding box of the input read for one tile
+   * holds at most TileCacheSize bytes. The tiles are resampled one after the
+   * other, scanline by scanline, so the input is read from the cache instead
+   * of memory for large inputs. The output does not depend on the traversal.
+   *
+   * Defaults to Off
+   */
+  itkSetMacro(UseTiledTraversal, bool);
+  itkGetConstMacro(UseTiledTraversal, bool);
+  itkBooleanMacro(UseTiledTraversal);
+
+  /** Set/Get the number of input bytes the footprint of a tile may span, about the size of the L2 cache of a core.
+   *
+   * Defaults to 512 KiB
+   */
+  itkSetMacro(TileCacheSize, SizeValueType);
+  itkGetConstMacro(TileCacheSize, SizeValueType);
+
+  /** Counts and times of the resampling since construction or the last ResetEvaluationStatistics(): the output
+   * pixels, those mapping outside the input or to the center, and the time spent in the polar mapping and in the
+   * interpolation. They are only collected when the module is configured with PolarTransform_USE_INSTRUMENTATION,
+   * see PolarTransformStatistics. */
+  PolarTransformStatistics
+  GetEvaluationStatistics() const
+  {
+    return m_EvaluationCounters.GetStatistics();
+  }
+
+  void
+  ResetEvaluationStatistics()
+  {
+    m_EvaluationCounters.Reset();
+  }
+
+protected:
+  CartesianToPolarImageFilter();
+  ~CartesianToPolarImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The polar output grid is not derived from the input. */
+  void
+  GenerateOutputInformation() override;
+
+  /** Request the bounding region of the annulus sector that the requested output region maps to, padded by
+   * the radius of the interpolator. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Connect the interpolator, build the per-axis angle and radius tables and the in-plane map if it is used. */
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  /** Release the reference to the input held by the interpolator and the in-plane map. */
+  void
+  AfterThreadedGenerateData() override;
+
+  /** The input and output grids are unrelated, skip the superclass check. */
+  void
+  VerifyInputInformation() ITKv5_CONST override
+  {}
+
+  /** Whether the input direction keeps the first two dimensions apart from the others, so that every slice has the
+   * same in-plane mapping. */
+  bool
+  IsInPlaneSeparable() const;
+
+private:
+  /** r*cos(alpha + AngleOffset) and r*sin(alpha + AngleOffset) of the output columns starting at firstColumn, for the
+   * length of lineCos. */
+  void
+  ComputeLineCartesianOffsets(const ScalarType          radius,
+                              const SizeValueType       firstColumn,
+                              std::vector<ScalarType> & lineCos,
+                              std::vector<ScalarType> & lineSin) const;
+
+  /** Resample a region scanline by scanline, through m_InPlaneMap if it is built. */
+  void
+  GenerateDataForRegion(const OutputImageRegionType & outputRegion);
+
+  /** Split a region into the tiles of the cache-blocked traversal, in the order they are resampled. */
+  std::vector<OutputImageRegionType>
+  ComputeTiles(const OutputImageRegionType & outputRegion) const;
+
+  /** Compute m_InPlaneMap for the first two dimensions of the requested output region. */
+  void
+  BuildInPlaneMap();
+
+  /** Resample the slices of a region through m_InPlaneMap. */
+  void
+  GenerateDataWithInPlaneMap(const OutputImageRegionType & outputRegionForThread);
+
+  InterpolatorPointerType m_Interpolator;
+  PixelType               m_DefaultPixelValue{};
+
+  SizeType        m_Size;
+  IndexType       m_OutputStartIndex;
+  SpacingType     m_OutputSpacing;
+  OriginPointType m_OutputOrigin;
+
+  PointType           m_Center;
+  ScalarType          m_AngleOffset = 0;
+  bool                m_ConstArcIncr = false;
+  bool                m_LogPolar = false;
+  AngleEvaluationEnum m_AngleEvaluation = AngleEvaluationEnum::Incremental;
+  bool                m_UseInPlaneMap = false;
+  bool                m_UseTiledTraversal = false;
+  SizeValueType       m_TileCacheSize = 512 * 1024;
+
+  /** cos/sin of (alpha + AngleOffset) per output column, or alpha per column when ConstArcIncr is On. */
+  std::vector<ScalarType> m_CosTable;
+  std::vector<ScalarType> m_SinTable;
+  std::vector<ScalarType> m_AngleTable;
+
+  /** Radius per output row, exp() of the output coordinate when LogPolar is On. */
+  std::vector<ScalarType> m_RadiusTable;
+
+  PolarTransformCounters m_EvaluationCounters;
+
+  /** Continuous input index in the first two dimensions of every pixel of one slice of m_InPlaneMapRegion,
+   * interleaved. The first value is NaN for pixels mapping outside the input. */
+  std::vector<ScalarType> m_InPlaneMap;
+  OutputImageRegionType   m_InPlaneMapRegion;
+}; // class CartesianToPolarImageFilter
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCartesianToPolarImageFilter.hxx"
+#endif
+
+#endif
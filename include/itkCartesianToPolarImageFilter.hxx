@@ -0,0 +1,618 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCartesianToPolarImageFilter_hxx
+#define itkCartesianToPolarImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkNumericTraits.h"
+#include "itkPolarImageFilterHelpers.h"
+#include "itkPolarTransformKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::CartesianToPolarImageFilter()
+  : m_Interpolator(DefaultInterpolatorType::New())
+{
+  m_Size.Fill(0);
+  m_OutputStartIndex.Fill(0);
+  m_OutputSpacing.Fill(1.0);
+  m_OutputOrigin.Fill(0.0);
+  m_Center.Fill(0.0);
+
+  this->DynamicMultiThreadingOn();
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::PrintSelf(std::ostream & os,
+                                                                                            Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Interpolator);
+  os << indent << "DefaultPixelValue: " << static_cast<typename NumericTraits<PixelType>::PrintType>(m_DefaultPixelValue)
+     << std::endl;
+  os << indent << "Size: " << m_Size << std::endl;
+  os << indent << "OutputStartIndex: " << m_OutputStartIndex << std::endl;
+  os << indent << "OutputSpacing: " << m_OutputSpacing << std::endl;
+  os << indent << "OutputOrigin: " << m_OutputOrigin << std::endl;
+  os << indent << "Center: " << m_Center << std::endl;
+  os << indent << "AngleOffset: " << m_AngleOffset << std::endl;
+  os << indent << "ConstArcIncr: " << (m_ConstArcIncr ? "On" : "Off") << std::endl;
+  os << indent << "LogPolar: " << (m_LogPolar ? "On" : "Off") << std::endl;
+  os << indent << "AngleEvaluation: " << m_AngleEvaluation << std::endl;
+  os << indent << "UseInPlaneMap: " << (m_UseInPlaneMap ? "On" : "Off") << std::endl;
+  os << indent << "UseTiledTraversal: " << (m_UseTiledTraversal ? "On" : "Off") << std::endl;
+  os << indent << "TileCacheSize: " << m_TileCacheSize << std::endl;
+  if (PolarTransformCounters::Enabled)
+  {
+    os << indent << "EvaluationStatistics: " << m_EvaluationCounters.GetStatistics() << std::endl;
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  OutputImageType * outputPtr = this->GetOutput();
+  if (!outputPtr)
+  {
+    return;
+  }
+
+  const OutputImageRegionType outputLargestPossibleRegion(m_OutputStartIndex, m_Size);
+  outputPtr->SetLargestPossibleRegion(outputLargestPossibleRegion);
+  outputPtr->SetSpacing(m_OutputSpacing);
+  outputPtr->SetOrigin(m_OutputOrigin);
+
+  typename OutputImageType::DirectionType direction;
+  direction.SetIdentity();
+  outputPtr->SetDirection(direction);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (!this->GetInput())
+  {
+    return;
+  }
+
+  auto * inputPtr = const_cast<InputImageType *>(this->GetInput());
+
+  const OutputImageType *       outputPtr = this->GetOutput();
+  const OutputImageRegionType & outputRegion = outputPtr->GetRequestedRegion();
+  if (!m_Interpolator || outputRegion.GetNumberOfPixels() == 0)
+  {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+    return;
+  }
+
+  // Polar bounding box of the requested output region, whose direction is identity.
+  typename PolarToCartesianTransformType::InputPointType polarMinimum;
+  typename PolarToCartesianTransformType::InputPointType polarMaximum;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const ScalarType first = m_OutputOrigin[d] + static_cast<ScalarType>(outputRegion.GetIndex(d)) * m_OutputSpacing[d];
+    const ScalarType last =
+      m_OutputOrigin[d] + static_cast<ScalarType>(outputRegion.GetUpperIndex()[d]) * m_OutputSpacing[d];
+    polarMinimum[d] = std::min(first, last);
+    polarMaximum[d] = std::max(first, last);
+  }
+  if (m_LogPolar)
+  {
+    polarMinimum[1] = std::exp(polarMinimum[1]);
+    polarMaximum[1] = std::exp(polarMaximum[1]);
+  }
+
+  typename PolarToCartesianTransformType::OutputPointType center;
+  center.CastFrom(m_Center);
+  const auto transform = PolarToCartesianTransformType::New();
+  transform->SetCenter(center);
+  transform->SetAngleOffset(m_AngleOffset);
+  transform->SetConstArcIncr(m_ConstArcIncr);
+
+  typename PolarToCartesianTransformType::OutputPointType cartesianMinimum;
+  typename PolarToCartesianTransformType::OutputPointType cartesianMaximum;
+  transform->ComputeOutputBoundingBox(polarMinimum, polarMaximum, cartesianMinimum, cartesianMaximum);
+
+  PointType minimum;
+  PointType maximum;
+  minimum.CastFrom(cartesianMinimum);
+  maximum.CastFrom(cartesianMaximum);
+
+  const auto           radius = m_Interpolator->GetRadius();
+  InputImageRegionType inputRegion;
+  if (!PolarImageFilterHelpers::ComputeInputRegion<ScalarType>(inputPtr, minimum, maximum, radius, inputRegion))
+  {
+    // No output pixel maps into the input. The interpolator never samples this single pixel.
+    typename InputImageRegionType::SizeType size;
+    size.Fill(1);
+    inputRegion = InputImageRegionType(inputPtr->GetLargestPossibleRegion().GetIndex(), size);
+  }
+  inputPtr->SetRequestedRegion(inputRegion);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::BeforeThreadedGenerateData()
+{
+  if (!m_Interpolator)
+  {
+    itkExceptionMacro(<< "Interpolator not set");
+  }
+  m_Interpolator->SetInputImage(this->GetInput());
+
+  const OutputImageRegionType & region = this->GetOutput()->GetLargestPossibleRegion();
+  const SizeValueType           numberOfAngles = region.GetSize(0);
+  const SizeValueType           numberOfRadii = region.GetSize(1);
+
+  m_AngleTable.resize(numberOfAngles);
+  m_CosTable.resize(numberOfAngles);
+  m_SinTable.resize(numberOfAngles);
+  for (SizeValueType i = 0; i < numberOfAngles; ++i)
+  {
+    const auto index = static_cast<ScalarType>(region.GetIndex(0) + static_cast<IndexValueType>(i));
+    m_AngleTable[i] = m_OutputOrigin[0] + index * m_OutputSpacing[0];
+    if (!m_ConstArcIncr && m_AngleEvaluation != AngleEvaluationEnum::Incremental)
+    {
+      const ScalarType alpha = m_AngleTable[i] + m_AngleOffset;
+      m_CosTable[i] = std::cos(alpha);
+      m_SinTable[i] = std::sin(alpha);
+    }
+  }
+  if (!m_ConstArcIncr && m_AngleEvaluation == AngleEvaluationEnum::Incremental && numberOfAngles > 0)
+  {
+    PolarTransformKernels::IncrementalSinCos<ScalarType>(m_AngleTable[0] + m_AngleOffset,
+                                                         m_OutputSpacing[0],
+                                                         0,
+                                                         numberOfAngles,
+                                                         m_CosTable.data(),
+                                                         m_SinTable.data());
+  }
+
+  m_RadiusTable.resize(numberOfRadii);
+  for (SizeValueType j = 0; j < numberOfRadii; ++j)
+  {
+    const auto index = static_cast<ScalarType>(region.GetIndex(1) + static_cast<IndexValueType>(j));
+    const ScalarType radiusCoordinate = m_OutputOrigin[1] + index * m_OutputSpacing[1];
+    m_RadiusTable[j] = m_LogPolar ? std::exp(radiusCoordinate) : radiusCoordinate;
+  }
+
+  m_InPlaneMap.clear();
+  if (m_UseInPlaneMap && ImageDimension > 2 && this->IsInPlaneSeparable())
+  {
+    this->BuildInPlaneMap();
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  if (outputRegionForThread.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+  if (!m_UseTiledTraversal)
+  {
+    this->GenerateDataForRegion(outputRegionForThread);
+    return;
+  }
+  for (const OutputImageRegionType & tile : this->ComputeTiles(outputRegionForThread))
+  {
+    this->GenerateDataForRegion(tile);
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::GenerateDataForRegion(
+  const OutputImageRegionType & outputRegion)
+{
+  if (!m_InPlaneMap.empty())
+  {
+    this->GenerateDataWithInPlaneMap(outputRegion);
+    return;
+  }
+
+  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType *      outputPtr = this->GetOutput();
+
+  const IndexType & largestIndex = outputPtr->GetLargestPossibleRegion().GetIndex();
+
+  // The continuous index of a cartesian point x in the input is M * (x - origin),
+  // with x = center + r * (cos, sin) in the first two dimensions.
+  const auto & matrix = inputPtr->GetPhysicalPointToIndexMatrix();
+  const auto & inputOrigin = inputPtr->GetOrigin();
+
+  ContinuousIndexType centerIndex;
+  ContinuousIndexType cosDirection;
+  ContinuousIndexType sinDirection;
+  for (unsigned int k = 0; k < ImageDimension; ++k)
+  {
+    centerIndex[k] = matrix[k][0] * (m_Center[0] - inputOrigin[0]) + matrix[k][1] * (m_Center[1] - inputOrigin[1]);
+    cosDirection[k] = matrix[k][0];
+    sinDirection[k] = matrix[k][1];
+  }
+
+  // r*cos and r*sin of the current scanline.
+  const SizeValueType     lineLength = outputRegion.GetSize(0);
+  std::vector<ScalarType> lineCos(lineLength);
+  std::vector<ScalarType> lineSin(lineLength);
+
+  ImageScanlineIterator<OutputImageType> outIt(outputPtr, outputRegion);
+
+  PolarTransformTally tally;
+
+  while (!outIt.IsAtEnd())
+  {
+    const IndexType lineIndex = outIt.GetIndex();
+    auto            start = PolarTransformTally::Now();
+
+    // Contribution of the radius and the pass-through dimensions, constant along the line.
+    const ScalarType    radius = m_RadiusTable[lineIndex[1] - largestIndex[1]];
+    ContinuousIndexType lineBase = centerIndex;
+    for (unsigned int d = 2; d < ImageDimension; ++d)
+    {
+      const ScalarType coordinate =
+        m_OutputOrigin[d] + static_cast<ScalarType>(lineIndex[d]) * m_OutputSpacing[d] - inputOrigin[d];
+      for (unsigned int k = 0; k < ImageDimension; ++k)
+      {
+        lineBase[k] += matrix[k][d] * coordinate;
+      }
+    }
+
+    this->ComputeLineCartesianOffsets(
+      radius, static_cast<SizeValueType>(lineIndex[0] - largestIndex[0]), lineCos, lineSin);
+    tally.AddTransformTime(start);
+    tally.CountDegenerateCenter(radius == 0.0 ? lineLength : 0);
+
+    for (SizeValueType i = 0; !outIt.IsAtEndOfLine(); ++i)
+    {
+      ContinuousIndexType inputIndex;
+      for (unsigned int k = 0; k < ImageDimension; ++k)
+      {
+        inputIndex[k] = lineBase[k] + lineCos[i] * cosDirection[k] + lineSin[i] * sinDirection[k];
+      }
+
+      const bool inside = m_Interpolator->IsInsideBuffer(inputIndex);
+      tally.CountSample(inside);
+      if (inside)
+      {
+        outIt.Set(PolarImageFilterHelpers::CastPixelWithClamping<PixelType>(
+          m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+      }
+      else
+      {
+        outIt.Set(m_DefaultPixelValue);
+      }
+
+      ++outIt;
+    }
+    tally.AddInterpolationTime(start);
+    outIt.NextLine();
+  }
+
+  m_EvaluationCounters.Add(tally);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+auto
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::ComputeTiles(
+  const OutputImageRegionType & outputRegion) const -> std::vector<OutputImageRegionType>
+{
+  const InputImageType * inputPtr = this->GetInput();
+  const IndexType &      largestIndex = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+
+  // Physical side of a tile. A square of this side rotated by any angle has a bounding box of at most twice its
+  // area, which holds TileCacheSize bytes of input.
+  const auto &        inputSpacing = inputPtr->GetSpacing();
+  const SizeValueType pixelBytes =
+    inputPtr->GetNumberOfComponentsPerPixel() * sizeof(typename InputImageType::InternalPixelType);
+  const ScalarType tileExtent = std::min(inputSpacing[0], inputSpacing[1]) *
+                                std::sqrt(0.5 * static_cast<ScalarType>(m_TileCacheSize) / pixelBytes);
+
+  const IndexValueType firstColumn = outputRegion.GetIndex(0);
+  const IndexValueType lastColumn = outputRegion.GetUpperIndex()[0];
+  const IndexValueType lastRow = outputRegion.GetUpperIndex()[1];
+  const ScalarType     columnSpacing = std::abs(m_OutputSpacing[0]);
+
+  std::vector<OutputImageRegionType> tiles;
+  for (IndexValueType row = outputRegion.GetIndex(1); row <= lastRow;)
+  {
+    // A band of rows whose radii differ by at most the tile side.
+    const ScalarType bandRadius = m_RadiusTable[row - largestIndex[1]];
+    ScalarType       maximumRadius = std::abs(bandRadius);
+    IndexValueType   bandEnd = row;
+    while (bandEnd < lastRow && std::abs(m_RadiusTable[bandEnd + 1 - largestIndex[1]] - bandRadius) <= tileExtent)
+    {
+      ++bandEnd;
+      maximumRadius = std::max(maximumRadius, std::abs(m_RadiusTable[bandEnd - largestIndex[1]]));
+    }
+
+    // Runs of columns whose arc at the outer radius of the band is at most the tile side.
+    const ScalarType columnArc = m_ConstArcIncr ? columnSpacing : maximumRadius * columnSpacing;
+    SizeValueType    tileColumns = outputRegion.GetSize(0);
+    if (columnArc * static_cast<ScalarType>(tileColumns) > tileExtent)
+    {
+      tileColumns = std::max(SizeValueType{ 1 }, static_cast<SizeValueType>(tileExtent / columnArc));
+    }
+
+    for (IndexValueType column = firstColumn; column <= lastColumn; column += static_cast<IndexValueType>(tileColumns))
+    {
+      OutputImageRegionType tile = outputRegion;
+      tile.SetIndex(0, column);
+      tile.SetSize(0, std::min(tileColumns, static_cast<SizeValueType>(lastColumn - column + 1)));
+      tile.SetIndex(1, row);
+      tile.SetSize(1, static_cast<SizeValueType>(bandEnd - row + 1));
+      tiles.push_back(tile);
+    }
+    row = bandEnd + 1;
+  }
+  return tiles;
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::AfterThreadedGenerateData()
+{
+  m_Interpolator->SetInputImage(nullptr);
+  std::vector<ScalarType>().swap(m_InPlaneMap);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::ComputeLineCartesianOffsets(
+  const ScalarType          radius,
+  const SizeValueType       firstColumn,
+  std::vector<ScalarType> & lineCos,
+  std::vector<ScalarType> & lineSin) const
+{
+  const auto lineLength = static_cast<SizeValueType>(lineCos.size());
+
+  if (!m_ConstArcIncr)
+  {
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      lineCos[i] = radius * m_CosTable[firstColumn + i];
+      lineSin[i] = radius * m_SinTable[firstColumn + i];
+    }
+  }
+  else if (m_AngleEvaluation == AngleEvaluationEnum::Approximate)
+  {
+    PolarTransformKernels::Parameters<ScalarType> kernelParameters;
+    kernelParameters.AngleOffset = m_AngleOffset;
+    kernelParameters.ConstArcIncr = true;
+    std::copy_n(m_AngleTable.begin() + firstColumn, lineLength, lineCos.begin());
+    std::fill(lineSin.begin(), lineSin.end(), radius);
+    PolarTransformKernels::PolarToCartesian(
+      lineCos.data(), lineSin.data(), lineCos.data(), lineSin.data(), lineLength, kernelParameters);
+  }
+  else if (m_AngleEvaluation == AngleEvaluationEnum::Incremental)
+  {
+    // alpha = arc/r + AngleOffset advances by OutputSpacing/r per column, seeded relative to the largest region
+    PolarTransformKernels::IncrementalSinCos<ScalarType>(m_AngleTable[0] / radius + m_AngleOffset,
+                                                         m_OutputSpacing[0] / radius,
+                                                         firstColumn,
+                                                         lineLength,
+                                                         lineCos.data(),
+                                                         lineSin.data());
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      lineCos[i] *= radius;
+      lineSin[i] *= radius;
+    }
+  }
+  else
+  {
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      const ScalarType alpha = m_AngleTable[firstColumn + i] / radius + m_AngleOffset; // alpha = arc/r
+      lineCos[i] = radius * std::cos(alpha);
+      lineSin[i] = radius * std::sin(alpha);
+    }
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+bool
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::IsInPlaneSeparable() const
+{
+  const auto & matrix = this->GetInput()->GetPhysicalPointToIndexMatrix();
+  for (unsigned int k = 0; k < ImageDimension; ++k)
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if ((k < 2) != (d < 2) && matrix[k][d] != 0.0)
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::BuildInPlaneMap()
+{
+  const InputImageType * inputPtr = this->GetInput();
+
+  m_InPlaneMapRegion = this->GetOutput()->GetRequestedRegion();
+  const SizeValueType lineLength = m_InPlaneMapRegion.GetSize(0);
+  const SizeValueType numberOfLines = m_InPlaneMapRegion.GetSize(1);
+  m_InPlaneMap.resize(2 * lineLength * numberOfLines);
+
+  const IndexType & largestIndex = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+  const auto        firstColumn = static_cast<SizeValueType>(m_InPlaneMapRegion.GetIndex(0) - largestIndex[0]);
+
+  // Same arithmetic as DynamicThreadedGenerateData(), where the pass-through terms vanish in the first two
+  // dimensions. The other dimensions are set to the start of the buffer, so that the buffer test only checks the
+  // plane.
+  const auto & matrix = inputPtr->GetPhysicalPointToIndexMatrix();
+  const auto & inputOrigin = inputPtr->GetOrigin();
+  const auto & bufferStart = inputPtr->GetBufferedRegion().GetIndex();
+
+  ContinuousIndexType centerIndex;
+  for (unsigned int k = 0; k < ImageDimension; ++k)
+  {
+    centerIndex[k] = static_cast<ScalarType>(bufferStart[k]);
+  }
+  for (unsigned int k = 0; k < 2; ++k)
+  {
+    centerIndex[k] = matrix[k][0] * (m_Center[0] - inputOrigin[0]) + matrix[k][1] * (m_Center[1] - inputOrigin[1]);
+  }
+
+  ImageRegion<1> lines;
+  lines.SetSize(0, numberOfLines);
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<1>(
+    lines,
+    [&](const ImageRegion<1> & linesForThread) {
+      std::vector<ScalarType> lineCos(lineLength);
+      std::vector<ScalarType> lineSin(lineLength);
+
+      PolarTransformTally tally;
+      auto                start = PolarTransformTally::Now();
+
+      for (IndexValueType line = linesForThread.GetIndex(0); line <= linesForThread.GetUpperIndex()[0]; ++line)
+      {
+        const ScalarType radius = m_RadiusTable[m_InPlaneMapRegion.GetIndex(1) + line - largestIndex[1]];
+        this->ComputeLineCartesianOffsets(radius, firstColumn, lineCos, lineSin);
+
+        ScalarType * mapLine = m_InPlaneMap.data() + 2 * lineLength * static_cast<SizeValueType>(line);
+        for (SizeValueType i = 0; i < lineLength; ++i)
+        {
+          ContinuousIndexType inputIndex = centerIndex;
+          for (unsigned int k = 0; k < 2; ++k)
+          {
+            inputIndex[k] = centerIndex[k] + lineCos[i] * matrix[k][0] + lineSin[i] * matrix[k][1];
+          }
+
+          const bool inside = m_Interpolator->IsInsideBuffer(inputIndex);
+          mapLine[2 * i] = inside ? inputIndex[0] : std::numeric_limits<ScalarType>::quiet_NaN();
+          mapLine[2 * i + 1] = inputIndex[1];
+        }
+      }
+
+      tally.AddTransformTime(start);
+      m_EvaluationCounters.Add(tally);
+    },
+    nullptr);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+CartesianToPolarImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::GenerateDataWithInPlaneMap(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType *      outputPtr = this->GetOutput();
+
+  const auto &        matrix = inputPtr->GetPhysicalPointToIndexMatrix();
+  const auto &        inputOrigin = inputPtr->GetOrigin();
+  const auto &        bufferStart = inputPtr->GetBufferedRegion().GetIndex();
+  const IndexType &   mapStart = m_InPlaneMapRegion.GetIndex();
+  const SizeValueType mapLineLength = m_InPlaneMapRegion.GetSize(0);
+  const IndexType &   largestIndex = outputPtr->GetLargestPossibleRegion().GetIndex();
+
+  ImageScanlineIterator<OutputImageType> outIt(outputPtr, outputRegionForThread);
+
+  PolarTransformTally tally;
+
+  while (!outIt.IsAtEnd())
+  {
+    const IndexType lineIndex = outIt.GetIndex();
+    auto            start = PolarTransformTally::Now();
+    if (m_RadiusTable[lineIndex[1] - largestIndex[1]] == 0.0)
+    {
+      tally.CountDegenerateCenter(outputRegionForThread.GetSize(0));
+    }
+
+    // Input index of the slice in the other dimensions. The first two are set to the start of the buffer, so that
+    // the buffer test only checks the slice.
+    ContinuousIndexType inputIndex;
+    for (unsigned int k = 0; k < ImageDimension; ++k)
+    {
+      inputIndex[k] = k < 2 ? static_cast<ScalarType>(bufferStart[k]) : 0.0;
+    }
+    for (unsigned int d = 2; d < ImageDimension; ++d)
+    {
+      const ScalarType coordinate =
+        m_OutputOrigin[d] + static_cast<ScalarType>(lineIndex[d]) * m_OutputSpacing[d] - inputOrigin[d];
+      for (unsigned int k = 2; k < ImageDimension; ++k)
+      {
+        inputIndex[k] += matrix[k][d] * coordinate;
+      }
+    }
+    const bool sliceInside = m_Interpolator->IsInsideBuffer(inputIndex);
+
+    const ScalarType * mapPixel =
+      m_InPlaneMap.data() +
+      2 * (static_cast<SizeValueType>(lineIndex[1] - mapStart[1]) * mapLineLength +
+           static_cast<SizeValueType>(lineIndex[0] - mapStart[0]));
+    for (; !outIt.IsAtEndOfLine(); ++outIt, mapPixel += 2)
+    {
+      const bool inside = sliceInside && !std::isnan(mapPixel[0]);
+      tally.CountSample(inside);
+      if (inside)
+      {
+        inputIndex[0] = mapPixel[0];
+        inputIndex[1] = mapPixel[1];
+        outIt.Set(PolarImageFilterHelpers::CastPixelWithClamping<PixelType>(
+          m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+      }
+      else
+      {
+        outIt.Set(m_DefaultPixelValue);
+      }
+    }
+    tally.AddInterpolationTime(start);
+    outIt.NextLine();
+  }
+
+  m_EvaluationCounters.Add(tally);
+}
+
+} // namespace itk
+
+#endif
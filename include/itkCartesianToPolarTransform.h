@@ -22,24 +22,43 @@
 #include "itkTransform.h"
 #include "itkMacro.h"
 #include "itkMatrix.h"
+#include "itkPolarTransformKernels.h"
+#include "itkPolarTransformEnums.h"
+#include "itkPolarTransformInstrumentation.h"
+#include "itkPolarMappingFunctors.h"
 
 namespace itk
 {
 
+template <typename TParametersValueType, unsigned int NDimensions>
+class PolarToCartesianTransform;
+
 /** \class CartesianToPolarTransform
  *
  * \brief Polar transformation of a vector space (e.g. space coordinates).
  *
  * Transforms first two coordinates form cartesian coordinates  to polar
  * coordinates <alpha,radius>. Other dimensions are left unchanges. In fact
- * this is generalized cylindric transform:
+ * this is generalized cylindric transform, with x_0 and x_1 relative to the
+ * Center and \f$ \alpha_0 \f$ the AngleOffset:
  * \f[          r = \sqrt{ x_0^2 + x_1^2 } \f]
- * \f[          \alpha = \left\{ \begin{array}{ll}
+ * \f[          \theta = \left\{ \begin{array}{ll}
  * arccos( \frac{x_0}{r} ) & \mbox{$x_1 >= 0$} \\
  * \mbox{2 \pi} - arccos( \frac{x_0}{r} ) & \mbox{$x_1 < 0$}
  * \end{array}\right. \f]
+ * \f[          \alpha = ( \theta - \alpha_0 ) \bmod 2 \pi \f]
  * \f[          x_n = x_n, \mbox{n >= 2} \f]
  *
+ * With ConstArcIncr the first output is the arc \f$ r \alpha \f$. The
+ * angle \f$ \alpha \f$ is in [0,2*pi), so the transform inverts a
+ * PolarToCartesianTransform with the same Center and AngleOffset.
+ *
+ * \par
+ * Release 1.2 and earlier added the AngleOffset before the reflection, i.e.
+ * \f$ \alpha = \theta + \alpha_0 \f$ for \f$ x_1 >= 0 \f$ and
+ * \f$ \alpha = \theta - \alpha_0 \f$ for \f$ x_1 < 0 \f$, without
+ * wrapping. SetUseLegacyConvention() restores that mapping.
+ *
  *
  * \par
  * Center of the polar transform is can be specified with SetCenter().
@@ -81,6 +100,8 @@ public:
 
   /** Standard Jacobian container. */
   using JacobianType = typename Superclass::JacobianType;
+  using JacobianPositionType = typename Superclass::JacobianPositionType;
+  using InverseJacobianPositionType = typename Superclass::InverseJacobianPositionType;
 
   /** Standard parameters container. */
   using ParametersType = typename Superclass::ParametersType;
@@ -101,14 +122,44 @@ public:
   using InputPointType = Point<TParametersValueType, Self::SpaceDimension>;
   using OutputPointType = Point<TParametersValueType, Self::SpaceDimension>;
 
+  /** Inverse transform type alias. */
+  using InverseTransformType = PolarToCartesianTransform<TParametersValueType, NDimensions>;
+  using InverseTransformBasePointer = typename Superclass::InverseTransformBasePointer;
+
+  using AngleEvaluationEnum = PolarTransformEnums::AngleEvaluation;
+
   /** Method to transform a point.
    * This method transforms first two dimensions of a point from cartesian
-   * coordinates to polar coordinates <alpha,radius>.
+   * coordinates to polar coordinates <alpha,radius>. The angle is evaluated
+   * as selected by SetAngleEvaluation(); the center maps to alpha = 0.
    */
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
-  /**  Method to transform a vector - not applicable for this type of transform. */
+  /** Method to transform a batch of points stored contiguously (array of structures).
+   *
+   * Evaluates the angles as selected by SetAngleEvaluation(), with the vectorized
+   * PolarTransformKernels in Approximate mode and with libm per point otherwise,
+   * so the results agree with TransformPoint() up to vectorization. The output
+   * may be the same buffer as the input. Both batch overloads are virtual, so
+   * subclasses are batch-transformed correctly through a pointer to this class.
+   */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const;
+
+  /** Method to transform a batch of points stored as a structure of arrays.
+   *
+   * inputComponents[d][i] is coordinate d of point i. Each output component
+   * may be the same buffer as the corresponding input component.
+   */
+  virtual void
+  TransformPoints(const ScalarType * const * inputComponents,
+                  ScalarType * const *       outputComponents,
+                  SizeValueType              numberOfPoints) const;
+
+  /** Method to transform a vector - only the overloads at a point apply to this type of transform. */
   OutputVectorType
   TransformVector(const InputVectorType &) const override
   {
@@ -116,7 +167,7 @@ public:
     return OutputVectorType();
   }
 
-  /** Method to transform a vnl_vector - not applicable for this type of transform. */
+  /** Method to transform a vnl_vector - only the overloads at a point apply to this type of transform. */
   OutputVnlVectorType
   TransformVector(const InputVnlVectorType &) const override
   {
@@ -124,17 +175,9 @@ public:
     return OutputVnlVectorType();
   }
 
-  /** Method to transform a vector - not applicable for this type of transform. */
-  typename Superclass::OutputVectorPixelType
-  TransformVector(const typename Superclass::InputVectorPixelType &, const InputPointType &) const override
-  {
-    itkExceptionMacro(<< "Method not applicable for this type of transform.");
-    return typename Superclass::OutputVectorPixelType();
-  }
-
   using Superclass::TransformVector;
 
-  /** Method to transform a CovariantVector - not applicable for this type of transform. */
+  /** Method to transform a CovariantVector - only the overloads at a point apply to this type of transform. */
   OutputCovariantVectorType
   TransformCovariantVector(const InputCovariantVectorType &) const override
   {
@@ -144,12 +187,58 @@ public:
 
   using Superclass::TransformCovariantVector;
 
+  /** The transform has no parameters, so the Jacobian has no columns. */
   void
-  ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override
+  ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType & jacobian) const override
   {
-    itkExceptionMacro(<< "Method not implemented yet.");
+    jacobian.SetSize(SpaceDimension, 0);
   }
 
+  /** Compute the Jacobian of the transform with respect to the cartesian input point.
+   *
+   * With constant angular increment the in-plane block is
+   * \f[ \left( \begin{array}{cc} -\sin\theta / r & \cos\theta / r \\ \cos\theta & \sin\theta \end{array} \right) \f]
+   * where \f$ \theta \f$ is the angle of the point around the Center. With ConstArcIncr the first row becomes
+   * \f$ ( a \cos\theta - \sin\theta, a \sin\theta + \cos\theta ) \f$ with \f$ a = \alpha / r \f$ the
+   * output angle. The other dimensions are passed through. The Jacobian is not defined at the Center.
+   *
+   * TransformVector() and TransformCovariantVector() at a point use these Jacobians.
+   */
+  void
+  ComputeJacobianWithRespectToPosition(const InputPointType & point, JacobianPositionType & jacobian) const override;
+
+  /** Compute the inverse of the Jacobian with respect to the cartesian input point in closed form. */
+  void
+  ComputeInverseJacobianWithRespectToPosition(const InputPointType &        point,
+                                              InverseJacobianPositionType & jacobian) const override;
+
+  using Superclass::ComputeJacobianWithRespectToPosition;
+  using Superclass::ComputeInverseJacobianWithRespectToPosition;
+
+  /** Fill a PolarToCartesianTransform with the Center, AngleOffset, ConstArcIncr and AngleEvaluation of this
+   * transform. */
+  bool
+  GetInverse(InverseTransformType * inverse) const;
+
+  /** Return a PolarToCartesianTransform inverting this transform. */
+  InverseTransformBasePointer
+  GetInverseTransform() const override;
+
+  /** Compute the bounding box of the polar points <alpha,radius> that the cartesian box
+   * [inputMinimum,inputMaximum] maps to.
+   *
+   * The radius range is given by the nearest and the farthest point of the box. The angle range is that of
+   * the corners of the box, or [0,2*pi] when the box contains the center or crosses the angle at which alpha
+   * wraps around. With UseLegacyConvention the angle range is widened by the AngleOffset on both sides instead.
+   * With ConstArcIncr the bounds of the arc are the products of those of alpha and radius. Dimensions other than
+   * the first two are passed through.
+   */
+  void
+  ComputeOutputBoundingBox(const InputPointType & inputMinimum,
+                           const InputPointType & inputMaximum,
+                           OutputPointType &      outputMinimum,
+                           OutputPointType &      outputMaximum) const;
+
   void
   SetParameters(const ParametersType &) override
   {}
@@ -163,20 +252,64 @@ public:
   itkGetConstReferenceMacro(Center, InputPointType);
 
   /** Set an angular offset for the polar coordinate transform.
+   *
+   * The offset is subtracted from the computed angle, which is then wrapped
+   * into [0,2*pi), so that the transform inverts a PolarToCartesianTransform
+   * with the same offset. See SetUseLegacyConvention() for the convention of
+   * release 1.2 and earlier.
    *
    * Defaults to 0.0
    */
   itkSetMacro(AngleOffset, typename OutputPointType::ValueType);
   itkGetConstReferenceMacro(AngleOffset, typename OutputPointType::ValueType);
 
+  /** Enable/Disable the AngleOffset convention of release 1.2 and earlier.
+   *
+   * When On, the offset is added to the angle of points with x_1 >= 0 and
+   * subtracted from the others, without wrapping, as documented above. The
+   * transform then no longer inverts a PolarToCartesianTransform with a
+   * non-zero offset. This is meant for the migration of existing code only:
+   * enabling it issues a deprecation warning, and it will be removed in a
+   * future release. GetInverse() copies the setting.
+   *
+   * Defaults to Off
+   */
+  virtual void
+  SetUseLegacyConvention(bool useLegacyConvention);
+  itkGetConstMacro(UseLegacyConvention, bool);
+  itkBooleanMacro(UseLegacyConvention);
+
   /** Enable/Disable to use constant arc increment instead of constant angular increment.
    *
    * Defaults to Off
    */
   itkSetMacro(ConstArcIncr, bool);
-  itkGetMacro(ConstArcIncr, bool);
+  itkGetConstMacro(ConstArcIncr, bool);
   itkBooleanMacro(ConstArcIncr);
 
+  /** Select std::atan2() (Exact) or the polynomial approximation of PolarTransformKernels (Approximate) for the
+   * angle in TransformPoint() and TransformPoints(). See PolarTransformEnums::AngleEvaluation for the error bounds.
+   *
+   * Defaults to Exact
+   */
+  itkSetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+  itkGetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+
+  /** Counts and times of the batch TransformPoints() since construction or the last ResetEvaluationStatistics().
+   * They are only collected when the module is configured with PolarTransform_USE_INSTRUMENTATION, see
+   * PolarTransformStatistics. */
+  PolarTransformStatistics
+  GetEvaluationStatistics() const
+  {
+    return m_EvaluationCounters.GetStatistics();
+  }
+
+  void
+  ResetEvaluationStatistics()
+  {
+    m_EvaluationCounters.Reset();
+  }
+
 protected:
   CartesianToPolarTransform();
   ~CartesianToPolarTransform() override;
@@ -185,10 +318,24 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Settings of the batch kernels. */
+  PolarTransformKernels::Parameters<ScalarType>
+  GetKernelParameters() const;
+
+  /** Add the counts and times of a batch to the evaluation statistics. */
+  void
+  AddEvaluationTally(const PolarTransformTally & tally) const
+  {
+    m_EvaluationCounters.Add(tally);
+  }
+
 private:
   InputPointType                      m_Center;
   typename OutputPointType::ValueType m_AngleOffset = 0;
   bool                                m_ConstArcIncr = false;
+  bool                                m_UseLegacyConvention = false;
+  AngleEvaluationEnum                 m_AngleEvaluation = AngleEvaluationEnum::Exact;
+  mutable PolarTransformCounters      m_EvaluationCounters;
 }; // class CartesianToPolarTransform
 
 } // namespace itk
@@ -19,6 +19,8 @@
 #define itkCartesianToPolarTransform_hxx
 
 #include "itkMath.h"
+#include "itkPolarToCartesianTransform.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -41,6 +43,14 @@ CartesianToPolarTransform<TParametersValueType, NDimensions>::PrintSelf(std::ost
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Center: " << m_Center << std::endl;
+  os << indent << "AngleOffset: " << m_AngleOffset << std::endl;
+  os << indent << "ConstArcIncr: " << (m_ConstArcIncr ? "On" : "Off") << std::endl;
+  os << indent << "UseLegacyConvention: " << (m_UseLegacyConvention ? "On" : "Off") << std::endl;
+  os << indent << "AngleEvaluation: " << m_AngleEvaluation << std::endl;
+  if (PolarTransformCounters::Enabled)
+  {
+    os << indent << "EvaluationStatistics: " << m_EvaluationCounters.GetStatistics() << std::endl;
+  }
 }
 
 
@@ -48,24 +58,310 @@ template <typename TParametersValueType, unsigned int NDimensions>
 typename CartesianToPolarTransform<TParametersValueType, NDimensions>::OutputPointType
 CartesianToPolarTransform<TParametersValueType, NDimensions>::TransformPoint(const InputPointType & inputPoint) const
 {
-  OutputPointType outputPoint(inputPoint);
+  if (m_UseLegacyConvention)
+  {
+    // the mapping functors only implement the current convention, the kernels implement both
+    OutputPointType outputPoint(inputPoint);
+    PolarTransformKernels::CartesianToPolar(
+      &inputPoint[0], &inputPoint[1], &outputPoint[0], &outputPoint[1], 1, this->GetKernelParameters());
+    return outputPoint;
+  }
+
+  // select the mapping specialized for the current options
+  return Functor::DispatchPolarMappingFlags(
+    [&](auto constArcIncr, auto angleOffset, auto approximate) {
+      using MappingType = Functor::CartesianToPolarMapping<ScalarType,
+                                                           decltype(constArcIncr)::value,
+                                                           decltype(angleOffset)::value,
+                                                           decltype(approximate)::value
+                                                             ? AngleEvaluationEnum::Approximate
+                                                             : AngleEvaluationEnum::Exact>;
+      return MappingType(m_Center[0], m_Center[1], m_AngleOffset)(inputPoint);
+    },
+    m_ConstArcIncr,
+    m_AngleOffset != 0.0,
+    m_AngleEvaluation == AngleEvaluationEnum::Approximate);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToPolarTransform<TParametersValueType, NDimensions>::ComputeJacobianWithRespectToPosition(
+  const InputPointType & point,
+  JacobianPositionType & jacobian) const
+{
+  jacobian.set_identity();
 
-  const InputPointType vector = inputPoint - this->m_Center;
+  const ScalarType dx = point[0] - m_Center[0];
+  const ScalarType dy = point[1] - m_Center[1];
+  const ScalarType radius = std::sqrt(dx * dx + dy * dy);
+  const ScalarType cosTheta = dx / radius;
+  const ScalarType sinTheta = dy / radius;
 
-  outputPoint[1] = std::sqrt(vector[0] * vector[0] + vector[1] * vector[1]); // r= sqrt(x^2 + y^2)
-  outputPoint[0] = std::acos(vector[0] / outputPoint[1]);                    // alpha = acos(x/r)
-  outputPoint[0] += m_AngleOffset; // add offset before 2*pi adjustment to keep values within [-pi,pi]
-  if (vector[1] < 0.0)
+  if (m_ConstArcIncr)
   {
-    outputPoint[0] = Math::twopi - outputPoint[0];
+    // arc = r*alpha, with alpha the wrapped output angle
+    const ScalarType alpha = Self::TransformPoint(point)[0] / radius;
+    jacobian(0, 0) = alpha * cosTheta - sinTheta;
+    jacobian(0, 1) = alpha * sinTheta + cosTheta;
   }
+  else
+  {
+    jacobian(0, 0) = -sinTheta / radius;
+    jacobian(0, 1) = cosTheta / radius;
+  }
+  jacobian(1, 0) = cosTheta;
+  jacobian(1, 1) = sinTheta;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToPolarTransform<TParametersValueType, NDimensions>::ComputeInverseJacobianWithRespectToPosition(
+  const InputPointType &        point,
+  InverseJacobianPositionType & jacobian) const
+{
+  jacobian.set_identity();
+
+  const ScalarType dx = point[0] - m_Center[0];
+  const ScalarType dy = point[1] - m_Center[1];
+  const ScalarType radius = std::sqrt(dx * dx + dy * dy);
+  const ScalarType cosTheta = dx / radius;
+  const ScalarType sinTheta = dy / radius;
 
   if (m_ConstArcIncr)
   {
-    outputPoint[0] *= outputPoint[1]; // arc= r*alpha
+    const ScalarType alpha = Self::TransformPoint(point)[0] / radius;
+    jacobian(0, 0) = -sinTheta;
+    jacobian(0, 1) = cosTheta + alpha * sinTheta;
+    jacobian(1, 0) = cosTheta;
+    jacobian(1, 1) = sinTheta - alpha * cosTheta;
+  }
+  else
+  {
+    jacobian(0, 0) = -radius * sinTheta;
+    jacobian(0, 1) = cosTheta;
+    jacobian(1, 0) = radius * cosTheta;
+    jacobian(1, 1) = sinTheta;
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+CartesianToPolarTransform<TParametersValueType, NDimensions>::GetInverse(InverseTransformType * inverse) const
+{
+  if (!inverse)
+  {
+    return false;
+  }
+
+  inverse->SetCenter(m_Center);
+  inverse->SetAngleOffset(m_AngleOffset);
+  inverse->SetConstArcIncr(m_ConstArcIncr);
+  inverse->SetAngleEvaluation(m_AngleEvaluation);
+  inverse->SetUseLegacyConvention(m_UseLegacyConvention);
+  return true;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+CartesianToPolarTransform<TParametersValueType, NDimensions>::GetInverseTransform() const -> InverseTransformBasePointer
+{
+  const auto inverse = InverseTransformType::New();
+  return this->GetInverse(inverse) ? inverse.GetPointer() : nullptr;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToPolarTransform<TParametersValueType, NDimensions>::SetUseLegacyConvention(const bool useLegacyConvention)
+{
+  if (m_UseLegacyConvention == useLegacyConvention)
+  {
+    return;
+  }
+  if (useLegacyConvention)
+  {
+    itkWarningMacro(<< "UseLegacyConvention is deprecated and will be removed in a future release. Subtract "
+                       "AngleOffset as documented in CartesianToPolarTransform instead.");
   }
+  m_UseLegacyConvention = useLegacyConvention;
+  this->Modified();
+}
+
 
-  return outputPoint;
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToPolarTransform<TParametersValueType, NDimensions>::ComputeOutputBoundingBox(
+  const InputPointType & inputMinimum,
+  const InputPointType & inputMaximum,
+  OutputPointType &      outputMinimum,
+  OutputPointType &      outputMaximum) const
+{
+  using C = PolarTransformKernels::Constants<ScalarType>;
+
+  outputMinimum = inputMinimum;
+  outputMaximum = inputMaximum;
+
+  const ScalarType dx0 = inputMinimum[0] - m_Center[0];
+  const ScalarType dx1 = inputMaximum[0] - m_Center[0];
+  const ScalarType dy0 = inputMinimum[1] - m_Center[1];
+  const ScalarType dy1 = inputMaximum[1] - m_Center[1];
+
+  // nearest and farthest point of the box
+  const ScalarType nearX = (dx0 <= 0.0 && dx1 >= 0.0) ? 0.0 : std::min(std::abs(dx0), std::abs(dx1));
+  const ScalarType nearY = (dy0 <= 0.0 && dy1 >= 0.0) ? 0.0 : std::min(std::abs(dy0), std::abs(dy1));
+  const ScalarType farX = std::max(std::abs(dx0), std::abs(dx1));
+  const ScalarType farY = std::max(std::abs(dy0), std::abs(dy1));
+  const ScalarType radius0 = std::sqrt(nearX * nearX + nearY * nearY);
+  const ScalarType radius1 = std::sqrt(farX * farX + farY * farY);
+
+  ScalarType alpha0 = 0.0;
+  ScalarType alpha1 = C::TwoPi;
+  if (m_UseLegacyConvention)
+  {
+    // the offset is added or subtracted depending on the side of the center, without wrapping
+    alpha0 -= std::abs(m_AngleOffset);
+    alpha1 += std::abs(m_AngleOffset);
+  }
+  else if (nearX > 0.0 || nearY > 0.0)
+  {
+    // The box does not contain the center, so it spans less than pi around the direction of its middle.
+    const ScalarType middle = std::atan2((dy0 + dy1) / 2.0, (dx0 + dx1) / 2.0);
+    ScalarType       lower = 0.0;
+    ScalarType       upper = 0.0;
+    for (const ScalarType dx : { dx0, dx1 })
+    {
+      for (const ScalarType dy : { dy0, dy1 })
+      {
+        ScalarType difference = std::atan2(dy, dx) - middle;
+        difference -= C::TwoPi * std::round(difference / C::TwoPi);
+        lower = std::min(lower, difference);
+        upper = std::max(upper, difference);
+      }
+    }
+
+    // Subtract the offset and wrap into [0,2*pi) as TransformPoint() does. The margin covers the rounding
+    // errors of both computations, and of the Approximate mode, at the angle where alpha wraps around.
+    const ScalarType margin = 16 * NumericTraits<ScalarType>::epsilon() * C::TwoPi;
+    ScalarType       start = middle + lower - m_AngleOffset - margin;
+    ScalarType       end = middle + upper - m_AngleOffset + margin;
+    const ScalarType turns = std::floor(start / C::TwoPi);
+    start -= C::TwoPi * turns;
+    end -= C::TwoPi * turns;
+    if (end < C::TwoPi)
+    {
+      alpha0 = start;
+      alpha1 = end;
+    }
+  }
+  if (m_ConstArcIncr)
+  {
+    // arc= r*alpha with r >= 0, and alpha >= 0 unless UseLegacyConvention is On
+    alpha0 *= alpha0 < 0.0 ? radius1 : radius0;
+    alpha1 *= radius1;
+  }
+
+  outputMinimum[0] = alpha0;
+  outputMaximum[0] = alpha1;
+  outputMinimum[1] = radius0;
+  outputMaximum[1] = radius1;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToPolarTransform<TParametersValueType, NDimensions>::TransformPoints(const InputPointType * inputPoints,
+                                                                              OutputPointType *      outputPoints,
+                                                                              SizeValueType numberOfPoints) const
+{
+  constexpr SizeValueType BlockSize = 256;
+
+  ScalarType x[BlockSize];
+  ScalarType y[BlockSize];
+  ScalarType alpha[BlockSize];
+  ScalarType radius[BlockSize];
+
+  const PolarTransformKernels::Parameters<ScalarType> parameters = this->GetKernelParameters();
+
+  PolarTransformTally tally;
+  auto                start = PolarTransformTally::Now();
+
+  for (SizeValueType begin = 0; begin < numberOfPoints; begin += BlockSize)
+  {
+    const SizeValueType count = std::min(BlockSize, numberOfPoints - begin);
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      x[i] = inputPoints[begin + i][0];
+      y[i] = inputPoints[begin + i][1];
+    }
+
+    PolarTransformKernels::CartesianToPolar(x, y, alpha, radius, count, parameters);
+    tally.CountPolarOutputs(alpha, radius, count);
+
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      OutputPointType & outputPoint = outputPoints[begin + i];
+      if (&outputPoint != &inputPoints[begin + i])
+      {
+        outputPoint = inputPoints[begin + i];
+      }
+      outputPoint[0] = alpha[i];
+      outputPoint[1] = radius[i];
+    }
+  }
+
+  tally.AddTransformTime(start);
+  m_EvaluationCounters.Add(tally);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToPolarTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const ScalarType * const * inputComponents,
+  ScalarType * const *       outputComponents,
+  SizeValueType              numberOfPoints) const
+{
+  PolarTransformTally tally;
+  auto                start = PolarTransformTally::Now();
+
+  PolarTransformKernels::CartesianToPolar(inputComponents[0],
+                                          inputComponents[1],
+                                          outputComponents[0],
+                                          outputComponents[1],
+                                          numberOfPoints,
+                                          this->GetKernelParameters());
+
+  for (unsigned int d = 2; d < SpaceDimension; ++d)
+  {
+    if (outputComponents[d] != inputComponents[d])
+    {
+      std::copy_n(inputComponents[d], numberOfPoints, outputComponents[d]);
+    }
+  }
+
+  tally.CountPolarOutputs(outputComponents[0], outputComponents[1], numberOfPoints);
+  tally.AddTransformTime(start);
+  m_EvaluationCounters.Add(tally);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+CartesianToPolarTransform<TParametersValueType, NDimensions>::GetKernelParameters() const
+  -> PolarTransformKernels::Parameters<ScalarType>
+{
+  PolarTransformKernels::Parameters<ScalarType> parameters;
+  parameters.CenterX = m_Center[0];
+  parameters.CenterY = m_Center[1];
+  parameters.AngleOffset = m_AngleOffset;
+  parameters.ExactAngles = m_AngleEvaluation != AngleEvaluationEnum::Approximate;
+  parameters.ConstArcIncr = m_ConstArcIncr;
+  parameters.LegacyAngleOffset = m_UseLegacyConvention;
+  return parameters;
 }
 
 } // namespace itk
@@ -0,0 +1,267 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCartesianToSphericalTransform_h
+#define itkCartesianToSphericalTransform_h
+
+#include "itkTransform.h"
+#include "itkMacro.h"
+#include "itkPolarTransformKernels.h"
+#include "itkPolarTransformEnums.h"
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+class SphericalToCartesianTransform;
+
+/** \class CartesianToSphericalTransform
+ *
+ * \brief Spherical transformation of a vector space (e.g. space coordinates).
+ *
+ * Transforms the first three coordinates from cartesian coordinates to
+ * spherical coordinates <azimuth,elevation,radius> around the Center:
+ * \f[          r = \sqrt{ x_0^2 + x_1^2 + x_2^2 } \f]
+ * \f[          \phi = \mbox{atan2}( x_1, x_0 ) - \mbox{AngleOffset} \f]
+ * \f[          \theta = \mbox{atan2}( x_2, \sqrt{ x_0^2 + x_1^2 } ) \f]
+ * \f[          x_n = x_n, \mbox{n >= 3} \f]
+ * The azimuth is wrapped into [0,2*pi) like the angle of
+ * CartesianToPolarTransform, the elevation above the plane of the first two
+ * axes is in [-pi/2,pi/2]. The Center maps to zero angles and radius.
+ *
+ * \par
+ * In Approximate mode the batch TransformPoints() use the vectorized
+ * spherical kernels of PolarTransformKernels. The transform inverts a
+ * SphericalToCartesianTransform with the same Center and AngleOffset.
+ *
+ * Dimension must be at least 3.
+ *
+ * \sa SphericalToCartesianTransform
+ * \sa CartesianToPolarTransform
+ *
+ * \ingroup Transforms
+ * \ingroup PolarTransform
+ */
+template <typename TParametersValueType = double, // Data type for scalars (float or double)
+          unsigned int NDimensions = 3>           // Number of dimensions
+class ITK_TEMPLATE_EXPORT CartesianToSphericalTransform
+  : public Transform<TParametersValueType, NDimensions, NDimensions>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CartesianToSphericalTransform);
+
+  /** Standard class type alias. */
+  using Self = CartesianToSphericalTransform;
+  using Superclass = Transform<TParametersValueType, NDimensions, NDimensions>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** New macro for creation of through the object factory.*/
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(CartesianToSphericalTransform);
+
+  /** Dimension of the domain space. */
+  static constexpr unsigned int SpaceDimension = NDimensions;
+  static constexpr unsigned int ParametersDimension = 0;
+  static_assert(NDimensions >= 3, "Dimension must be at least 3.");
+
+  /** Standard scalar type for this class. */
+  using ScalarType = typename Superclass::ScalarType;
+
+  /** Standard Jacobian container. */
+  using JacobianType = typename Superclass::JacobianType;
+  using JacobianPositionType = typename Superclass::JacobianPositionType;
+  using InverseJacobianPositionType = typename Superclass::InverseJacobianPositionType;
+
+  /** Standard parameters container. */
+  using ParametersType = typename Superclass::ParametersType;
+
+  /** Standard vector type for this class. */
+  using InputVectorType = Vector<TParametersValueType, Self::SpaceDimension>;
+  using OutputVectorType = Vector<TParametersValueType, Self::SpaceDimension>;
+
+  /** Standard covariant vector type for this class. */
+  using InputCovariantVectorType = CovariantVector<TParametersValueType, Self::SpaceDimension>;
+  using OutputCovariantVectorType = CovariantVector<TParametersValueType, Self::SpaceDimension>;
+
+  /** Standard vnl_vector type for this class. */
+  using InputVnlVectorType = vnl_vector_fixed<TParametersValueType, Self::SpaceDimension>;
+  using OutputVnlVectorType = vnl_vector_fixed<TParametersValueType, Self::SpaceDimension>;
+
+  /** Standard coordinate point type for this class. */
+  using InputPointType = Point<TParametersValueType, Self::SpaceDimension>;
+  using OutputPointType = Point<TParametersValueType, Self::SpaceDimension>;
+
+  /** Inverse transform type alias. */
+  using InverseTransformType = SphericalToCartesianTransform<TParametersValueType, NDimensions>;
+  using InverseTransformBasePointer = typename Superclass::InverseTransformBasePointer;
+
+  using AngleEvaluationEnum = PolarTransformEnums::AngleEvaluation;
+
+  /** Method to transform a point.
+   * This method transforms the first three dimensions of a point from
+   * cartesian coordinates to spherical coordinates <azimuth,elevation,radius>.
+   * The angles are evaluated as selected by SetAngleEvaluation().
+   */
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override;
+
+  /** Method to transform a batch of points stored contiguously (array of structures).
+   *
+   * Evaluates the angles as selected by SetAngleEvaluation(), with the vectorized
+   * PolarTransformKernels in Approximate mode and with libm per point otherwise,
+   * so the results agree with TransformPoint() up to vectorization. The output
+   * may be the same buffer as the input.
+   */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const;
+
+  /** Method to transform a batch of points stored as a structure of arrays.
+   *
+   * inputComponents[d][i] is coordinate d of point i. Each output component
+   * may be the same buffer as the corresponding input component.
+   */
+  void
+  TransformPoints(const ScalarType * const * inputComponents,
+                  ScalarType * const *       outputComponents,
+                  SizeValueType              numberOfPoints) const;
+
+  /** Method to transform a vector - only the overloads at a point apply to this type of transform. */
+  OutputVectorType
+  TransformVector(const InputVectorType &) const override
+  {
+    itkExceptionMacro(<< "Method not applicable for this type of transform.");
+    return OutputVectorType();
+  }
+
+  /** Method to transform a vnl_vector - only the overloads at a point apply to this type of transform. */
+  OutputVnlVectorType
+  TransformVector(const InputVnlVectorType &) const override
+  {
+    itkExceptionMacro(<< "Method not applicable for this type of transform.");
+    return OutputVnlVectorType();
+  }
+
+  using Superclass::TransformVector;
+
+  /** Method to transform a CovariantVector - only the overloads at a point apply to this type of transform. */
+  OutputCovariantVectorType
+  TransformCovariantVector(const InputCovariantVectorType &) const override
+  {
+    itkExceptionMacro(<< "Method not applicable for this type of transform.");
+    return OutputCovariantVectorType();
+  }
+
+  using Superclass::TransformCovariantVector;
+
+  /** The transform has no parameters, so the Jacobian has no columns. */
+  void
+  ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType & jacobian) const override
+  {
+    jacobian.SetSize(SpaceDimension, 0);
+  }
+
+  /** Compute the Jacobian of the transform with respect to the cartesian input point.
+   *
+   * With \f$ \rho = \sqrt{ x_0^2 + x_1^2 } \f$ relative to the Center, the block of the first three dimensions is
+   * \f[ \left( \begin{array}{ccc} -x_1 / \rho^2 & x_0 / \rho^2 & 0 \\
+   * -x_0 x_2 / (r^2 \rho) & -x_1 x_2 / (r^2 \rho) & \rho / r^2 \\
+   * x_0 / r & x_1 / r & x_2 / r \end{array} \right) \f]
+   * The other dimensions are passed through. The Jacobian is not defined on the axis through the Center.
+   *
+   * TransformVector() and TransformCovariantVector() at a point use these Jacobians.
+   */
+  void
+  ComputeJacobianWithRespectToPosition(const InputPointType & point, JacobianPositionType & jacobian) const override;
+
+  /** Compute the inverse of the Jacobian with respect to the cartesian input point in closed form. */
+  void
+  ComputeInverseJacobianWithRespectToPosition(const InputPointType &        point,
+                                              InverseJacobianPositionType & jacobian) const override;
+
+  using Superclass::ComputeJacobianWithRespectToPosition;
+  using Superclass::ComputeInverseJacobianWithRespectToPosition;
+
+  /** Fill a SphericalToCartesianTransform with the Center, AngleOffset and AngleEvaluation of this transform. */
+  bool
+  GetInverse(InverseTransformType * inverse) const;
+
+  /** Return a SphericalToCartesianTransform inverting this transform. */
+  InverseTransformBasePointer
+  GetInverseTransform() const override;
+
+  void
+  SetParameters(const ParametersType &) override
+  {}
+
+  void
+  SetFixedParameters(const ParametersType &) override
+  {}
+
+  /** Set the location of the center of the spherical coordinate system. */
+  itkSetMacro(Center, InputPointType);
+  itkGetConstReferenceMacro(Center, InputPointType);
+
+  /** Set an offset of the azimuth.
+   *
+   * The offset is subtracted from the computed azimuth, which is then wrapped
+   * into [0,2*pi), so that the transform inverts a
+   * SphericalToCartesianTransform with the same offset.
+   *
+   * Defaults to 0.0
+   */
+  itkSetMacro(AngleOffset, typename OutputPointType::ValueType);
+  itkGetConstReferenceMacro(AngleOffset, typename OutputPointType::ValueType);
+
+  /** Select std::atan2() (Exact) or the polynomial approximation of PolarTransformKernels (Approximate) for the
+   * angles in TransformPoint() and TransformPoints(). Incremental evaluates like Exact here.
+   *
+   * Defaults to Exact
+   */
+  itkSetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+  itkGetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+
+protected:
+  CartesianToSphericalTransform();
+  ~CartesianToSphericalTransform() override = default;
+
+  /** Print contents of a CartesianToSphericalTransform. */
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Settings of the batch kernels. */
+  PolarTransformKernels::Parameters<ScalarType>
+  GetKernelParameters() const;
+
+private:
+  InputPointType                      m_Center;
+  typename OutputPointType::ValueType m_AngleOffset = 0;
+  AngleEvaluationEnum                 m_AngleEvaluation = AngleEvaluationEnum::Exact;
+}; // class CartesianToSphericalTransform
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCartesianToSphericalTransform.hxx"
+#endif
+
+#endif
@@ -0,0 +1,253 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCartesianToSphericalTransform_hxx
+#define itkCartesianToSphericalTransform_hxx
+
+#include "itkMath.h"
+#include "itkSphericalToCartesianTransform.h"
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::CartesianToSphericalTransform()
+  : Superclass(ParametersDimension)
+{
+  this->m_Center.Fill(0.0);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Center: " << m_Center << std::endl;
+  os << indent << "AngleOffset: " << m_AngleOffset << std::endl;
+  os << indent << "AngleEvaluation: " << m_AngleEvaluation << std::endl;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+typename CartesianToSphericalTransform<TParametersValueType, NDimensions>::OutputPointType
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::TransformPoint(
+  const InputPointType & inputPoint) const
+{
+  OutputPointType result = inputPoint;
+
+  if (m_AngleEvaluation == AngleEvaluationEnum::Approximate)
+  {
+    // the scalar pack of the batch kernel
+    using ScalarPackType = PolarTransformKernels::ScalarPack<ScalarType>;
+    const auto parameters = this->GetKernelParameters();
+    PolarTransformKernels::CartesianToSphericalBlock<ScalarPackType>(
+      &inputPoint[0], &inputPoint[1], &inputPoint[2], &result[0], &result[1], &result[2], 0, parameters);
+    return result;
+  }
+
+  const ScalarType dx = inputPoint[0] - m_Center[0];
+  const ScalarType dy = inputPoint[1] - m_Center[1];
+  const ScalarType dz = inputPoint[2] - m_Center[2];
+  const ScalarType rho = std::sqrt(dx * dx + dy * dy);
+
+  ScalarType azimuth = std::atan2(dy, dx); // in (-pi,pi]
+  if (azimuth < 0.0)
+  {
+    azimuth += Math::twopi;
+  }
+  if (m_AngleOffset != 0.0)
+  {
+    azimuth -= m_AngleOffset;
+    azimuth -= Math::twopi * std::floor(azimuth / Math::twopi);
+  }
+
+  result[0] = azimuth;
+  result[1] = std::atan2(dz, rho); // in [-pi/2,pi/2]
+  result[2] = std::sqrt(rho * rho + dz * dz);
+  return result;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::ComputeJacobianWithRespectToPosition(
+  const InputPointType & point,
+  JacobianPositionType & jacobian) const
+{
+  jacobian.set_identity();
+
+  const ScalarType dx = point[0] - m_Center[0];
+  const ScalarType dy = point[1] - m_Center[1];
+  const ScalarType dz = point[2] - m_Center[2];
+  const ScalarType rho2 = dx * dx + dy * dy;
+  const ScalarType rho = std::sqrt(rho2);
+  const ScalarType r2 = rho2 + dz * dz;
+  const ScalarType r = std::sqrt(r2);
+
+  jacobian(0, 0) = -dy / rho2;
+  jacobian(0, 1) = dx / rho2;
+  jacobian(0, 2) = 0.0;
+  jacobian(1, 0) = -dx * dz / (r2 * rho);
+  jacobian(1, 1) = -dy * dz / (r2 * rho);
+  jacobian(1, 2) = rho / r2;
+  jacobian(2, 0) = dx / r;
+  jacobian(2, 1) = dy / r;
+  jacobian(2, 2) = dz / r;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::ComputeInverseJacobianWithRespectToPosition(
+  const InputPointType &        point,
+  InverseJacobianPositionType & jacobian) const
+{
+  jacobian.set_identity();
+
+  const ScalarType dx = point[0] - m_Center[0];
+  const ScalarType dy = point[1] - m_Center[1];
+  const ScalarType dz = point[2] - m_Center[2];
+  const ScalarType rho = std::sqrt(dx * dx + dy * dy);
+  const ScalarType r = std::sqrt(rho * rho + dz * dz);
+
+  // derivatives of x = rho cos(phi), y = rho sin(phi), z = r sin(theta) with rho = r cos(theta)
+  jacobian(0, 0) = -dy;
+  jacobian(0, 1) = -dz * dx / rho;
+  jacobian(0, 2) = dx / r;
+  jacobian(1, 0) = dx;
+  jacobian(1, 1) = -dz * dy / rho;
+  jacobian(1, 2) = dy / r;
+  jacobian(2, 0) = 0.0;
+  jacobian(2, 1) = rho;
+  jacobian(2, 2) = dz / r;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::GetInverse(InverseTransformType * inverse) const
+{
+  if (!inverse)
+  {
+    return false;
+  }
+
+  inverse->SetCenter(m_Center);
+  inverse->SetAngleOffset(m_AngleOffset);
+  inverse->SetAngleEvaluation(m_AngleEvaluation);
+  return true;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::GetInverseTransform() const
+  -> InverseTransformBasePointer
+{
+  const auto inverse = InverseTransformType::New();
+  return this->GetInverse(inverse) ? inverse.GetPointer() : nullptr;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::TransformPoints(const InputPointType * inputPoints,
+                                                                                  OutputPointType *      outputPoints,
+                                                                                  SizeValueType numberOfPoints) const
+{
+  constexpr SizeValueType BlockSize = 256;
+
+  ScalarType x[BlockSize];
+  ScalarType y[BlockSize];
+  ScalarType z[BlockSize];
+
+  const PolarTransformKernels::Parameters<ScalarType> parameters = this->GetKernelParameters();
+
+  for (SizeValueType begin = 0; begin < numberOfPoints; begin += BlockSize)
+  {
+    const SizeValueType count = std::min(BlockSize, numberOfPoints - begin);
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      x[i] = inputPoints[begin + i][0];
+      y[i] = inputPoints[begin + i][1];
+      z[i] = inputPoints[begin + i][2];
+    }
+
+    // in place: azimuth, elevation and radius replace x, y and z
+    PolarTransformKernels::CartesianToSpherical(x, y, z, x, y, z, count, parameters);
+
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      OutputPointType & outputPoint = outputPoints[begin + i];
+      if (&outputPoint != &inputPoints[begin + i])
+      {
+        outputPoint = inputPoints[begin + i];
+      }
+      outputPoint[0] = x[i];
+      outputPoint[1] = y[i];
+      outputPoint[2] = z[i];
+    }
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const ScalarType * const * inputComponents,
+  ScalarType * const *       outputComponents,
+  SizeValueType              numberOfPoints) const
+{
+  PolarTransformKernels::CartesianToSpherical(inputComponents[0],
+                                              inputComponents[1],
+                                              inputComponents[2],
+                                              outputComponents[0],
+                                              outputComponents[1],
+                                              outputComponents[2],
+                                              numberOfPoints,
+                                              this->GetKernelParameters());
+
+  for (unsigned int d = 3; d < SpaceDimension; ++d)
+  {
+    if (outputComponents[d] != inputComponents[d])
+    {
+      std::copy_n(inputComponents[d], numberOfPoints, outputComponents[d]);
+    }
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+CartesianToSphericalTransform<TParametersValueType, NDimensions>::GetKernelParameters() const
+  -> PolarTransformKernels::Parameters<ScalarType>
+{
+  PolarTransformKernels::Parameters<ScalarType> parameters;
+  parameters.CenterX = m_Center[0];
+  parameters.CenterY = m_Center[1];
+  parameters.CenterZ = m_Center[2];
+  parameters.AngleOffset = m_AngleOffset;
+  parameters.ExactAngles = m_AngleEvaluation != AngleEvaluationEnum::Approximate;
+  return parameters;
+}
+
+} // namespace itk
+
+#endif
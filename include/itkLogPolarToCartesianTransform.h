@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLogPolarToCartesianTransform_h
+#define itkLogPolarToCartesianTransform_h
+
+#include "itkPolarToCartesianTransform.h"
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+class CartesianToLogPolarTransform;
+
+/** \class LogPolarToCartesianTransform
+ *
+ * \brief Log-polar transformation of a vector space (e.g. space coordinates).
+ *
+ * Transforms the first two coordinates from log-polar space <alpha,rho> to
+ * cartesian coordinates, where rho is the natural logarithm of the radius:
+ * \f[          x_1 = e^\rho cos( \alpha ) \f]
+ * \f[          x_2 = e^\rho sin( \alpha ) \f]
+ * \f[          x_n = x_n, \mbox{ n>=2 } \f]
+ *
+ * \par
+ * The transform is a PolarToCartesianTransform applied to <alpha,exp(rho)>,
+ * so Center, AngleOffset, ReturnNaN and AngleEvaluation have the same meaning
+ * and the batch TransformPoints() use its batch path. With
+ * ConstArcIncr the first coordinate is the arc length at the radius exp(rho).
+ *
+ * \par
+ * In log-polar coordinates a scaling around the Center becomes a shift along
+ * rho, which is what Fourier-Mellin registration relies on. To resample
+ * images, use CartesianToPolarImageFilter and PolarToCartesianImageFilter with
+ * LogPolar On, which tabulate the exponential once per geometry.
+ *
+ * \sa CartesianToLogPolarTransform
+ *
+ * \ingroup Transforms
+ * \ingroup PolarTransform
+ */
+template <typename TParametersValueType = double, // Data type for scalars (float or double)
+          unsigned int NDimensions = 3>           // Number of dimensions
+class ITK_TEMPLATE_EXPORT LogPolarToCartesianTransform
+  : public PolarToCartesianTransform<TParametersValueType, NDimensions>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(LogPolarToCartesianTransform);
+
+  /** Standard class type alias. */
+  using Self = LogPolarToCartesianTransform;
+  using Superclass = PolarToCartesianTransform<TParametersValueType, NDimensions>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** New macro for creation of through the object factory.*/
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(LogPolarToCartesianTransform);
+
+  /** Dimension of the domain space. */
+  static constexpr unsigned int SpaceDimension = NDimensions;
+
+  using ScalarType = typename Superclass::ScalarType;
+  using JacobianPositionType = typename Superclass::JacobianPositionType;
+  using InverseJacobianPositionType = typename Superclass::InverseJacobianPositionType;
+  using InputPointType = typename Superclass::InputPointType;
+  using OutputPointType = typename Superclass::OutputPointType;
+
+  /** Inverse transform type alias. */
+  using InverseTransformType = CartesianToLogPolarTransform<TParametersValueType, NDimensions>;
+  using InverseTransformBasePointer = typename Superclass::InverseTransformBasePointer;
+
+  /** Method to transform a point.
+   * This method transforms first two dimensions of a point from log-polar
+   * coordinates <alpha,rho> to cartesian coordinates.
+   */
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override;
+
+  /** Method to transform a batch of points stored contiguously (array of structures).
+   *
+   * Takes the exponential of rho and uses the batch path of
+   * PolarToCartesianTransform. The output may be the same buffer as the input.
+   */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
+  /** Method to transform a batch of points stored as a structure of arrays.
+   *
+   * inputComponents[d][i] is coordinate d of point i. Each output component
+   * may be the same buffer as the corresponding input component.
+   */
+  void
+  TransformPoints(const ScalarType * const * inputComponents,
+                  ScalarType * const *       outputComponents,
+                  SizeValueType              numberOfPoints) const override;
+
+  /** Compute the Jacobian of the transform with respect to the log-polar input point.
+   *
+   * It is the Jacobian of PolarToCartesianTransform at <alpha,exp(rho)> with
+   * the rho column multiplied by \f$ dr/d\rho = e^\rho \f$.
+   */
+  void
+  ComputeJacobianWithRespectToPosition(const InputPointType & point, JacobianPositionType & jacobian) const override;
+
+  /** Compute the inverse of the Jacobian with respect to the log-polar input point in closed form. */
+  void
+  ComputeInverseJacobianWithRespectToPosition(const InputPointType &        point,
+                                              InverseJacobianPositionType & jacobian) const override;
+
+  using Superclass::ComputeJacobianWithRespectToPosition;
+  using Superclass::ComputeInverseJacobianWithRespectToPosition;
+
+  /** Fill a CartesianToLogPolarTransform with the Center, AngleOffset, ConstArcIncr and AngleEvaluation of this
+   * transform. */
+  bool
+  GetInverse(InverseTransformType * inverse) const;
+
+  /** Return a CartesianToLogPolarTransform inverting this transform. */
+  InverseTransformBasePointer
+  GetInverseTransform() const override;
+
+  /** Compute the bounding box of the cartesian points that the log-polar box [inputMinimum,inputMaximum] maps to.
+   *
+   * The exponential is monotonic, so this is the bounding box of the annulus
+   * sector [alpha0,alpha1] x [exp(rho0),exp(rho1)], see
+   * PolarToCartesianTransform::ComputeOutputBoundingBox().
+   */
+  void
+  ComputeOutputBoundingBox(const InputPointType & inputMinimum,
+                           const InputPointType & inputMaximum,
+                           OutputPointType &      outputMinimum,
+                           OutputPointType &      outputMaximum) const;
+
+protected:
+  LogPolarToCartesianTransform() = default;
+  ~LogPolarToCartesianTransform() override = default;
+}; // class LogPolarToCartesianTransform
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkLogPolarToCartesianTransform.hxx"
+#endif
+
+#endif
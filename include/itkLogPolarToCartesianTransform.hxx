@@ -0,0 +1,144 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLogPolarToCartesianTransform_hxx
+#define itkLogPolarToCartesianTransform_hxx
+
+#include "itkCartesianToLogPolarTransform.h"
+#include <cmath>
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+typename LogPolarToCartesianTransform<TParametersValueType, NDimensions>::OutputPointType
+LogPolarToCartesianTransform<TParametersValueType, NDimensions>::TransformPoint(const InputPointType & inputPoint) const
+{
+  InputPointType polarPoint(inputPoint);
+  polarPoint[1] = std::exp(inputPoint[1]); // r = exp(rho)
+  return Superclass::TransformPoint(polarPoint);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+LogPolarToCartesianTransform<TParametersValueType, NDimensions>::TransformPoints(const InputPointType * inputPoints,
+                                                                                 OutputPointType *      outputPoints,
+                                                                                 SizeValueType numberOfPoints) const
+{
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    if (&outputPoints[i] != &inputPoints[i])
+    {
+      outputPoints[i] = inputPoints[i];
+    }
+    outputPoints[i][1] = std::exp(outputPoints[i][1]); // r = exp(rho)
+  }
+  Superclass::TransformPoints(outputPoints, outputPoints, numberOfPoints);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+LogPolarToCartesianTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const ScalarType * const * inputComponents,
+  ScalarType * const *       outputComponents,
+  SizeValueType              numberOfPoints) const
+{
+  for (SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    outputComponents[1][i] = std::exp(inputComponents[1][i]); // r = exp(rho)
+  }
+
+  // the radius is converted into the output buffer of the second component
+  const ScalarType * polarComponents[SpaceDimension];
+  for (unsigned int d = 0; d < SpaceDimension; ++d)
+  {
+    polarComponents[d] = d == 1 ? outputComponents[1] : inputComponents[d];
+  }
+  Superclass::TransformPoints(polarComponents, outputComponents, numberOfPoints);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+LogPolarToCartesianTransform<TParametersValueType, NDimensions>::ComputeJacobianWithRespectToPosition(
+  const InputPointType & point,
+  JacobianPositionType & jacobian) const
+{
+  InputPointType polarPoint(point);
+  polarPoint[1] = std::exp(point[1]); // r = exp(rho)
+  Superclass::ComputeJacobianWithRespectToPosition(polarPoint, jacobian);
+
+  // dr/drho = r
+  jacobian(0, 1) *= polarPoint[1];
+  jacobian(1, 1) *= polarPoint[1];
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+LogPolarToCartesianTransform<TParametersValueType, NDimensions>::ComputeInverseJacobianWithRespectToPosition(
+  const InputPointType &        point,
+  InverseJacobianPositionType & jacobian) const
+{
+  InputPointType polarPoint(point);
+  polarPoint[1] = std::exp(point[1]); // r = exp(rho)
+  Superclass::ComputeInverseJacobianWithRespectToPosition(polarPoint, jacobian);
+
+  // drho/dr = 1/r
+  jacobian(1, 0) /= polarPoint[1];
+  jacobian(1, 1) /= polarPoint[1];
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+LogPolarToCartesianTransform<TParametersValueType, NDimensions>::GetInverse(InverseTransformType * inverse) const
+{
+  return Superclass::GetInverse(inverse);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+LogPolarToCartesianTransform<TParametersValueType, NDimensions>::GetInverseTransform() const
+  -> InverseTransformBasePointer
+{
+  const auto inverse = InverseTransformType::New();
+  return this->GetInverse(inverse) ? inverse.GetPointer() : nullptr;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+LogPolarToCartesianTransform<TParametersValueType, NDimensions>::ComputeOutputBoundingBox(
+  const InputPointType & inputMinimum,
+  const InputPointType & inputMaximum,
+  OutputPointType &      outputMinimum,
+  OutputPointType &      outputMaximum) const
+{
+  InputPointType polarMinimum(inputMinimum);
+  InputPointType polarMaximum(inputMaximum);
+  polarMinimum[1] = std::exp(inputMinimum[1]);
+  polarMaximum[1] = std::exp(inputMaximum[1]);
+  Superclass::ComputeOutputBoundingBox(polarMinimum, polarMaximum, outputMinimum, outputMaximum);
+}
+
+} // namespace itk
+
+#endif
@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarImageFilterHelpers_h
+#define itkPolarImageFilterHelpers_h
+
+#include "itkContinuousIndex.h"
+#include "itkNumericTraits.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+namespace itk
+{
+
+/** Internal helpers shared by CartesianToPolarImageFilter, PolarToCartesianImageFilter and PolarSamplingMap.
+ *
+ * \ingroup PolarTransform
+ */
+namespace PolarImageFilterHelpers
+{
+
+/** Cast an interpolated value to the output pixel type, clamping it to the pixel range. */
+template <typename TPixel, typename TValue>
+inline TPixel
+CastPixelWithClamping(const TValue & value)
+{
+  const auto minimum = static_cast<TValue>(NumericTraits<TPixel>::NonpositiveMin());
+  const auto maximum = static_cast<TValue>(NumericTraits<TPixel>::max());
+
+  if (value < minimum)
+  {
+    return NumericTraits<TPixel>::NonpositiveMin();
+  }
+  if (value > maximum)
+  {
+    return NumericTraits<TPixel>::max();
+  }
+  return static_cast<TPixel>(value);
+}
+
+
+/** Round an interpolated value to the nearest integer pixel value, halfway cases up, clamping it to the pixel range.
+ * Floating point pixel types are cast as by CastPixelWithClamping(). */
+template <typename TPixel, typename TValue>
+inline TPixel
+RoundPixelWithClamping(const TValue & value)
+{
+  if (std::is_integral<TPixel>::value)
+  {
+    return CastPixelWithClamping<TPixel>(static_cast<TValue>(std::floor(value + TValue(0.5))));
+  }
+  return CastPixelWithClamping<TPixel>(value);
+}
+
+
+/** Compute the region of an image covering the physical box [minimum,maximum], padded by radius (that of the
+ * interpolator) and cropped to the largest possible region. The corners of the box are mapped to continuous indices
+ * of precision TScalar. Returns false when they do not overlap. */
+template <typename TScalar, typename TImage, typename TPoint>
+bool
+ComputeInputRegion(const TImage *                    image,
+                   const TPoint &                    minimum,
+                   const TPoint &                    maximum,
+                   const typename TImage::SizeType & radius,
+                   typename TImage::RegionType &     region)
+{
+  constexpr unsigned int ImageDimension = TImage::ImageDimension;
+  using RegionType = typename TImage::RegionType;
+  using ContinuousIndexType = ContinuousIndex<TScalar, ImageDimension>;
+
+  const RegionType & largestRegion = image->GetLargestPossibleRegion();
+
+  // continuous index bounds of the corners of the box
+  ContinuousIndexType lower;
+  ContinuousIndexType upper;
+  lower.Fill(NumericTraits<TScalar>::max());
+  upper.Fill(NumericTraits<TScalar>::NonpositiveMin());
+  for (unsigned int corner = 0; corner < (1u << ImageDimension); ++corner)
+  {
+    TPoint point;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      point[d] = ((corner >> d) & 1) ? maximum[d] : minimum[d];
+    }
+    const auto index = image->template TransformPhysicalPointToContinuousIndex<TScalar>(point);
+    for (unsigned int k = 0; k < ImageDimension; ++k)
+    {
+      lower[k] = std::min(lower[k], index[k]);
+      upper[k] = std::max(upper[k], index[k]);
+    }
+  }
+
+  // pad and crop in floating point, the bounds may be far outside the index range
+  typename RegionType::IndexType start;
+  typename RegionType::SizeType  size;
+  for (unsigned int k = 0; k < ImageDimension; ++k)
+  {
+    const double first = std::max(std::floor(static_cast<double>(lower[k])) - static_cast<double>(radius[k]),
+                                  static_cast<double>(largestRegion.GetIndex(k)));
+    const double last = std::min(std::ceil(static_cast<double>(upper[k])) + static_cast<double>(radius[k]),
+                                 static_cast<double>(largestRegion.GetUpperIndex()[k]));
+    if (!(first <= last))
+    {
+      return false;
+    }
+    start[k] = static_cast<IndexValueType>(first);
+    size[k] = static_cast<SizeValueType>(last - first) + 1;
+  }
+  region = RegionType(start, size);
+  return true;
+}
+
+} // namespace PolarImageFilterHelpers
+} // namespace itk
+
+#endif
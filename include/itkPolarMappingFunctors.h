@@ -0,0 +1,304 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarMappingFunctors_h
+#define itkPolarMappingFunctors_h
+
+#include "itkPolarTransformEnums.h"
+#include "itkPolarTransformKernels.h"
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace itk
+{
+namespace Functor
+{
+
+/** \class PolarToCartesianMapping
+ *
+ * \brief Non-virtual polar to cartesian mapping with the options fixed at compile time.
+ *
+ * Computes the in-plane mapping of PolarToCartesianTransform:
+ * \f[ x = c_x + r \cos(\alpha + \mbox{AngleOffset}), \quad y = c_y + r \sin(\alpha + \mbox{AngleOffset}) \f]
+ * with \f$ \alpha \f$ replaced by \f$ \alpha / r \f$ when VConstArcIncr is true.
+ * When VReturnNaN is true, angles outside [-pi,pi] map to NaN. The angle offset
+ * is only added when VAngleOffset is true, and VAngleEvaluation selects std::sin
+ * and std::cos or the polynomial approximation of PolarTransformKernels.
+ *
+ * The functor is a small literal type without virtual functions, so inner
+ * loops of filters and iterators can inline it and the disabled options cost
+ * nothing. PolarToCartesianTransform::TransformPoint() delegates to it.
+ *
+ * \sa PolarToCartesianTransform
+ * \ingroup PolarTransform
+ */
+template <typename T,
+          bool                                 VConstArcIncr = false,
+          bool                                 VReturnNaN = false,
+          bool                                 VAngleOffset = false,
+          PolarTransformEnums::AngleEvaluation VAngleEvaluation = PolarTransformEnums::AngleEvaluation::Exact>
+class PolarToCartesianMapping
+{
+public:
+  using ScalarType = T;
+
+  static constexpr bool                                 ConstArcIncr = VConstArcIncr;
+  static constexpr bool                                 ReturnNaN = VReturnNaN;
+  static constexpr bool                                 HasAngleOffset = VAngleOffset;
+  static constexpr PolarTransformEnums::AngleEvaluation AngleEvaluation = VAngleEvaluation;
+
+  constexpr PolarToCartesianMapping() = default;
+
+  constexpr PolarToCartesianMapping(T centerX, T centerY, T angleOffset = T(0))
+    : m_CenterX(centerX)
+    , m_CenterY(centerY)
+    , m_AngleOffset(angleOffset)
+  {}
+
+  constexpr T
+  GetCenterX() const
+  {
+    return m_CenterX;
+  }
+
+  constexpr T
+  GetCenterY() const
+  {
+    return m_CenterY;
+  }
+
+  constexpr T
+  GetAngleOffset() const
+  {
+    return m_AngleOffset;
+  }
+
+  /** Map <alpha,radius> to cartesian coordinates. */
+  void
+  operator()(T alpha, const T radius, T & x, T & y) const
+  {
+    using C = PolarTransformKernels::Constants<T>;
+
+    if constexpr (VConstArcIncr)
+    {
+      alpha /= radius; // alpha = arc/r
+    }
+    if constexpr (VReturnNaN)
+    {
+      if (alpha < -C::Pi || C::Pi < alpha)
+      {
+        x = std::numeric_limits<T>::quiet_NaN();
+        y = std::numeric_limits<T>::quiet_NaN();
+        return;
+      }
+    }
+    if constexpr (VAngleOffset)
+    {
+      alpha += m_AngleOffset; // add offset after NaN return to keep values within [-pi,pi]
+    }
+
+    T sine;
+    T cosine;
+    if constexpr (VAngleEvaluation == PolarTransformEnums::AngleEvaluation::Approximate)
+    {
+      using PackType = PolarTransformKernels::ScalarPack<T>;
+      PackType sinePack;
+      PackType cosinePack;
+      PolarTransformKernels::SinCos(PackType(alpha), sinePack, cosinePack);
+      sine = sinePack.v;
+      cosine = cosinePack.v;
+    }
+    else
+    {
+      sine = std::sin(alpha);
+      cosine = std::cos(alpha);
+    }
+    x = m_CenterX + radius * cosine; // r*cos(alpha)
+    y = m_CenterY + radius * sine;   // r*sin(alpha)
+  }
+
+  /** Map the first two coordinates of a point, leaving the others unchanged. */
+  template <typename TPoint>
+  TPoint
+  operator()(const TPoint & point) const
+  {
+    TPoint result(point);
+    T      x;
+    T      y;
+    (*this)(static_cast<T>(point[0]), static_cast<T>(point[1]), x, y);
+    result[0] = x;
+    result[1] = y;
+    return result;
+  }
+
+private:
+  T m_CenterX{ 0 };
+  T m_CenterY{ 0 };
+  T m_AngleOffset{ 0 };
+};
+
+
+/** \class CartesianToPolarMapping
+ *
+ * \brief Non-virtual cartesian to polar mapping with the options fixed at compile time.
+ *
+ * Computes the in-plane mapping of CartesianToPolarTransform: the radius and
+ * the angle around the center in [0,2*pi), minus the angle offset and wrapped
+ * back into [0,2*pi) when VAngleOffset is true, and multiplied by the radius
+ * when VConstArcIncr is true. The center maps to an angle of 0.
+ * VAngleEvaluation selects std::atan2 or the polynomial approximation of
+ * PolarTransformKernels.
+ *
+ * CartesianToPolarTransform::TransformPoint() delegates to this functor,
+ * unless UseLegacyConvention is On.
+ *
+ * \sa CartesianToPolarTransform
+ * \ingroup PolarTransform
+ */
+template <typename T,
+          bool                                 VConstArcIncr = false,
+          bool                                 VAngleOffset = false,
+          PolarTransformEnums::AngleEvaluation VAngleEvaluation = PolarTransformEnums::AngleEvaluation::Exact>
+class CartesianToPolarMapping
+{
+public:
+  using ScalarType = T;
+
+  static constexpr bool                                 ConstArcIncr = VConstArcIncr;
+  static constexpr bool                                 HasAngleOffset = VAngleOffset;
+  static constexpr PolarTransformEnums::AngleEvaluation AngleEvaluation = VAngleEvaluation;
+
+  constexpr CartesianToPolarMapping() = default;
+
+  constexpr CartesianToPolarMapping(T centerX, T centerY, T angleOffset = T(0))
+    : m_CenterX(centerX)
+    , m_CenterY(centerY)
+    , m_AngleOffset(angleOffset)
+  {}
+
+  constexpr T
+  GetCenterX() const
+  {
+    return m_CenterX;
+  }
+
+  constexpr T
+  GetCenterY() const
+  {
+    return m_CenterY;
+  }
+
+  constexpr T
+  GetAngleOffset() const
+  {
+    return m_AngleOffset;
+  }
+
+  /** Map cartesian coordinates to <alpha,radius>. */
+  void
+  operator()(const T x, const T y, T & alpha, T & radius) const
+  {
+    using C = PolarTransformKernels::Constants<T>;
+
+    const T dx = x - m_CenterX;
+    const T dy = y - m_CenterY;
+    const T r = std::sqrt(dx * dx + dy * dy); // r= sqrt(x^2 + y^2)
+
+    T angle;
+    if constexpr (VAngleEvaluation == PolarTransformEnums::AngleEvaluation::Approximate)
+    {
+      using PackType = PolarTransformKernels::ScalarPack<T>;
+      angle = PolarTransformKernels::Atan2(PackType(dy), PackType(dx)).v;
+    }
+    else
+    {
+      angle = std::atan2(dy, dx); // alpha in (-pi,pi]
+    }
+    if (angle < T(0))
+    {
+      angle += C::TwoPi;
+    }
+
+    if constexpr (VAngleOffset)
+    {
+      // subtract offset after 2*pi adjustment and wrap the result back into [0,2*pi)
+      angle -= m_AngleOffset;
+      angle -= C::TwoPi * std::floor(angle / C::TwoPi);
+    }
+    if constexpr (VConstArcIncr)
+    {
+      angle *= r; // arc= r*alpha
+    }
+
+    alpha = angle;
+    radius = r;
+  }
+
+  /** Map the first two coordinates of a point, leaving the others unchanged. */
+  template <typename TPoint>
+  TPoint
+  operator()(const TPoint & point) const
+  {
+    TPoint result(point);
+    T      alpha;
+    T      radius;
+    (*this)(static_cast<T>(point[0]), static_cast<T>(point[1]), alpha, radius);
+    result[0] = alpha;
+    result[1] = radius;
+    return result;
+  }
+
+private:
+  T m_CenterX{ 0 };
+  T m_CenterY{ 0 };
+  T m_AngleOffset{ 0 };
+};
+
+
+/** Call functor with one std::integral_constant<bool> per runtime flag.
+ *
+ * Turns runtime options into template arguments, so that a transform can pick
+ * the specialized mapping once per call:
+ * \code
+ * DispatchPolarMappingFlags([&](auto constArcIncr, auto returnNaN) { ... }, m_ConstArcIncr, m_ReturnNaN);
+ * \endcode
+ * All instantiations of the functor must return the same type.
+ */
+template <bool... VFlags, typename TFunctor>
+decltype(auto)
+DispatchPolarMappingFlags(TFunctor && functor)
+{
+  return std::forward<TFunctor>(functor)(std::integral_constant<bool, VFlags>{}...);
+}
+
+template <bool... VFlags, typename TFunctor, typename... TFlags>
+decltype(auto)
+DispatchPolarMappingFlags(TFunctor && functor, const bool flag, const TFlags... flags)
+{
+  if (flag)
+  {
+    return DispatchPolarMappingFlags<VFlags..., true>(std::forward<TFunctor>(functor), flags...);
+  }
+  return DispatchPolarMappingFlags<VFlags..., false>(std::forward<TFunctor>(functor), flags...);
+}
+
+} // namespace Functor
+} // namespace itk
+
+#endif
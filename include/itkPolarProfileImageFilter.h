@@ -0,0 +1,222 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarProfileImageFilter_h
+#define itkPolarProfileImageFilter_h
+
+#include "itkImageSink.h"
+#include "itkPolarTransformEnums.h"
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+
+/** \class PolarProfileImageFilter
+ *
+ * \brief Reduce an image to statistics over (radius,angle) bins about a center.
+ *
+ * Every pixel of the cartesian input is assigned to a bin by its radius and
+ * angle about the Center, with the conventions of CartesianToPolarTransform:
+ * the angle is measured counterclockwise from the first axis, minus the
+ * AngleOffset, in [0,2pi). The radius range [0,MaximumRadius] is split into
+ * NumberOfRadiusBins and the full circle into NumberOfAngleBins bins of equal
+ * width. The default of one angle bin gives a radial profile, one radius bin
+ * an angular profile. Count, mean, variance, minimum and maximum are
+ * accumulated per bin.
+ *
+ * Unlike resampling with CartesianToPolarImageFilter and reducing the polar
+ * image, no second image is allocated: each thread accumulates its chunk
+ * into its own bins, which are merged at the end of the chunk, so the memory
+ * is O(bins) and the input can be streamed with SetNumberOfStreamDivisions().
+ * Pixels beyond MaximumRadius are ignored. A MaximumRadius of 0 selects the
+ * distance of the farthest corner of the input, so every pixel is counted.
+ * The slices along the dimensions other than the first two are pooled.
+ *
+ * Bins are taken over the pixel centers, not over areas, so the counts of
+ * the inner radius bins are small and depend on the position of the Center
+ * relative to the grid. ConstArcIncr does not apply: the angle bins always
+ * cover equal angles.
+ *
+ * \sa CartesianToPolarImageFilter
+ * \sa StatisticsImageFilter
+ *
+ * \ingroup PolarTransform
+ */
+template <typename TInputImage>
+class ITK_TEMPLATE_EXPORT PolarProfileImageFilter : public ImageSink<TInputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolarProfileImageFilter);
+
+  /** Standard class type alias. */
+  using Self = PolarProfileImageFilter;
+  using Superclass = ImageSink<TInputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolarProfileImageFilter);
+
+  /** Image related type alias. */
+  using InputImageType = TInputImage;
+  using InputImageRegionType = typename InputImageType::RegionType;
+  using PixelType = typename InputImageType::PixelType;
+  using PointType = typename InputImageType::PointType;
+  using RealType = typename NumericTraits<PixelType>::RealType;
+
+  static constexpr unsigned int ImageDimension = InputImageType::ImageDimension;
+  static_assert(ImageDimension >= 2, "Dimension must be at least 2.");
+
+  /** Scalar type used for the polar mapping. */
+  using ScalarType = double;
+
+  using AngleEvaluationEnum = PolarTransformEnums::AngleEvaluation;
+
+  /** Statistics accumulated for one bin. */
+  struct BinStatistics
+  {
+    SizeValueType Count = 0;
+    RealType      Sum = 0.0;
+    RealType      SumOfSquares = 0.0;
+    RealType      Minimum = NumericTraits<RealType>::max();
+    RealType      Maximum = NumericTraits<RealType>::NonpositiveMin();
+  };
+
+  /** Set/Get the center of the polar coordinates in physical coordinates. */
+  itkSetMacro(Center, PointType);
+  itkGetConstReferenceMacro(Center, PointType);
+
+  /** Set/Get the angle of the first angle bin, counterclockwise from the first axis. */
+  itkSetMacro(AngleOffset, ScalarType);
+  itkGetConstMacro(AngleOffset, ScalarType);
+
+  /** Set/Get the outer radius of the last radius bin. Defaults to 0, the farthest corner of the input. */
+  itkSetMacro(MaximumRadius, ScalarType);
+  itkGetConstMacro(MaximumRadius, ScalarType);
+
+  /** Set/Get the number of radius bins. Defaults to 64. */
+  itkSetClampMacro(NumberOfRadiusBins, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(NumberOfRadiusBins, SizeValueType);
+
+  /** Set/Get the number of angle bins. Defaults to 1, a radial profile. */
+  itkSetClampMacro(NumberOfAngleBins, SizeValueType, 1, NumericTraits<SizeValueType>::max());
+  itkGetConstMacro(NumberOfAngleBins, SizeValueType);
+
+  /** Set/Get how the angles are evaluated. Approximate uses the vectorizable
+   * polynomial kernel, whose error is far below the width of any practical
+   * bin. Incremental evaluates like Exact here. Defaults to Exact. */
+  itkSetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+  itkGetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+
+  /** The MaximumRadius of the last update, with 0 resolved to the farthest corner. */
+  itkGetConstMacro(ComputedMaximumRadius, ScalarType);
+
+  /** Statistics of all bins of the last update, the angle bin varying fastest. */
+  const std::vector<BinStatistics> &
+  GetBinStatistics() const
+  {
+    return m_BinStatistics;
+  }
+
+  /** Statistics of one bin of the last update. Throws if there is no such bin. */
+  const BinStatistics &
+  GetBinStatistics(SizeValueType radiusBin, SizeValueType angleBin) const;
+
+  /** Number of pixels in a bin. */
+  SizeValueType
+  GetCount(SizeValueType radiusBin, SizeValueType angleBin) const
+  {
+    return this->GetBinStatistics(radiusBin, angleBin).Count;
+  }
+
+  /** Mean of a bin, 0 for empty bins. */
+  RealType
+  GetMean(SizeValueType radiusBin, SizeValueType angleBin) const;
+
+  /** Unbiased variance of a bin, 0 for bins with fewer than two pixels. */
+  RealType
+  GetVariance(SizeValueType radiusBin, SizeValueType angleBin) const;
+
+  /** Minimum of a bin, NumericTraits<RealType>::max() for empty bins. */
+  RealType
+  GetMinimum(SizeValueType radiusBin, SizeValueType angleBin) const
+  {
+    return this->GetBinStatistics(radiusBin, angleBin).Minimum;
+  }
+
+  /** Maximum of a bin, NumericTraits<RealType>::NonpositiveMin() for empty bins. */
+  RealType
+  GetMaximum(SizeValueType radiusBin, SizeValueType angleBin) const
+  {
+    return this->GetBinStatistics(radiusBin, angleBin).Maximum;
+  }
+
+protected:
+  PolarProfileImageFilter();
+  ~PolarProfileImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Resolve the MaximumRadius and reset the bins. */
+  void
+  BeforeStreamedGenerateData() override;
+
+  /** Accumulate a chunk into local bins and merge them. */
+  void
+  ThreadedStreamedGenerateData(const InputImageRegionType & regionForThread) override;
+
+  /** Distance of the farthest corner of the input from the Center. */
+  ScalarType
+  ComputeFarthestCornerRadius() const;
+
+  /** Convert a line of cartesian coordinates relative to the Center, starting
+   * at (x,y) with increments (stepX,stepY), to angles and radii, with the
+   * kernels of the batch CartesianToPolarTransform::TransformPoints(). */
+  void
+  ComputeLinePolarCoordinates(ScalarType                x,
+                              ScalarType                y,
+                              const ScalarType          stepX,
+                              const ScalarType          stepY,
+                              std::vector<ScalarType> & lineAlpha,
+                              std::vector<ScalarType> & lineRadius) const;
+
+private:
+  PointType           m_Center;
+  ScalarType          m_AngleOffset = 0.0;
+  ScalarType          m_MaximumRadius = 0.0;
+  SizeValueType       m_NumberOfRadiusBins = 64;
+  SizeValueType       m_NumberOfAngleBins = 1;
+  AngleEvaluationEnum m_AngleEvaluation = AngleEvaluationEnum::Exact;
+
+  ScalarType                 m_ComputedMaximumRadius = 0.0;
+  std::vector<BinStatistics> m_BinStatistics;
+  std::mutex                 m_Mutex;
+}; // class PolarProfileImageFilter
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolarProfileImageFilter.hxx"
+#endif
+
+#endif
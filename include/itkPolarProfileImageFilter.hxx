@@ -0,0 +1,228 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarProfileImageFilter_hxx
+#define itkPolarProfileImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkPolarTransformKernels.h"
+#include "itkMath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+template <typename TInputImage>
+PolarProfileImageFilter<TInputImage>::PolarProfileImageFilter()
+{
+  m_Center.Fill(0.0);
+}
+
+
+template <typename TInputImage>
+void
+PolarProfileImageFilter<TInputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Center: " << m_Center << std::endl;
+  os << indent << "AngleOffset: " << m_AngleOffset << std::endl;
+  os << indent << "MaximumRadius: " << m_MaximumRadius << std::endl;
+  os << indent << "NumberOfRadiusBins: " << m_NumberOfRadiusBins << std::endl;
+  os << indent << "NumberOfAngleBins: " << m_NumberOfAngleBins << std::endl;
+  os << indent << "AngleEvaluation: " << m_AngleEvaluation << std::endl;
+  os << indent << "ComputedMaximumRadius: " << m_ComputedMaximumRadius << std::endl;
+}
+
+
+template <typename TInputImage>
+auto
+PolarProfileImageFilter<TInputImage>::GetBinStatistics(SizeValueType radiusBin, SizeValueType angleBin) const
+  -> const BinStatistics &
+{
+  if (radiusBin >= m_NumberOfRadiusBins || angleBin >= m_NumberOfAngleBins ||
+      m_BinStatistics.size() != m_NumberOfRadiusBins * m_NumberOfAngleBins)
+  {
+    itkExceptionMacro("Bin (" << radiusBin << "," << angleBin << ") is not available, update the filter first");
+  }
+  return m_BinStatistics[radiusBin * m_NumberOfAngleBins + angleBin];
+}
+
+
+template <typename TInputImage>
+auto
+PolarProfileImageFilter<TInputImage>::GetMean(SizeValueType radiusBin, SizeValueType angleBin) const -> RealType
+{
+  const BinStatistics & bin = this->GetBinStatistics(radiusBin, angleBin);
+  return bin.Count > 0 ? bin.Sum / static_cast<RealType>(bin.Count) : RealType{};
+}
+
+
+template <typename TInputImage>
+auto
+PolarProfileImageFilter<TInputImage>::GetVariance(SizeValueType radiusBin, SizeValueType angleBin) const -> RealType
+{
+  const BinStatistics & bin = this->GetBinStatistics(radiusBin, angleBin);
+  if (bin.Count < 2)
+  {
+    return RealType{};
+  }
+  const auto count = static_cast<RealType>(bin.Count);
+  return std::max(RealType{}, (bin.SumOfSquares - bin.Sum * bin.Sum / count) / (count - 1.0));
+}
+
+
+template <typename TInputImage>
+auto
+PolarProfileImageFilter<TInputImage>::ComputeFarthestCornerRadius() const -> ScalarType
+{
+  const InputImageType *       inputPtr = this->GetInput();
+  const InputImageRegionType & region = inputPtr->GetLargestPossibleRegion();
+
+  ScalarType radius = 0.0;
+  for (unsigned int corner = 0; corner < (1u << ImageDimension); ++corner)
+  {
+    typename InputImageType::IndexType index = region.GetIndex();
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if ((corner >> d) & 1)
+      {
+        index[d] = region.GetUpperIndex()[d];
+      }
+    }
+    PointType point;
+    inputPtr->TransformIndexToPhysicalPoint(index, point);
+    const ScalarType dx = point[0] - m_Center[0];
+    const ScalarType dy = point[1] - m_Center[1];
+    radius = std::max(radius, std::sqrt(dx * dx + dy * dy));
+  }
+  return radius;
+}
+
+
+template <typename TInputImage>
+void
+PolarProfileImageFilter<TInputImage>::BeforeStreamedGenerateData()
+{
+  m_ComputedMaximumRadius = m_MaximumRadius > 0.0 ? m_MaximumRadius : this->ComputeFarthestCornerRadius();
+  m_BinStatistics.assign(m_NumberOfRadiusBins * m_NumberOfAngleBins, BinStatistics());
+}
+
+
+template <typename TInputImage>
+void
+PolarProfileImageFilter<TInputImage>::ThreadedStreamedGenerateData(const InputImageRegionType & regionForThread)
+{
+  const InputImageType * inputPtr = this->GetInput();
+
+  const SizeValueType numberOfRadiusBins = m_NumberOfRadiusBins;
+  const SizeValueType numberOfAngleBins = m_NumberOfAngleBins;
+  const ScalarType    radiusScale = m_ComputedMaximumRadius > 0.0 ? numberOfRadiusBins / m_ComputedMaximumRadius : 0.0;
+  const ScalarType    angleScale = numberOfAngleBins / Math::twopi;
+
+  // The farthest corner is counted even if rounding along the line puts it slightly farther out.
+  const ScalarType maximumRadius = m_MaximumRadius > 0.0 ? m_MaximumRadius : NumericTraits<ScalarType>::max();
+
+  // Pixel centers advance by a constant physical step along a scanline.
+  const auto &     indexToPoint = inputPtr->GetIndexToPhysicalPoint();
+  const ScalarType stepX = indexToPoint[0][0];
+  const ScalarType stepY = indexToPoint[1][0];
+
+  const SizeValueType     lineLength = regionForThread.GetSize(0);
+  std::vector<ScalarType> lineAlpha(lineLength);
+  std::vector<ScalarType> lineRadius(lineLength);
+
+  // Bins of this chunk only, merged into the shared bins at the end.
+  std::vector<BinStatistics> bins(numberOfRadiusBins * numberOfAngleBins);
+
+  ImageScanlineConstIterator<InputImageType> it(inputPtr, regionForThread);
+
+  while (!it.IsAtEnd())
+  {
+    PointType linePoint;
+    inputPtr->TransformIndexToPhysicalPoint(it.GetIndex(), linePoint);
+
+    this->ComputeLinePolarCoordinates(
+      linePoint[0] - m_Center[0], linePoint[1] - m_Center[1], stepX, stepY, lineAlpha, lineRadius);
+
+    for (SizeValueType i = 0; !it.IsAtEndOfLine(); ++i, ++it)
+    {
+      const ScalarType radius = lineRadius[i];
+      if (radius > maximumRadius)
+      {
+        continue;
+      }
+      const auto radiusBin = std::min(static_cast<SizeValueType>(radius * radiusScale), numberOfRadiusBins - 1);
+      const auto angleBin =
+        std::min(static_cast<SizeValueType>(std::max(lineAlpha[i], 0.0) * angleScale), numberOfAngleBins - 1);
+
+      const auto      value = static_cast<RealType>(it.Get());
+      BinStatistics & bin = bins[radiusBin * numberOfAngleBins + angleBin];
+      ++bin.Count;
+      bin.Sum += value;
+      bin.SumOfSquares += value * value;
+      bin.Minimum = std::min(bin.Minimum, value);
+      bin.Maximum = std::max(bin.Maximum, value);
+    }
+    it.NextLine();
+  }
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  for (SizeValueType k = 0; k < bins.size(); ++k)
+  {
+    BinStatistics & merged = m_BinStatistics[k];
+    merged.Count += bins[k].Count;
+    merged.Sum += bins[k].Sum;
+    merged.SumOfSquares += bins[k].SumOfSquares;
+    merged.Minimum = std::min(merged.Minimum, bins[k].Minimum);
+    merged.Maximum = std::max(merged.Maximum, bins[k].Maximum);
+  }
+}
+
+
+template <typename TInputImage>
+void
+PolarProfileImageFilter<TInputImage>::ComputeLinePolarCoordinates(ScalarType                x,
+                                                                  ScalarType                y,
+                                                                  const ScalarType          stepX,
+                                                                  const ScalarType          stepY,
+                                                                  std::vector<ScalarType> & lineAlpha,
+                                                                  std::vector<ScalarType> & lineRadius) const
+{
+  const auto lineLength = static_cast<SizeValueType>(lineAlpha.size());
+
+  // Cartesian coordinates relative to the center, converted in place.
+  for (SizeValueType i = 0; i < lineLength; ++i)
+  {
+    lineAlpha[i] = x;
+    lineRadius[i] = y;
+    x += stepX;
+    y += stepY;
+  }
+
+  // same mapping as the batch TransformPoints() of CartesianToPolarTransform
+  PolarTransformKernels::Parameters<ScalarType> kernelParameters;
+  kernelParameters.AngleOffset = m_AngleOffset;
+  kernelParameters.ExactAngles = m_AngleEvaluation != AngleEvaluationEnum::Approximate;
+  PolarTransformKernels::CartesianToPolar(
+    lineAlpha.data(), lineRadius.data(), lineAlpha.data(), lineRadius.data(), lineLength, kernelParameters);
+}
+
+} // namespace itk
+
+#endif
@@ -0,0 +1,168 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarRotationEstimator_h
+#define itkPolarRotationEstimator_h
+
+#include "itkImage.h"
+#include "itkObject.h"
+
+namespace itk
+{
+
+/** \class PolarRotationEstimator
+ *
+ * \brief Estimate the rotation between two images about a center by circular cross-correlation.
+ *
+ * A rotation about the Center is a shift along the angle axis of the polar
+ * images <alpha,radius>. Both images are resampled once onto the same polar
+ * grid with CartesianToPolarImageFilter, every angle line is Fourier
+ * transformed, and the cross-power spectra of all lines are accumulated with
+ * the weight r of the polar area element. The inverse transform of the sum is
+ * the circular cross-correlation over all shifts at once, so Compute() costs
+ * O(pixels log NumberOfAngles) instead of one resampling per candidate angle.
+ * The peak is refined to a fraction of an angle bin with a parabola through
+ * the peak and its two neighbors.
+ *
+ * The result is returned as AngleOffset: CartesianToPolarImageFilter (or a
+ * PolarToCartesianTransform) with this AngleOffset maps the moving image onto
+ * the polar image of the fixed image with AngleOffset 0. The moving image is
+ * the fixed image rotated counterclockwise by AngleOffset, in (-pi,pi], about
+ * the Center.
+ *
+ * The annulus [MinimumRadius,MaximumRadius] is sampled with NumberOfRadii
+ * rings. A MaximumRadius of 0 selects the largest circle inside both images,
+ * a NumberOfRadii of 0 one ring per in-plane pixel spacing. NumberOfAngles
+ * must factor into 2, 3 and 5 for vnl_fft_1d. The mean of every ring is
+ * removed, so constant intensity offsets between the images do not bias the
+ * estimate. Dimensions other than the first two follow the fixed image, and
+ * all their slices are accumulated.
+ *
+ * \sa CartesianToPolarImageFilter
+ * \sa PolarToCartesianTransform
+ *
+ * \ingroup PolarTransform
+ */
+template <typename TImage>
+class ITK_TEMPLATE_EXPORT PolarRotationEstimator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolarRotationEstimator);
+
+  /** Standard class type alias. */
+  using Self = PolarRotationEstimator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolarRotationEstimator);
+
+  /** Image related type alias. */
+  using ImageType = TImage;
+  using PixelType = typename ImageType::PixelType;
+  using PointType = typename ImageType::PointType;
+  using RealType = typename NumericTraits<PixelType>::RealType;
+
+  static constexpr unsigned int ImageDimension = ImageType::ImageDimension;
+  static_assert(ImageDimension >= 2, "The images need at least two dimensions.");
+
+  /** Polar images the correlation is computed on. */
+  using PolarImageType = Image<RealType, ImageDimension>;
+
+  /** Set/Get the image the rotation is measured from. */
+  itkSetConstObjectMacro(FixedImage, ImageType);
+  itkGetConstObjectMacro(FixedImage, ImageType);
+
+  /** Set/Get the rotated image. */
+  itkSetConstObjectMacro(MovingImage, ImageType);
+  itkGetConstObjectMacro(MovingImage, ImageType);
+
+  /** Set/Get the center of rotation in physical coordinates. */
+  itkSetMacro(Center, PointType);
+  itkGetConstReferenceMacro(Center, PointType);
+
+  /** Set/Get the inner radius of the annulus. Defaults to 0. */
+  itkSetMacro(MinimumRadius, double);
+  itkGetConstMacro(MinimumRadius, double);
+
+  /** Set/Get the outer radius of the annulus. Defaults to 0, the largest circle inside both images. */
+  itkSetMacro(MaximumRadius, double);
+  itkGetConstMacro(MaximumRadius, double);
+
+  /** Set/Get the number of angle bins, which must factor into 2, 3 and 5. Defaults to 360. */
+  itkSetMacro(NumberOfAngles, SizeValueType);
+  itkGetConstMacro(NumberOfAngles, SizeValueType);
+
+  /** Set/Get the number of rings. Defaults to 0, one ring per in-plane pixel spacing. */
+  itkSetMacro(NumberOfRadii, SizeValueType);
+  itkGetConstMacro(NumberOfRadii, SizeValueType);
+
+  /** Resample both images onto the polar grid and estimate the rotation. */
+  void
+  Compute();
+
+  /** The AngleOffset mapping the polar image of the moving image onto that of the fixed image, in (-pi,pi]. */
+  itkGetConstMacro(AngleOffset, double);
+
+  /** Normalized cross-correlation at the peak, in [-1,1]. Values near 1 indicate a reliable estimate. */
+  itkGetConstMacro(Correlation, double);
+
+  /** Whether the number of angles factors into 2, 3 and 5. */
+  static bool
+  IsSupportedNumberOfAngles(SizeValueType numberOfAngles);
+
+protected:
+  PolarRotationEstimator();
+  ~PolarRotationEstimator() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Radius of the largest circle about the Center inside the physical extent of the image. */
+  double
+  ComputeLargestInscribedRadius(const ImageType * image) const;
+
+  /** Resample an image onto the polar grid of the current settings. */
+  typename PolarImageType::Pointer
+  ComputePolarImage(const ImageType * image, double maximumRadius, SizeValueType numberOfRadii) const;
+
+private:
+  typename ImageType::ConstPointer m_FixedImage;
+  typename ImageType::ConstPointer m_MovingImage;
+
+  PointType     m_Center;
+  double        m_MinimumRadius = 0.0;
+  double        m_MaximumRadius = 0.0;
+  SizeValueType m_NumberOfAngles = 360;
+  SizeValueType m_NumberOfRadii = 0;
+
+  double m_AngleOffset = 0.0;
+  double m_Correlation = 0.0;
+}; // class PolarRotationEstimator
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolarRotationEstimator.hxx"
+#endif
+
+#endif
@@ -0,0 +1,313 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarRotationEstimator_hxx
+#define itkPolarRotationEstimator_hxx
+
+#include "itkCartesianToPolarImageFilter.h"
+#include "itkMultiThreaderBase.h"
+#include "itkMath.h"
+#include "vnl/algo/vnl_fft_1d.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+
+template <typename TImage>
+PolarRotationEstimator<TImage>::PolarRotationEstimator()
+{
+  m_Center.Fill(0.0);
+}
+
+
+template <typename TImage>
+void
+PolarRotationEstimator<TImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(FixedImage);
+  itkPrintSelfObjectMacro(MovingImage);
+  os << indent << "Center: " << m_Center << std::endl;
+  os << indent << "MinimumRadius: " << m_MinimumRadius << std::endl;
+  os << indent << "MaximumRadius: " << m_MaximumRadius << std::endl;
+  os << indent << "NumberOfAngles: " << m_NumberOfAngles << std::endl;
+  os << indent << "NumberOfRadii: " << m_NumberOfRadii << std::endl;
+  os << indent << "AngleOffset: " << m_AngleOffset << std::endl;
+  os << indent << "Correlation: " << m_Correlation << std::endl;
+}
+
+
+template <typename TImage>
+bool
+PolarRotationEstimator<TImage>::IsSupportedNumberOfAngles(SizeValueType numberOfAngles)
+{
+  if (numberOfAngles == 0)
+  {
+    return false;
+  }
+  for (const SizeValueType factor : { 2, 3, 5 })
+  {
+    while (numberOfAngles % factor == 0)
+    {
+      numberOfAngles /= factor;
+    }
+  }
+  return numberOfAngles == 1;
+}
+
+
+template <typename TImage>
+double
+PolarRotationEstimator<TImage>::ComputeLargestInscribedRadius(const ImageType * image) const
+{
+  // in-plane physical bounding box of the pixel centers
+  const typename ImageType::RegionType & region = image->GetLargestPossibleRegion();
+  double                                 minimum[2];
+  double                                 maximum[2];
+  for (unsigned int d = 0; d < 2; ++d)
+  {
+    minimum[d] = NumericTraits<double>::max();
+    maximum[d] = NumericTraits<double>::NonpositiveMin();
+  }
+  for (unsigned int corner = 0; corner < (1u << ImageDimension); ++corner)
+  {
+    typename ImageType::IndexType index = region.GetIndex();
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if ((corner >> d) & 1)
+      {
+        index[d] = region.GetUpperIndex()[d];
+      }
+    }
+    PointType point;
+    image->TransformIndexToPhysicalPoint(index, point);
+    for (unsigned int d = 0; d < 2; ++d)
+    {
+      minimum[d] = std::min<double>(minimum[d], point[d]);
+      maximum[d] = std::max<double>(maximum[d], point[d]);
+    }
+  }
+
+  double radius = NumericTraits<double>::max();
+  for (unsigned int d = 0; d < 2; ++d)
+  {
+    radius = std::min({ radius, m_Center[d] - minimum[d], maximum[d] - m_Center[d] });
+  }
+  return std::max(radius, 0.0);
+}
+
+
+template <typename TImage>
+typename PolarRotationEstimator<TImage>::PolarImageType::Pointer
+PolarRotationEstimator<TImage>::ComputePolarImage(const ImageType * image,
+                                                  double            maximumRadius,
+                                                  SizeValueType     numberOfRadii) const
+{
+  using FilterType = CartesianToPolarImageFilter<ImageType, PolarImageType>;
+
+  // the angle and radius axes, then the remaining dimensions of the fixed image
+  const typename ImageType::RegionType & fixedRegion = m_FixedImage->GetLargestPossibleRegion();
+  typename FilterType::SizeType          size;
+  typename FilterType::IndexType         startIndex;
+  typename FilterType::SpacingType       spacing;
+  typename FilterType::OriginPointType   origin;
+  size[0] = m_NumberOfAngles;
+  size[1] = numberOfRadii;
+  startIndex[0] = 0;
+  startIndex[1] = 0;
+  spacing[0] = Math::twopi / static_cast<double>(m_NumberOfAngles);
+  spacing[1] = numberOfRadii > 1 ? (maximumRadius - m_MinimumRadius) / static_cast<double>(numberOfRadii - 1) : 1.0;
+  origin[0] = 0.0;
+  origin[1] = m_MinimumRadius;
+  for (unsigned int d = 2; d < ImageDimension; ++d)
+  {
+    size[d] = fixedRegion.GetSize(d);
+    startIndex[d] = fixedRegion.GetIndex(d);
+    spacing[d] = m_FixedImage->GetSpacing()[d];
+    origin[d] = m_FixedImage->GetOrigin()[d];
+  }
+
+  const auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetCenter(m_Center);
+  filter->SetSize(size);
+  filter->SetOutputStartIndex(startIndex);
+  filter->SetOutputSpacing(spacing);
+  filter->SetOutputOrigin(origin);
+  filter->Update();
+
+  typename PolarImageType::Pointer polarImage = filter->GetOutput();
+  polarImage->DisconnectPipeline();
+  return polarImage;
+}
+
+
+template <typename TImage>
+void
+PolarRotationEstimator<TImage>::Compute()
+{
+  if (m_FixedImage.IsNull() || m_MovingImage.IsNull())
+  {
+    itkExceptionMacro("Fixed and moving images must be set");
+  }
+  if (!IsSupportedNumberOfAngles(m_NumberOfAngles))
+  {
+    itkExceptionMacro("NumberOfAngles " << m_NumberOfAngles << " does not factor into 2, 3 and 5");
+  }
+
+  double maximumRadius = m_MaximumRadius;
+  if (maximumRadius <= 0.0)
+  {
+    maximumRadius = std::min(this->ComputeLargestInscribedRadius(m_FixedImage),
+                             this->ComputeLargestInscribedRadius(m_MovingImage));
+  }
+  if (!(maximumRadius > m_MinimumRadius))
+  {
+    itkExceptionMacro("The annulus [" << m_MinimumRadius << "," << maximumRadius << "] about " << m_Center
+                                      << " is empty");
+  }
+
+  SizeValueType numberOfRadii = m_NumberOfRadii;
+  if (numberOfRadii == 0)
+  {
+    const double spacing = std::min(m_FixedImage->GetSpacing()[0], m_FixedImage->GetSpacing()[1]);
+    numberOfRadii = static_cast<SizeValueType>(std::floor((maximumRadius - m_MinimumRadius) / spacing)) + 1;
+  }
+
+  const auto fixedPolar = this->ComputePolarImage(m_FixedImage, maximumRadius, numberOfRadii);
+  const auto movingPolar = this->ComputePolarImage(m_MovingImage, maximumRadius, numberOfRadii);
+
+  // Both polar images have the same grid, and every angle line is contiguous in their buffers.
+  using ComplexType = std::complex<double>;
+  const SizeValueType numberOfAngles = m_NumberOfAngles;
+  const SizeValueType numberOfLines = fixedPolar->GetBufferedRegion().GetNumberOfPixels() / numberOfAngles;
+  const RealType *    fixedBuffer = fixedPolar->GetBufferPointer();
+  const RealType *    movingBuffer = movingPolar->GetBufferPointer();
+  const double        radiusSpacing = fixedPolar->GetSpacing()[1];
+
+  // sum over the lines of r * conj(F) * M, and of r * f^2 and r * m^2 for the normalization
+  std::vector<ComplexType> spectrum(numberOfAngles);
+  double                   fixedEnergy = 0.0;
+  double                   movingEnergy = 0.0;
+  std::mutex               mutex;
+
+  ImageRegion<1> lines;
+  lines.SetSize(0, numberOfLines);
+  MultiThreaderBase::New()->template ParallelizeImageRegion<1>(
+    lines,
+    [&](const ImageRegion<1> & chunk) {
+      vnl_fft_1d<double>       fft(static_cast<int>(numberOfAngles));
+      std::vector<ComplexType> fixedLine(numberOfAngles);
+      std::vector<ComplexType> movingLine(numberOfAngles);
+      std::vector<ComplexType> chunkSpectrum(numberOfAngles);
+      double                   chunkFixedEnergy = 0.0;
+      double                   chunkMovingEnergy = 0.0;
+
+      const SizeValueType first = chunk.GetIndex(0);
+      const SizeValueType last = first + chunk.GetSize(0);
+      for (SizeValueType line = first; line < last; ++line)
+      {
+        const double radius = m_MinimumRadius + static_cast<double>(line % numberOfRadii) * radiusSpacing;
+        if (!(radius > 0.0))
+        {
+          continue;
+        }
+
+        const RealType * fixedValues = fixedBuffer + line * numberOfAngles;
+        const RealType * movingValues = movingBuffer + line * numberOfAngles;
+        double           fixedMean = 0.0;
+        double           movingMean = 0.0;
+        for (SizeValueType i = 0; i < numberOfAngles; ++i)
+        {
+          fixedMean += fixedValues[i];
+          movingMean += movingValues[i];
+        }
+        fixedMean /= static_cast<double>(numberOfAngles);
+        movingMean /= static_cast<double>(numberOfAngles);
+
+        for (SizeValueType i = 0; i < numberOfAngles; ++i)
+        {
+          const double fixedValue = fixedValues[i] - fixedMean;
+          const double movingValue = movingValues[i] - movingMean;
+          fixedLine[i] = fixedValue;
+          movingLine[i] = movingValue;
+          chunkFixedEnergy += radius * fixedValue * fixedValue;
+          chunkMovingEnergy += radius * movingValue * movingValue;
+        }
+
+        fft.fwd_transform(fixedLine);
+        fft.fwd_transform(movingLine);
+        for (SizeValueType k = 0; k < numberOfAngles; ++k)
+        {
+          chunkSpectrum[k] += radius * std::conj(fixedLine[k]) * movingLine[k];
+        }
+      }
+
+      const std::lock_guard<std::mutex> lock(mutex);
+      for (SizeValueType k = 0; k < numberOfAngles; ++k)
+      {
+        spectrum[k] += chunkSpectrum[k];
+      }
+      fixedEnergy += chunkFixedEnergy;
+      movingEnergy += chunkMovingEnergy;
+    },
+    nullptr);
+
+  // correlation[k] = sum over the lines of r * sum_i f[i] * m[i + k], scaled by numberOfAngles
+  vnl_fft_1d<double> fft(static_cast<int>(numberOfAngles));
+  fft.bwd_transform(spectrum);
+
+  SizeValueType peak = 0;
+  for (SizeValueType k = 1; k < numberOfAngles; ++k)
+  {
+    if (spectrum[k].real() > spectrum[peak].real())
+    {
+      peak = k;
+    }
+  }
+
+  // parabola through the peak and its neighbors on the circle
+  const double before = spectrum[(peak + numberOfAngles - 1) % numberOfAngles].real();
+  const double center = spectrum[peak].real();
+  const double after = spectrum[(peak + 1) % numberOfAngles].real();
+  const double curvature = before - 2.0 * center + after;
+  const double delta = curvature < 0.0 ? 0.5 * (before - after) / curvature : 0.0;
+  const double peakValue = (center - 0.25 * (before - after) * delta) / static_cast<double>(numberOfAngles);
+
+  double angleOffset = (static_cast<double>(peak) + delta) * Math::twopi / static_cast<double>(numberOfAngles);
+  if (angleOffset > Math::pi)
+  {
+    angleOffset -= Math::twopi;
+  }
+  else if (angleOffset <= -Math::pi)
+  {
+    angleOffset += Math::twopi;
+  }
+  m_AngleOffset = angleOffset;
+
+  const double energy = std::sqrt(fixedEnergy * movingEnergy);
+  m_Correlation = energy > 0.0 ? std::max(-1.0, std::min(1.0, peakValue / energy)) : 0.0;
+}
+
+} // namespace itk
+
+#endif
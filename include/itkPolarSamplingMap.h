@@ -0,0 +1,252 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarSamplingMap_h
+#define itkPolarSamplingMap_h
+
+#include "itkImage.h"
+#include "itkTransform.h"
+#include "itkTimeStamp.h"
+#include "itkPolarTransformKernels.h"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+
+/** \class PolarSamplingMap
+ *
+ * \brief Cached resampling map for a fixed transform and image geometry.
+ *
+ * When a sequence of frames (cine or streaming ultrasound, video) is
+ * resampled through a PolarToCartesianTransform or CartesianToPolarTransform
+ * with an unchanged geometry, every frame would otherwise recompute the same
+ * transcendental functions for every output pixel. This object evaluates the
+ * transform once per output pixel, stores the input buffer offset of the
+ * base corner and the linear interpolation fractions of every sample, and
+ * then resamples any number of frames with a pure gather.
+ *
+ * The map is rebuilt automatically by Apply() when the transform or this
+ * object is modified, or when the geometry (buffered region, origin,
+ * spacing, direction) of the input frame differs from the one the map was
+ * built for. Interpolation is n-linear and matches
+ * LinearInterpolateImageFunction, including its clamping at the buffer
+ * border; samples outside the buffer get the DefaultPixelValue. Unlike
+ * ResampleImageFilter, which truncates, integer outputs are rounded to the
+ * nearest value, halfway cases up. Fractions are stored as
+ * TWeightPrecisionType, float by default to halve the memory traffic of the
+ * map. Only scalar pixel types are supported.
+ *
+ * For integer pixel types of at most 16 bits, such as the 8 and 16 bit frames
+ * of ultrasound scan conversion, FixedPointWeightBits selects a fixed-point
+ * map instead, which halves the memory traffic of the gather: every sample
+ * stores a 32 bit buffer offset and one 16 bit fraction per dimension in
+ * units of 2^-b, 8 bytes in 2-D and 12 bytes in 3-D against 16 and 24 bytes
+ * with float fractions (see GetMapSizeInBytes()). The input buffer must have
+ * fewer than 2^31 pixels. The gather interpolates the corners dimension by
+ * dimension in integer arithmetic, keeping intermediate values in units of
+ * 2^-b, and rounds to the output like the floating point path. Corners are
+ * clamped so that every sample reads all its corners inside the buffer. When
+ * AVX2 is enabled and the output pixel type is an integer of at most 16 bits,
+ * PolarTransformKernels::FixedPointGather() processes eight samples per
+ * register, with the same results as the scalar loop used otherwise. Each
+ * fraction is rounded by at most 2^-(b+1), except that with b = 16 a
+ * fraction of one is stored as 1 - 2^-16, so before the rounding the result
+ * differs from the floating point map by at most N 2^-b times the range of
+ * the contributing corner values, plus (N - 1) 2^-(b+1) from the
+ * intermediate values. For 2-D frames that is 0.8% of the range with b = 8
+ * and 0.003% with b = 16, so with Q16 8 bit outputs differ by at most one
+ * gray level, where the exact value lies within 0.008 of a half-integer, and
+ * Q8 outputs by at most two. Both paths round the same way for signed pixel
+ * types, so the differences carry no bias.
+ *
+ * Apply() is multithreaded but not reentrant: do not call it concurrently on
+ * the same map.
+ *
+ * \sa PolarToCartesianTransform
+ * \sa CartesianToPolarTransform
+ *
+ * \ingroup PolarTransform
+ */
+template <typename TInputImage,
+          typename TOutputImage = TInputImage,
+          typename TWeightPrecisionType = float,
+          typename TTransformPrecisionType = double>
+class ITK_TEMPLATE_EXPORT PolarSamplingMap : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolarSamplingMap);
+
+  /** Standard class type alias. */
+  using Self = PolarSamplingMap;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolarSamplingMap);
+
+  /** Image related type alias. */
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputPixelType = typename InputImageType::PixelType;
+  using OutputPixelType = typename OutputImageType::PixelType;
+  using RealType = typename NumericTraits<InputPixelType>::RealType;
+
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+  static_assert(TInputImage::ImageDimension == ImageDimension, "Input and output dimensions must agree.");
+
+  /** Transform type alias. */
+  using TransformType = Transform<TTransformPrecisionType, ImageDimension, ImageDimension>;
+  using TransformConstPointer = typename TransformType::ConstPointer;
+
+  /** Output grid type alias. */
+  using RegionType = typename OutputImageType::RegionType;
+  using SizeType = typename OutputImageType::SizeType;
+  using IndexType = typename OutputImageType::IndexType;
+  using SpacingType = typename OutputImageType::SpacingType;
+  using PointType = typename OutputImageType::PointType;
+  using DirectionType = typename OutputImageType::DirectionType;
+
+  using WeightType = TWeightPrecisionType;
+
+  /** Set/Get the transform mapping output points to input points. */
+  itkSetConstObjectMacro(Transform, TransformType);
+  itkGetConstObjectMacro(Transform, TransformType);
+
+  /** Set/Get the pixel value assigned to output pixels that map outside the input. */
+  itkSetMacro(DefaultPixelValue, OutputPixelType);
+  itkGetConstReferenceMacro(DefaultPixelValue, OutputPixelType);
+
+  /** Set/Get the number of fractional bits b of fixed-point weights, 8 for Q8 and up to 16 for Q16. Requires an
+   * integer input pixel type of at most 16 bits and an input buffer of fewer than 2^31 pixels. Defaults to 0,
+   * floating point weights. */
+  itkSetClampMacro(FixedPointWeightBits, unsigned int, 0, 16);
+  itkGetConstMacro(FixedPointWeightBits, unsigned int);
+
+  /** Set/Get the output image geometry. */
+  itkSetMacro(Size, SizeType);
+  itkGetConstReferenceMacro(Size, SizeType);
+  itkSetMacro(OutputStartIndex, IndexType);
+  itkGetConstReferenceMacro(OutputStartIndex, IndexType);
+  itkSetMacro(OutputSpacing, SpacingType);
+  itkGetConstReferenceMacro(OutputSpacing, SpacingType);
+  itkSetMacro(OutputOrigin, PointType);
+  itkGetConstReferenceMacro(OutputOrigin, PointType);
+  itkSetMacro(OutputDirection, DirectionType);
+  itkGetConstReferenceMacro(OutputDirection, DirectionType);
+
+  /** Copy the output geometry from an image. */
+  void
+  SetOutputParametersFromImage(const ImageBase<ImageDimension> * image);
+
+  /** Precompute the sampling map for frames with the geometry of the reference image. */
+  void
+  Build(const InputImageType * referenceImage);
+
+  /** Whether the map was built for the current settings and the geometry of the input. */
+  bool
+  IsUpToDate(const InputImageType * input) const;
+
+  /** Resample one frame, rebuilding the map first if it is out of date.
+   *
+   * The output is allocated with the output geometry if needed.
+   */
+  void
+  Apply(const InputImageType * input, OutputImageType * output);
+
+  /** Number of samples in the map, i.e. the number of output pixels. */
+  SizeValueType
+  GetNumberOfSamples() const
+  {
+    return static_cast<SizeValueType>(m_FixedPointWeightBits > 0 ? m_FixedPointSamples.size() : m_Samples.size());
+  }
+
+  /** Memory footprint of the map in bytes, which the gather reads once per frame. */
+  SizeValueType
+  GetMapSizeInBytes() const
+  {
+    return static_cast<SizeValueType>(m_Samples.size() * sizeof(Sample) +
+                                      m_FixedPointSamples.size() * sizeof(FixedPointSample));
+  }
+
+protected:
+  PolarSamplingMap();
+  ~PolarSamplingMap() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** Precomputed sample: buffer offset of the base corner, or -1 outside the input, and the fractions. */
+  struct Sample
+  {
+    OffsetValueType BaseOffset;
+    WeightType      Fraction[ImageDimension];
+  };
+
+  static constexpr unsigned int NumberOfCorners = 1u << ImageDimension;
+
+  /** Precomputed fixed-point sample: buffer offset of the base corner, or -1 outside the input, and the fractions in
+   * units of 2^-FixedPointWeightBits. The corner weights are formed in the gather. */
+  using FixedPointSample = PolarTransformKernels::FixedPointSample<ImageDimension>;
+
+  /** Whether FixedPointWeightBits suits the input pixel type. */
+  static constexpr bool
+  IsFixedPointPixelType()
+  {
+    return std::is_integral<InputPixelType>::value && sizeof(InputPixelType) <= 2;
+  }
+
+  /** Resample one frame through m_FixedPointSamples. */
+  void
+  ApplyFixedPoint(const InputImageType * input, OutputImageType * output) const;
+
+  TransformConstPointer m_Transform;
+  OutputPixelType       m_DefaultPixelValue{};
+  unsigned int          m_FixedPointWeightBits = 0;
+
+  SizeType      m_Size;
+  IndexType     m_OutputStartIndex;
+  SpacingType   m_OutputSpacing;
+  PointType     m_OutputOrigin;
+  DirectionType m_OutputDirection;
+
+  std::vector<Sample>           m_Samples;
+  std::vector<FixedPointSample> m_FixedPointSamples;
+
+  /** Geometry of the input the map was built for. */
+  typename InputImageType::RegionType    m_InputBufferedRegion;
+  typename InputImageType::PointType     m_InputOrigin;
+  typename InputImageType::SpacingType   m_InputSpacing;
+  typename InputImageType::DirectionType m_InputDirection;
+
+  TimeStamp m_BuildTime;
+}; // class PolarSamplingMap
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolarSamplingMap.hxx"
+#endif
+
+#endif
@@ -0,0 +1,375 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarSamplingMap_hxx
+#define itkPolarSamplingMap_hxx
+
+#include "itkMultiThreaderBase.h"
+#include "itkNumericTraits.h"
+#include "itkPolarImageFilterHelpers.h"
+#include "itkMath.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage, typename TWeightPrecisionType, typename TTransformPrecisionType>
+PolarSamplingMap<TInputImage, TOutputImage, TWeightPrecisionType, TTransformPrecisionType>::PolarSamplingMap()
+{
+  m_Size.Fill(0);
+  m_OutputStartIndex.Fill(0);
+  m_OutputSpacing.Fill(1.0);
+  m_OutputOrigin.Fill(0.0);
+  m_OutputDirection.SetIdentity();
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TWeightPrecisionType, typename TTransformPrecisionType>
+void
+PolarSamplingMap<TInputImage, TOutputImage, TWeightPrecisionType, TTransformPrecisionType>::PrintSelf(
+  std::ostream & os,
+  Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Transform);
+  os << indent << "DefaultPixelValue: "
+     << static_cast<typename NumericTraits<OutputPixelType>::PrintType>(m_DefaultPixelValue) << std::endl;
+  os << indent << "Size: " << m_Size << std::endl;
+  os << indent << "OutputStartIndex: " << m_OutputStartIndex << std::endl;
+  os << indent << "OutputSpacing: " << m_OutputSpacing << std::endl;
+  os << indent << "OutputOrigin: " << m_OutputOrigin << std::endl;
+  os << indent << "OutputDirection: " << m_OutputDirection << std::endl;
+  os << indent << "FixedPointWeightBits: " << m_FixedPointWeightBits << std::endl;
+  os << indent << "NumberOfSamples: " << this->GetNumberOfSamples() << std::endl;
+  os << indent << "MapSizeInBytes: " << this->GetMapSizeInBytes() << std::endl;
+  os << indent << "BuildTime: " << m_BuildTime.GetMTime() << std::endl;
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TWeightPrecisionType, typename TTransformPrecisionType>
+void
+PolarSamplingMap<TInputImage, TOutputImage, TWeightPrecisionType, TTransformPrecisionType>::
+  SetOutputParametersFromImage(const ImageBase<ImageDimension> * image)
+{
+  this->SetOutputOrigin(image->GetOrigin());
+  this->SetOutputSpacing(image->GetSpacing());
+  this->SetOutputDirection(image->GetDirection());
+  this->SetOutputStartIndex(image->GetLargestPossibleRegion().GetIndex());
+  this->SetSize(image->GetLargestPossibleRegion().GetSize());
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TWeightPrecisionType, typename TTransformPrecisionType>
+bool
+PolarSamplingMap<TInputImage, TOutputImage, TWeightPrecisionType, TTransformPrecisionType>::IsUpToDate(
+  const InputImageType * input) const
+{
+  const ModifiedTimeType buildTime = m_BuildTime.GetMTime();
+  if (buildTime == 0 || this->GetMTime() > buildTime || (m_Transform && m_Transform->GetMTime() > buildTime))
+  {
+    return false;
+  }
+  return input->GetBufferedRegion() == m_InputBufferedRegion && input->GetOrigin() == m_InputOrigin &&
+         input->GetSpacing() == m_InputSpacing && input->GetDirection() == m_InputDirection;
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TWeightPrecisionType, typename TTransformPrecisionType>
+void
+PolarSamplingMap<TInputImage, TOutputImage, TWeightPrecisionType, TTransformPrecisionType>::Build(
+  const InputImageType * referenceImage)
+{
+  if (m_Transform.IsNull())
+  {
+    itkExceptionMacro("Transform not set");
+  }
+  if (referenceImage == nullptr)
+  {
+    itkExceptionMacro("Reference image not set");
+  }
+  if (m_FixedPointWeightBits > 0 && !IsFixedPointPixelType())
+  {
+    itkExceptionMacro("FixedPointWeightBits requires an integer input pixel type of at most 16 bits");
+  }
+  const bool fixedPoint = m_FixedPointWeightBits > 0;
+  if (fixedPoint && referenceImage->GetBufferedRegion().GetNumberOfPixels() >
+                      static_cast<SizeValueType>(std::numeric_limits<std::int32_t>::max()))
+  {
+    itkExceptionMacro("FixedPointWeightBits requires an input buffer of fewer than 2^31 pixels");
+  }
+
+  m_InputBufferedRegion = referenceImage->GetBufferedRegion();
+  m_InputOrigin = referenceImage->GetOrigin();
+  m_InputSpacing = referenceImage->GetSpacing();
+  m_InputDirection = referenceImage->GetDirection();
+
+  const RegionType    outputRegion(m_OutputStartIndex, m_Size);
+  const SizeValueType numberOfSamples = outputRegion.GetNumberOfPixels();
+  m_Samples.resize(fixedPoint ? 0 : numberOfSamples);
+  m_FixedPointSamples.resize(fixedPoint ? numberOfSamples : 0);
+
+  /* Continuous indices inside [start - 0.5, end + 0.5) are valid, as in InterpolateImageFunction::IsInsideBuffer. */
+  const typename InputImageType::IndexType startIndex = m_InputBufferedRegion.GetIndex();
+  const typename InputImageType::SizeType  bufferSize = m_InputBufferedRegion.GetSize();
+  const OffsetValueType *                  offsetTable = referenceImage->GetOffsetTable();
+
+  const TransformType * transform = m_Transform.GetPointer();
+  Sample *              samples = m_Samples.data();
+  FixedPointSample *    fixedPointSamples = m_FixedPointSamples.data();
+  const double          fixedPointOne = std::ldexp(1.0, static_cast<int>(m_FixedPointWeightBits));
+  const long            maximumFraction = std::numeric_limits<std::uint16_t>::max();
+
+  using ChunkRegionType = ImageRegion<1>;
+  ChunkRegionType chunks;
+  chunks.SetSize(0, numberOfSamples);
+
+  MultiThreaderBase::New()->template ParallelizeImageRegion<1>(
+    chunks,
+    [&](const ChunkRegionType & chunk) {
+      const SizeValueType first = chunk.GetIndex(0);
+      const SizeValueType last = first + chunk.GetSize(0);
+      for (SizeValueType i = first; i < last; ++i)
+      {
+        /* Output index of the i-th pixel of the output region, in buffer order. */
+        typename TransformType::InputPointType point;
+        IndexType                              outputIndex;
+        SizeValueType                          remainder = i;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          outputIndex[d] = m_OutputStartIndex[d] + static_cast<IndexValueType>(remainder % m_Size[d]);
+          remainder /= m_Size[d];
+        }
+        for (unsigned int r = 0; r < ImageDimension; ++r)
+        {
+          double value = m_OutputOrigin[r];
+          for (unsigned int c = 0; c < ImageDimension; ++c)
+          {
+            value += m_OutputDirection[r][c] * m_OutputSpacing[c] * outputIndex[c];
+          }
+          point[r] = value;
+        }
+
+        const auto inputIndex =
+          referenceImage->template TransformPhysicalPointToContinuousIndex<TTransformPrecisionType>(
+            transform->TransformPoint(point));
+
+        WeightType      fractions[ImageDimension]{};
+        OffsetValueType offset = 0;
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          const TTransformPrecisionType lower = startIndex[d] - 0.5;
+          const TTransformPrecisionType upper = lower + bufferSize[d];
+          if (!(inputIndex[d] >= lower && inputIndex[d] < upper))
+          {
+            offset = -1;
+            break;
+          }
+
+          /* Clamp the corners to the buffer like LinearInterpolateImageFunction. */
+          const IndexValueType lastIndex = startIndex[d] + static_cast<IndexValueType>(bufferSize[d]) - 1;
+          IndexValueType       base = Math::Floor<IndexValueType>(inputIndex[d]);
+          WeightType           fraction = static_cast<WeightType>(inputIndex[d] - base);
+          if (base < startIndex[d])
+          {
+            base = startIndex[d];
+            fraction = 0;
+          }
+          else if (base >= lastIndex)
+          {
+            base = lastIndex;
+            fraction = 0;
+            if (fixedPoint && lastIndex > startIndex[d])
+            {
+              /* The same value from the lower neighbor, so that the upper corner stays inside the buffer. */
+              base = lastIndex - 1;
+              fraction = 1;
+            }
+          }
+          offset += (base - startIndex[d]) * offsetTable[d];
+          fractions[d] = fraction;
+        }
+
+        if (!fixedPoint)
+        {
+          samples[i].BaseOffset = offset;
+          std::copy_n(fractions, ImageDimension, samples[i].Fraction);
+          continue;
+        }
+
+        /* Round the fractions to units of 2^-b. With b = 16 a fraction of one does not fit into 16 bits and is
+         * stored as 1 - 2^-16. */
+        FixedPointSample & sample = fixedPointSamples[i];
+        sample.BaseOffset = static_cast<std::int32_t>(offset);
+        for (unsigned int d = 0; d < ImageDimension; ++d)
+        {
+          sample.Fraction[d] =
+            static_cast<std::uint16_t>(std::min(std::lround(fractions[d] * fixedPointOne), maximumFraction));
+        }
+      }
+    },
+    nullptr);
+
+  m_BuildTime.Modified();
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TWeightPrecisionType, typename TTransformPrecisionType>
+void
+PolarSamplingMap<TInputImage, TOutputImage, TWeightPrecisionType, TTransformPrecisionType>::Apply(
+  const InputImageType * input,
+  OutputImageType *      output)
+{
+  if (input == nullptr || output == nullptr)
+  {
+    itkExceptionMacro("Input and output images must be set");
+  }
+  if (!this->IsUpToDate(input))
+  {
+    this->Build(input);
+  }
+
+  const RegionType outputRegion(m_OutputStartIndex, m_Size);
+  output->SetOrigin(m_OutputOrigin);
+  output->SetSpacing(m_OutputSpacing);
+  output->SetDirection(m_OutputDirection);
+  if (output->GetBufferedRegion() != outputRegion || output->GetBufferPointer() == nullptr)
+  {
+    output->SetRegions(outputRegion);
+    output->Allocate();
+  }
+
+  if (m_FixedPointWeightBits > 0)
+  {
+    this->ApplyFixedPoint(input, output);
+    output->Modified();
+    return;
+  }
+
+  const InputPixelType *  inputBuffer = input->GetBufferPointer();
+  OutputPixelType *       outputBuffer = output->GetBufferPointer();
+  const OffsetValueType * offsetTable = input->GetOffsetTable();
+  const Sample *          samples = m_Samples.data();
+
+  using ChunkRegionType = ImageRegion<1>;
+  ChunkRegionType chunks;
+  chunks.SetSize(0, m_Samples.size());
+
+  MultiThreaderBase::New()->template ParallelizeImageRegion<1>(
+    chunks,
+    [&](const ChunkRegionType & chunk) {
+      const SizeValueType first = chunk.GetIndex(0);
+      const SizeValueType last = first + chunk.GetSize(0);
+      for (SizeValueType i = first; i < last; ++i)
+      {
+        const Sample & sample = samples[i];
+        if (sample.BaseOffset < 0)
+        {
+          outputBuffer[i] = m_DefaultPixelValue;
+          continue;
+        }
+
+        /* Corners whose fraction is zero along a stepped dimension do not contribute and may lie outside the
+         * buffer, so they are skipped. */
+        const InputPixelType * base = inputBuffer + sample.BaseOffset;
+        RealType               value{};
+        for (unsigned int corner = 0; corner < NumberOfCorners; ++corner)
+        {
+          WeightType      weight = 1;
+          OffsetValueType offset = 0;
+          bool            contributes = true;
+          for (unsigned int d = 0; d < ImageDimension; ++d)
+          {
+            if (corner & (1u << d))
+            {
+              if (sample.Fraction[d] == 0)
+              {
+                contributes = false;
+                break;
+              }
+              weight *= sample.Fraction[d];
+              offset += offsetTable[d];
+            }
+            else
+            {
+              weight *= 1 - sample.Fraction[d];
+            }
+          }
+          if (contributes)
+          {
+            value += static_cast<RealType>(base[offset]) * weight;
+          }
+        }
+        outputBuffer[i] = PolarImageFilterHelpers::RoundPixelWithClamping<OutputPixelType>(value);
+      }
+    },
+    nullptr);
+
+  output->Modified();
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TWeightPrecisionType, typename TTransformPrecisionType>
+void
+PolarSamplingMap<TInputImage, TOutputImage, TWeightPrecisionType, TTransformPrecisionType>::ApplyFixedPoint(
+  const InputImageType * input,
+  OutputImageType *      output) const
+{
+  /* Build() rejects other pixel types. */
+  if constexpr (IsFixedPointPixelType())
+  {
+    /* Offsets of the corners from the base corner. Dimensions of a single pixel have no upper corner, their weight
+     * is zero and the base is read again instead. */
+    PolarTransformKernels::FixedPointGatherParameters<ImageDimension, OutputPixelType> parameters;
+    for (unsigned int corner = 0; corner < NumberOfCorners; ++corner)
+    {
+      for (unsigned int d = 0; d < ImageDimension; ++d)
+      {
+        if ((corner & (1u << d)) && m_InputBufferedRegion.GetSize(d) > 1)
+        {
+          parameters.CornerOffsets[corner] += static_cast<std::int32_t>(input->GetOffsetTable()[d]);
+        }
+      }
+    }
+    parameters.InputSize = m_InputBufferedRegion.GetNumberOfPixels();
+    parameters.Bits = m_FixedPointWeightBits;
+    parameters.DefaultValue = m_DefaultPixelValue;
+
+    const InputPixelType *   inputBuffer = input->GetBufferPointer();
+    OutputPixelType *        outputBuffer = output->GetBufferPointer();
+    const FixedPointSample * samples = m_FixedPointSamples.data();
+
+    using ChunkRegionType = ImageRegion<1>;
+    ChunkRegionType chunks;
+    chunks.SetSize(0, m_FixedPointSamples.size());
+
+    MultiThreaderBase::New()->template ParallelizeImageRegion<1>(
+      chunks,
+      [&](const ChunkRegionType & chunk) {
+        const SizeValueType first = chunk.GetIndex(0);
+        PolarTransformKernels::FixedPointGather(
+          samples, first, first + chunk.GetSize(0), inputBuffer, parameters, outputBuffer);
+      },
+      nullptr);
+  }
+}
+
+} // namespace itk
+
+#endif
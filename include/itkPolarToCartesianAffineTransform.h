@@ -0,0 +1,202 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarToCartesianAffineTransform_h
+#define itkPolarToCartesianAffineTransform_h
+
+#include "itkPolarToCartesianTransform.h"
+#include "itkCompositeTransform.h"
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+class AffineCartesianToPolarTransform;
+
+/** \class PolarToCartesianAffineTransform
+ *
+ * \brief PolarToCartesianTransform followed by an affine alignment, fused into one transform.
+ *
+ * Maps polar coordinates q to \f$ A\,p(q) + t \f$, where p is the mapping of
+ * PolarToCartesianTransform, A the Matrix and t the Offset. It equals a
+ * CompositeTransform of a PolarToCartesianTransform followed by an affine
+ * transform, but costs one virtual call per point instead of two, and the
+ * batch TransformPoints() apply the polar kernel and the matrix to a block of
+ * points in one pass, with the Center folded into the Offset.
+ * SetFromCompositeTransform() collapses such a CompositeTransform.
+ *
+ * Center, AngleOffset, ConstArcIncr, ReturnNaN, AngleEvaluation and
+ * UseLegacyConvention are those of the polar mapping, in the space before the
+ * affine alignment. The transform has no parameters.
+ *
+ * \sa AffineCartesianToPolarTransform
+ *
+ * \ingroup Transforms
+ * \ingroup PolarTransform
+ */
+template <typename TParametersValueType = double, // Data type for scalars (float or double)
+          unsigned int NDimensions = 3>           // Number of dimensions
+class ITK_TEMPLATE_EXPORT PolarToCartesianAffineTransform
+  : public PolarToCartesianTransform<TParametersValueType, NDimensions>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolarToCartesianAffineTransform);
+
+  /** Standard class type alias. */
+  using Self = PolarToCartesianAffineTransform;
+  using Superclass = PolarToCartesianTransform<TParametersValueType, NDimensions>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** New macro for creation of through the object factory.*/
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolarToCartesianAffineTransform);
+
+  /** Dimension of the domain space. */
+  static constexpr unsigned int SpaceDimension = NDimensions;
+
+  using ScalarType = typename Superclass::ScalarType;
+  using JacobianPositionType = typename Superclass::JacobianPositionType;
+  using InverseJacobianPositionType = typename Superclass::InverseJacobianPositionType;
+  using InputPointType = typename Superclass::InputPointType;
+  using OutputPointType = typename Superclass::OutputPointType;
+  using OutputVectorType = typename Superclass::OutputVectorType;
+
+  /** Type of the affine alignment. */
+  using MatrixType = Matrix<TParametersValueType, NDimensions, NDimensions>;
+  using OffsetType = OutputVectorType;
+
+  /** CompositeTransform that SetFromCompositeTransform() collapses. */
+  using CompositeTransformType = CompositeTransform<TParametersValueType, NDimensions>;
+
+  /** Inverse transform type alias. */
+  using InverseTransformType = AffineCartesianToPolarTransform<TParametersValueType, NDimensions>;
+  using InverseTransformBasePointer = typename Superclass::InverseTransformBasePointer;
+
+  /** Method to transform a point.
+   * Applies the polar mapping of PolarToCartesianTransform, and then the Matrix and the Offset.
+   */
+  OutputPointType
+  TransformPoint(const InputPointType & point) const override;
+
+  /** Method to transform a batch of points stored contiguously (array of structures).
+   *
+   * Passes blocks of points to the vectorized kernel of
+   * PolarToCartesianTransform and applies the affine mapping to them. The
+   * output may be the same buffer as the input.
+   */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
+  /** Method to transform a batch of points stored as a structure of arrays.
+   *
+   * inputComponents[d][i] is coordinate d of point i. Each output component
+   * may be the same buffer as the corresponding input component.
+   */
+  void
+  TransformPoints(const ScalarType * const * inputComponents,
+                  ScalarType * const *       outputComponents,
+                  SizeValueType              numberOfPoints) const override;
+
+  /** Compute the Jacobian of the transform with respect to the polar input point.
+   *
+   * It is the Matrix times the Jacobian of PolarToCartesianTransform.
+   */
+  void
+  ComputeJacobianWithRespectToPosition(const InputPointType & point, JacobianPositionType & jacobian) const override;
+
+  /** Compute the inverse of the Jacobian with respect to the polar input point.
+   *
+   * Throws if the Matrix is singular.
+   */
+  void
+  ComputeInverseJacobianWithRespectToPosition(const InputPointType &        point,
+                                              InverseJacobianPositionType & jacobian) const override;
+
+  using Superclass::ComputeJacobianWithRespectToPosition;
+  using Superclass::ComputeInverseJacobianWithRespectToPosition;
+
+  /** Fill an AffineCartesianToPolarTransform with the polar settings of this transform and the inverse of the
+   * affine mapping. Returns false if the Matrix is singular. */
+  bool
+  GetInverse(InverseTransformType * inverse) const;
+
+  /** Return an AffineCartesianToPolarTransform inverting this transform. */
+  InverseTransformBasePointer
+  GetInverseTransform() const override;
+
+  /** Compute a bounding box of the cartesian points that the polar box [inputMinimum,inputMaximum] maps to.
+   *
+   * The bounding box of PolarToCartesianTransform::ComputeOutputBoundingBox()
+   * is mapped by the affine alignment, so the bounds are not tight unless the
+   * Matrix maps the axes onto the axes.
+   */
+  void
+  ComputeOutputBoundingBox(const InputPointType & inputMinimum,
+                           const InputPointType & inputMaximum,
+                           OutputPointType &      outputMinimum,
+                           OutputPointType &      outputMaximum) const;
+
+  /** Take the settings from a CompositeTransform that applies a
+   * PolarToCartesianTransform and then one or more transforms derived from
+   * MatrixOffsetTransformBase, e.g. AffineTransform, Euler3DTransform or
+   * Similarity2DTransform, i.e. the PolarToCartesianTransform was added last.
+   * The affine transforms are multiplied into one.
+   *
+   * Returns false and leaves this transform unchanged if the composite has
+   * any other structure.
+   */
+  bool
+  SetFromCompositeTransform(const CompositeTransformType * composite);
+
+  /** Set/Get the matrix A of the affine alignment. Defaults to the identity. */
+  itkSetMacro(Matrix, MatrixType);
+  itkGetConstReferenceMacro(Matrix, MatrixType);
+
+  /** Set/Get the translation t of the affine alignment. Defaults to 0. */
+  itkSetMacro(Offset, OffsetType);
+  itkGetConstReferenceMacro(Offset, OffsetType);
+
+protected:
+  PolarToCartesianAffineTransform();
+  ~PolarToCartesianAffineTransform() override = default;
+
+  /** Print contents of a PolarToCartesianAffineTransform. */
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Kernel settings with the Center moved to the origin, and the Offset that includes the mapped Center. */
+  PolarTransformKernels::Parameters<ScalarType>
+  GetFusedKernelParameters(OffsetType & fusedOffset) const;
+
+private:
+  MatrixType m_Matrix;
+  OffsetType m_Offset;
+}; // class PolarToCartesianAffineTransform
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolarToCartesianAffineTransform.hxx"
+#endif
+
+#endif
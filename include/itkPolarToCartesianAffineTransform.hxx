@@ -0,0 +1,329 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarToCartesianAffineTransform_hxx
+#define itkPolarToCartesianAffineTransform_hxx
+
+#include "itkAffineCartesianToPolarTransform.h"
+#include "itkMatrixOffsetTransformBase.h"
+#include <algorithm>
+#include <typeinfo>
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::PolarToCartesianAffineTransform()
+{
+  m_Matrix.SetIdentity();
+  m_Offset.Fill(0.0);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Matrix: " << std::endl;
+  os << m_Matrix;
+  os << indent << "Offset: " << m_Offset << std::endl;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+typename PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::OutputPointType
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::TransformPoint(
+  const InputPointType & inputPoint) const
+{
+  return m_Matrix * Superclass::TransformPoint(inputPoint) + m_Offset;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  constexpr SizeValueType BlockSize = 256;
+
+  ScalarType alpha[BlockSize];
+  ScalarType radius[BlockSize];
+  ScalarType components[SpaceDimension][BlockSize];
+
+  OffsetType                                          offset;
+  const PolarTransformKernels::Parameters<ScalarType> parameters = this->GetFusedKernelParameters(offset);
+
+  PolarTransformTally tally;
+  auto                start = PolarTransformTally::Now();
+
+  for (SizeValueType begin = 0; begin < numberOfPoints; begin += BlockSize)
+  {
+    const SizeValueType count = std::min(BlockSize, numberOfPoints - begin);
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      alpha[i] = inputPoints[begin + i][0];
+      radius[i] = inputPoints[begin + i][1];
+      for (unsigned int d = 2; d < SpaceDimension; ++d)
+      {
+        components[d][i] = inputPoints[begin + i][d];
+      }
+    }
+
+    PolarTransformKernels::PolarToCartesian(alpha, radius, components[0], components[1], count, parameters);
+    tally.CountPolarInputs(alpha, radius, count, this->GetConstArcIncr());
+    tally.CountNaN(components[0], components[1], count);
+
+    // The block is read completely before it is written, so the output may be the input.
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      OutputPointType & outputPoint = outputPoints[begin + i];
+      for (unsigned int r = 0; r < SpaceDimension; ++r)
+      {
+        ScalarType value = offset[r];
+        for (unsigned int c = 0; c < SpaceDimension; ++c)
+        {
+          value += m_Matrix[r][c] * components[c][i];
+        }
+        outputPoint[r] = value;
+      }
+    }
+  }
+
+  tally.AddTransformTime(start);
+  this->AddEvaluationTally(tally);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const ScalarType * const * inputComponents,
+  ScalarType * const *       outputComponents,
+  SizeValueType              numberOfPoints) const
+{
+  constexpr SizeValueType BlockSize = 256;
+
+  ScalarType components[SpaceDimension][BlockSize];
+
+  OffsetType                                          offset;
+  const PolarTransformKernels::Parameters<ScalarType> parameters = this->GetFusedKernelParameters(offset);
+
+  PolarTransformTally tally;
+  auto                start = PolarTransformTally::Now();
+
+  for (SizeValueType begin = 0; begin < numberOfPoints; begin += BlockSize)
+  {
+    const SizeValueType count = std::min(BlockSize, numberOfPoints - begin);
+    PolarTransformKernels::PolarToCartesian(
+      inputComponents[0] + begin, inputComponents[1] + begin, components[0], components[1], count, parameters);
+    tally.CountPolarInputs(inputComponents[0] + begin, inputComponents[1] + begin, count, this->GetConstArcIncr());
+    tally.CountNaN(components[0], components[1], count);
+    for (unsigned int d = 2; d < SpaceDimension; ++d)
+    {
+      std::copy_n(inputComponents[d] + begin, count, components[d]);
+    }
+
+    for (unsigned int r = 0; r < SpaceDimension; ++r)
+    {
+      ScalarType * component = outputComponents[r] + begin;
+      std::fill_n(component, count, offset[r]);
+      for (unsigned int c = 0; c < SpaceDimension; ++c)
+      {
+        const ScalarType coefficient = m_Matrix[r][c];
+        for (SizeValueType i = 0; i < count; ++i)
+        {
+          component[i] += coefficient * components[c][i];
+        }
+      }
+    }
+  }
+
+  tally.AddTransformTime(start);
+  this->AddEvaluationTally(tally);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::ComputeJacobianWithRespectToPosition(
+  const InputPointType & point,
+  JacobianPositionType & jacobian) const
+{
+  JacobianPositionType polarJacobian;
+  Superclass::ComputeJacobianWithRespectToPosition(point, polarJacobian);
+  jacobian = m_Matrix.GetVnlMatrix() * polarJacobian;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::ComputeInverseJacobianWithRespectToPosition(
+  const InputPointType &        point,
+  InverseJacobianPositionType & jacobian) const
+{
+  InverseJacobianPositionType polarJacobian;
+  Superclass::ComputeInverseJacobianWithRespectToPosition(point, polarJacobian);
+  jacobian = polarJacobian * m_Matrix.GetInverse();
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::GetInverse(InverseTransformType * inverse) const
+{
+  if (!inverse)
+  {
+    return false;
+  }
+
+  MatrixType inverseMatrix;
+  try
+  {
+    inverseMatrix = m_Matrix.GetInverse();
+  }
+  catch (const ExceptionObject &)
+  {
+    return false;
+  }
+
+  Superclass::GetInverse(inverse);
+  inverse->SetMatrix(inverseMatrix);
+  inverse->SetOffset(-(inverseMatrix * m_Offset));
+  return true;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::GetInverseTransform() const
+  -> InverseTransformBasePointer
+{
+  const auto inverse = InverseTransformType::New();
+  return this->GetInverse(inverse) ? inverse.GetPointer() : nullptr;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::ComputeOutputBoundingBox(
+  const InputPointType & inputMinimum,
+  const InputPointType & inputMaximum,
+  OutputPointType &      outputMinimum,
+  OutputPointType &      outputMaximum) const
+{
+  OutputPointType polarMinimum;
+  OutputPointType polarMaximum;
+  Superclass::ComputeOutputBoundingBox(inputMinimum, inputMaximum, polarMinimum, polarMaximum);
+
+  outputMinimum.Fill(NumericTraits<ScalarType>::max());
+  outputMaximum.Fill(NumericTraits<ScalarType>::NonpositiveMin());
+  for (unsigned int corner = 0; corner < (1u << SpaceDimension); ++corner)
+  {
+    OutputPointType point;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      point[d] = ((corner >> d) & 1) ? polarMaximum[d] : polarMinimum[d];
+    }
+    const OutputPointType mapped = m_Matrix * point + m_Offset;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      outputMinimum[d] = std::min(outputMinimum[d], mapped[d]);
+      outputMaximum[d] = std::max(outputMaximum[d], mapped[d]);
+    }
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::SetFromCompositeTransform(
+  const CompositeTransformType * composite)
+{
+  using AffineType = MatrixOffsetTransformBase<TParametersValueType, NDimensions, NDimensions>;
+
+  if (composite == nullptr || composite->GetNumberOfTransforms() == 0)
+  {
+    return false;
+  }
+
+  // The queue is applied from the back to the front, so the polar transform is at the back.
+  const SizeValueType numberOfAffines = composite->GetNumberOfTransforms() - 1;
+  const auto *        polar = composite->GetNthTransformConstPointer(numberOfAffines);
+  if (polar == nullptr || typeid(*polar) != typeid(Superclass))
+  {
+    return false;
+  }
+
+  MatrixType matrix;
+  matrix.SetIdentity();
+  OffsetType offset;
+  offset.Fill(0.0);
+  for (SizeValueType n = numberOfAffines; n > 0; --n)
+  {
+    const auto * affine = dynamic_cast<const AffineType *>(composite->GetNthTransformConstPointer(n - 1));
+    if (affine == nullptr)
+    {
+      return false;
+    }
+    matrix = affine->GetMatrix() * matrix;
+    offset = affine->GetMatrix() * offset + affine->GetOffset();
+  }
+
+  const auto * polarTransform = static_cast<const Superclass *>(polar);
+  this->SetCenter(polarTransform->GetCenter());
+  this->SetAngleOffset(polarTransform->GetAngleOffset());
+  this->SetConstArcIncr(polarTransform->GetConstArcIncr());
+  this->SetReturnNaN(polarTransform->GetReturnNaN());
+  this->SetAngleEvaluation(polarTransform->GetAngleEvaluation());
+  this->SetUseLegacyConvention(polarTransform->GetUseLegacyConvention());
+  this->SetMatrix(matrix);
+  this->SetOffset(offset);
+  return true;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+PolarToCartesianAffineTransform<TParametersValueType, NDimensions>::GetFusedKernelParameters(
+  OffsetType & fusedOffset) const -> PolarTransformKernels::Parameters<ScalarType>
+{
+  // A (c + p) + t = A p + (A c + t), with the center c zero beyond the first two dimensions unless
+  // UseLegacyConvention is On
+  PolarTransformKernels::Parameters<ScalarType> parameters = this->GetKernelParameters();
+  OffsetType                                    center;
+  center.Fill(0.0);
+  center[0] = parameters.CenterX;
+  center[1] = parameters.CenterY;
+  if (this->GetUseLegacyConvention())
+  {
+    for (unsigned int d = 2; d < SpaceDimension; ++d)
+    {
+      center[d] = this->GetCenter()[d];
+    }
+  }
+  fusedOffset = m_Matrix * center + m_Offset;
+  parameters.CenterX = 0.0;
+  parameters.CenterY = 0.0;
+  return parameters;
+}
+
+} // namespace itk
+
+#endif
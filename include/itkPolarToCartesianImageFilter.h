@@ -0,0 +1,324 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarToCartesianImageFilter_h
+#define itkPolarToCartesianImageFilter_h
+
+#include "itkCartesianToPolarTransform.h"
+#include "itkImageToImageFilter.h"
+#include "itkInterpolateImageFunction.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkPolarTransformEnums.h"
+#include "itkPolarTransformInstrumentation.h"
+#include <vector>
+
+namespace itk
+{
+
+/** \class PolarToCartesianImageFilter
+ *
+ * \brief Resample a polar image <alpha,radius> onto a regular cartesian grid.
+ *
+ * The filter produces the same output as a ResampleImageFilter driven by a
+ * CartesianToPolarTransform with the same Center, AngleOffset and
+ * ConstArcIncr settings, but it does not evaluate the transform through a
+ * virtual call for every output pixel. Cartesian coordinates advance by a
+ * constant step along every output scanline, and the physical point to index
+ * matrix of the polar input is folded into a per-line base and two per-axis
+ * directions, so every output pixel costs one sqrt, one atan2 and two
+ * multiply-adds per dimension plus the interpolation. With AngleEvaluation set
+ * to Approximate, the radius and angle of a whole scanline are computed at
+ * once with the vectorized PolarTransformKernels instead.
+ *
+ * The angle axis is periodic: a sample whose angle falls outside the input
+ * buffer is retried one period (2*pi, or 2*pi*r when ConstArcIncr is On)
+ * below and above before the DefaultPixelValue is used, so polar inputs
+ * covering [-pi,pi) work as well as those covering [0,2*pi).
+ *
+ * The filter supports streaming: it requests only the bounding region of the
+ * polar points that the requested output region maps to, see
+ * CartesianToPolarTransform::ComputeOutputBoundingBox(), together with the
+ * regions of its periodic copies that overlap the input.
+ *
+ * For volumes and time series whose first two dimensions are independent of
+ * the others, UseInPlaneMap computes the polar input position of every pixel
+ * of one output slice once and reuses it for all slices.
+ *
+ * With LogPolar On the second input axis is the natural logarithm of the
+ * radius, matching a ResampleImageFilter driven by a
+ * CartesianToLogPolarTransform.
+ *
+ * The output grid is defined by Size, OutputStartIndex, OutputOrigin,
+ * OutputSpacing and OutputDirection. Dimensions other than the first two are
+ * left unchanged. Only scalar pixel types are supported.
+ *
+ * \sa CartesianToPolarTransform
+ * \sa CartesianToLogPolarTransform
+ * \sa CartesianToPolarImageFilter
+ *
+ * \ingroup GeometricTransform
+ * \ingroup PolarTransform
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage, typename TInterpolatorPrecisionType = double>
+class ITK_TEMPLATE_EXPORT PolarToCartesianImageFilter : public ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PolarToCartesianImageFilter);
+
+  /** Standard class type alias. */
+  using Self = PolarToCartesianImageFilter;
+  using Superclass = ImageToImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkOverrideGetNameOfClassMacro(PolarToCartesianImageFilter);
+
+  /** Image related type alias. */
+  using InputImageType = TInputImage;
+  using OutputImageType = TOutputImage;
+  using InputImagePointer = typename InputImageType::Pointer;
+  using InputImageConstPointer = typename InputImageType::ConstPointer;
+  using InputImageRegionType = typename InputImageType::RegionType;
+  using OutputImagePointer = typename OutputImageType::Pointer;
+  using OutputImageRegionType = typename OutputImageType::RegionType;
+  using PixelType = typename OutputImageType::PixelType;
+
+  /** Number of dimensions. */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+  static_assert(ImageDimension >= 2, "Dimension must be at least 2.");
+  static_assert(TInputImage::ImageDimension == ImageDimension, "Input and output dimensions must agree.");
+
+  /** Interpolator type alias. */
+  using InterpolatorType = InterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+  using InterpolatorPointerType = typename InterpolatorType::Pointer;
+  using InterpolatorOutputType = typename InterpolatorType::OutputType;
+  using DefaultInterpolatorType = LinearInterpolateImageFunction<InputImageType, TInterpolatorPrecisionType>;
+  using ContinuousIndexType = typename InterpolatorType::ContinuousIndexType;
+
+  /** Output grid type alias. */
+  using SizeType = typename OutputImageType::SizeType;
+  using IndexType = typename OutputImageType::IndexType;
+  using SpacingType = typename OutputImageType::SpacingType;
+  using OriginPointType = typename OutputImageType::PointType;
+  using DirectionType = typename OutputImageType::DirectionType;
+
+  /** Scalar type used for the polar mapping. */
+  using ScalarType = TInterpolatorPrecisionType;
+
+  /** Point type of the cartesian output space. */
+  using PointType = typename OutputImageType::PointType;
+
+  /** Transform mapping the cartesian output grid to the polar input, used for the input requested region. */
+  using CartesianToPolarTransformType = CartesianToPolarTransform<ScalarType, ImageDimension>;
+
+  using AngleEvaluationEnum = PolarTransformEnums::AngleEvaluation;
+
+  /** Set/Get the interpolator. Defaults to LinearInterpolateImageFunction. */
+  itkSetObjectMacro(Interpolator, InterpolatorType);
+  itkGetModifiableObjectMacro(Interpolator, InterpolatorType);
+
+  /** Set/Get the pixel value assigned to output pixels that map outside the input. */
+  itkSetMacro(DefaultPixelValue, PixelType);
+  itkGetConstReferenceMacro(DefaultPixelValue, PixelType);
+
+  /** Set/Get the size of the cartesian output image. */
+  itkSetMacro(Size, SizeType);
+  itkGetConstReferenceMacro(Size, SizeType);
+
+  /** Set/Get the start index of the cartesian output image. */
+  itkSetMacro(OutputStartIndex, IndexType);
+  itkGetConstReferenceMacro(OutputStartIndex, IndexType);
+
+  /** Set/Get the spacing of the cartesian output image. */
+  itkSetMacro(OutputSpacing, SpacingType);
+  itkGetConstReferenceMacro(OutputSpacing, SpacingType);
+
+  /** Set/Get the origin of the cartesian output image. */
+  itkSetMacro(OutputOrigin, OriginPointType);
+  itkGetConstReferenceMacro(OutputOrigin, OriginPointType);
+
+  /** Set/Get the direction of the cartesian output image. */
+  itkSetMacro(OutputDirection, DirectionType);
+  itkGetConstReferenceMacro(OutputDirection, DirectionType);
+
+  /** Set/Get the location of the center of the polar coordinate system in the output space. */
+  itkSetMacro(Center, PointType);
+  itkGetConstReferenceMacro(Center, PointType);
+
+  /** Set/Get an angular offset for the polar coordinate system.
+   *
+   * Defaults to 0.0
+   */
+  itkSetMacro(AngleOffset, ScalarType);
+  itkGetConstMacro(AngleOffset, ScalarType);
+
+  /** Enable/Disable to use constant arc increment instead of constant angular increment.
+   *
+   * Defaults to Off
+   */
+  itkSetMacro(ConstArcIncr, bool);
+  itkGetConstMacro(ConstArcIncr, bool);
+  itkBooleanMacro(ConstArcIncr);
+
+  /** Enable/Disable log-polar input, where the second input axis is log(radius) instead of radius.
+   *
+   * Defaults to Off
+   */
+  itkSetMacro(LogPolar, bool);
+  itkGetConstMacro(LogPolar, bool);
+  itkBooleanMacro(LogPolar);
+
+  /** Select std::atan2() (Exact) or the polynomial approximation of PolarTransformKernels (Approximate) for the
+   * angle of every output pixel. See PolarTransformEnums::AngleEvaluation for the error bounds.
+   *
+   * Defaults to Exact
+   */
+  itkSetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+  itkGetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+
+  /** Enable/Disable reusing the in-plane mapping for all slices of a volume.
+   *
+   * The polar coordinates depend on the first two dimensions only. When the
+   * input and output directions do not mix them with the others, the filter
+   * computes the in-plane input index of every pixel of one slice of the
+   * requested output region once per update, and the threads resampling the
+   * slices and time points share it read-only. The sqrt and atan2 are then
+   * evaluated once per in-plane pixel instead of once per voxel. Ignored for
+   * 2-D images and for directions coupling the first two dimensions with the
+   * others.
+   *
+   * Defaults to Off
+   */
+  itkSetMacro(UseInPlaneMap, bool);
+  itkGetConstMacro(UseInPlaneMap, bool);
+  itkBooleanMacro(UseInPlaneMap);
+
+  /** Counts and times of the resampling since construction or the last ResetEvaluationStatistics(): the output
+   * pixels, those mapping outside the input or to the center, and the time spent in the polar mapping and in the
+   * interpolation. They are only collected when the module is configured with PolarTransform_USE_INSTRUMENTATION,
+   * see PolarTransformStatistics. */
+  PolarTransformStatistics
+  GetEvaluationStatistics() const
+  {
+    return m_EvaluationCounters.GetStatistics();
+  }
+
+  void
+  ResetEvaluationStatistics()
+  {
+    m_EvaluationCounters.Reset();
+  }
+
+protected:
+  PolarToCartesianImageFilter();
+  ~PolarToCartesianImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** The cartesian output grid is not derived from the input. */
+  void
+  GenerateOutputInformation() override;
+
+  /** Request the bounding region of the polar points that the requested output region maps to, padded by the
+   * radius of the interpolator. */
+  void
+  GenerateInputRequestedRegion() override;
+
+  /** Connect the interpolator and build the in-plane map if it is used. */
+  void
+  BeforeThreadedGenerateData() override;
+
+  void
+  DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+  /** Release the reference to the input held by the interpolator and the in-plane map. */
+  void
+  AfterThreadedGenerateData() override;
+
+  /** The input and output grids are unrelated, skip the superclass check. */
+  void
+  VerifyInputInformation() ITKv5_CONST override
+  {}
+
+  /** Whether the input and output directions keep the first two dimensions apart from the others, so that every
+   * slice has the same in-plane mapping. */
+  bool
+  IsInPlaneSeparable() const;
+
+private:
+  /** Polar coordinates <alpha,radius> of the cartesian points (x,y) + i * (stepX,stepY) relative to the center, for
+   * i below the length of lineAlpha. */
+  void
+  ComputeLinePolarCoordinates(ScalarType                x,
+                              ScalarType                y,
+                              const ScalarType          stepX,
+                              const ScalarType          stepY,
+                              std::vector<ScalarType> & lineAlpha,
+                              std::vector<ScalarType> & lineRadius) const;
+
+  /** Retry a sample outside the input buffer one period below and above along the angle axis. Returns whether
+   * inputIndex, updated to the sample found, lies inside the buffer. */
+  bool
+  FindPeriodicSample(ContinuousIndexType &       inputIndex,
+                     const ContinuousIndexType & alphaDirection,
+                     const ScalarType            period) const;
+
+  /** Compute m_InPlaneMap for the first two dimensions of the requested output region. */
+  void
+  BuildInPlaneMap();
+
+  /** Resample the slices of a region through m_InPlaneMap. */
+  void
+  GenerateDataWithInPlaneMap(const OutputImageRegionType & outputRegionForThread);
+
+  InterpolatorPointerType m_Interpolator;
+  PixelType               m_DefaultPixelValue{};
+
+  SizeType        m_Size;
+  IndexType       m_OutputStartIndex;
+  SpacingType     m_OutputSpacing;
+  OriginPointType m_OutputOrigin;
+  DirectionType   m_OutputDirection;
+
+  PointType           m_Center;
+  ScalarType          m_AngleOffset = 0;
+  bool                m_ConstArcIncr = false;
+  bool                m_LogPolar = false;
+  AngleEvaluationEnum m_AngleEvaluation = AngleEvaluationEnum::Exact;
+  bool                m_UseInPlaneMap = false;
+
+  /** Continuous input index in the first two dimensions of every pixel of one slice of m_InPlaneMapRegion,
+   * interleaved. The first value is NaN for pixels mapping outside the input. */
+  std::vector<ScalarType> m_InPlaneMap;
+  OutputImageRegionType   m_InPlaneMapRegion;
+
+  PolarTransformCounters m_EvaluationCounters;
+}; // class PolarToCartesianImageFilter
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPolarToCartesianImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,608 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarToCartesianImageFilter_hxx
+#define itkPolarToCartesianImageFilter_hxx
+
+#include "itkImageScanlineIterator.h"
+#include "itkMath.h"
+#include "itkNumericTraits.h"
+#include "itkPolarImageFilterHelpers.h"
+#include "itkPolarTransformKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace itk
+{
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::PolarToCartesianImageFilter()
+  : m_Interpolator(DefaultInterpolatorType::New())
+{
+  m_Size.Fill(0);
+  m_OutputStartIndex.Fill(0);
+  m_OutputSpacing.Fill(1.0);
+  m_OutputOrigin.Fill(0.0);
+  m_OutputDirection.SetIdentity();
+  m_Center.Fill(0.0);
+
+  this->DynamicMultiThreadingOn();
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::PrintSelf(std::ostream & os,
+                                                                                            Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Interpolator);
+  os << indent << "DefaultPixelValue: " << static_cast<typename NumericTraits<PixelType>::PrintType>(m_DefaultPixelValue)
+     << std::endl;
+  os << indent << "Size: " << m_Size << std::endl;
+  os << indent << "OutputStartIndex: " << m_OutputStartIndex << std::endl;
+  os << indent << "OutputSpacing: " << m_OutputSpacing << std::endl;
+  os << indent << "OutputOrigin: " << m_OutputOrigin << std::endl;
+  os << indent << "OutputDirection: " << m_OutputDirection << std::endl;
+  os << indent << "Center: " << m_Center << std::endl;
+  os << indent << "AngleOffset: " << m_AngleOffset << std::endl;
+  os << indent << "ConstArcIncr: " << (m_ConstArcIncr ? "On" : "Off") << std::endl;
+  os << indent << "LogPolar: " << (m_LogPolar ? "On" : "Off") << std::endl;
+  os << indent << "AngleEvaluation: " << m_AngleEvaluation << std::endl;
+  os << indent << "UseInPlaneMap: " << (m_UseInPlaneMap ? "On" : "Off") << std::endl;
+  if (PolarTransformCounters::Enabled)
+  {
+    os << indent << "EvaluationStatistics: " << m_EvaluationCounters.GetStatistics() << std::endl;
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  OutputImageType * outputPtr = this->GetOutput();
+  if (!outputPtr)
+  {
+    return;
+  }
+
+  const OutputImageRegionType outputLargestPossibleRegion(m_OutputStartIndex, m_Size);
+  outputPtr->SetLargestPossibleRegion(outputLargestPossibleRegion);
+  outputPtr->SetSpacing(m_OutputSpacing);
+  outputPtr->SetOrigin(m_OutputOrigin);
+  outputPtr->SetDirection(m_OutputDirection);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (!this->GetInput())
+  {
+    return;
+  }
+
+  auto * inputPtr = const_cast<InputImageType *>(this->GetInput());
+
+  const OutputImageType *       outputPtr = this->GetOutput();
+  const OutputImageRegionType & outputRegion = outputPtr->GetRequestedRegion();
+  if (!m_Interpolator || outputRegion.GetNumberOfPixels() == 0)
+  {
+    inputPtr->SetRequestedRegionToLargestPossibleRegion();
+    return;
+  }
+
+  // Cartesian bounding box of the corners of the requested output region.
+  typename CartesianToPolarTransformType::InputPointType cartesianMinimum;
+  typename CartesianToPolarTransformType::InputPointType cartesianMaximum;
+  cartesianMinimum.Fill(NumericTraits<ScalarType>::max());
+  cartesianMaximum.Fill(NumericTraits<ScalarType>::NonpositiveMin());
+  for (unsigned int corner = 0; corner < (1u << ImageDimension); ++corner)
+  {
+    IndexType index = outputRegion.GetIndex();
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if ((corner >> d) & 1)
+      {
+        index[d] = outputRegion.GetUpperIndex()[d];
+      }
+    }
+    PointType point;
+    outputPtr->TransformIndexToPhysicalPoint(index, point);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      cartesianMinimum[d] = std::min<ScalarType>(cartesianMinimum[d], point[d]);
+      cartesianMaximum[d] = std::max<ScalarType>(cartesianMaximum[d], point[d]);
+    }
+  }
+
+  typename CartesianToPolarTransformType::InputPointType center;
+  center.CastFrom(m_Center);
+  const auto transform = CartesianToPolarTransformType::New();
+  transform->SetCenter(center);
+  transform->SetAngleOffset(m_AngleOffset);
+  transform->SetConstArcIncr(m_ConstArcIncr);
+
+  typename CartesianToPolarTransformType::OutputPointType polarMinimum;
+  typename CartesianToPolarTransformType::OutputPointType polarMaximum;
+  transform->ComputeOutputBoundingBox(cartesianMinimum, cartesianMaximum, polarMinimum, polarMaximum);
+
+  // Samples outside the input are retried one period below and above, so request the copies of the box
+  // shifted by a period as well. With ConstArcIncr the period 2*pi*r depends on the radius.
+  const ScalarType periodMinimum = m_ConstArcIncr ? ScalarType(Math::twopi) * polarMinimum[1] : Math::twopi;
+  const ScalarType periodMaximum = m_ConstArcIncr ? ScalarType(Math::twopi) * polarMaximum[1] : Math::twopi;
+  const ScalarType shiftMinimum[] = { 0.0, -periodMaximum, periodMinimum };
+  const ScalarType shiftMaximum[] = { 0.0, -periodMinimum, periodMaximum };
+
+  // The radius bounds are >= 0. Keep log(0) finite, the bounds are multiplied by the direction matrix.
+  if (m_LogPolar)
+  {
+    polarMinimum[1] = std::log(std::max(polarMinimum[1], NumericTraits<ScalarType>::min()));
+    polarMaximum[1] = std::log(std::max(polarMaximum[1], NumericTraits<ScalarType>::min()));
+  }
+
+  const auto           radius = m_Interpolator->GetRadius();
+  InputImageRegionType inputRegion;
+  bool                 overlap = false;
+  for (unsigned int s = 0; s < 3; ++s)
+  {
+    typename InputImageType::PointType minimum;
+    typename InputImageType::PointType maximum;
+    minimum.CastFrom(polarMinimum);
+    maximum.CastFrom(polarMaximum);
+    minimum[0] += shiftMinimum[s];
+    maximum[0] += shiftMaximum[s];
+
+    InputImageRegionType region;
+    if (!PolarImageFilterHelpers::ComputeInputRegion<ScalarType>(inputPtr, minimum, maximum, radius, region))
+    {
+      continue;
+    }
+    if (!overlap)
+    {
+      inputRegion = region;
+      overlap = true;
+      continue;
+    }
+
+    // bounding region of both
+    for (unsigned int k = 0; k < ImageDimension; ++k)
+    {
+      const IndexValueType first = std::min(inputRegion.GetIndex(k), region.GetIndex(k));
+      const IndexValueType last = std::max(inputRegion.GetUpperIndex()[k], region.GetUpperIndex()[k]);
+      inputRegion.SetIndex(k, first);
+      inputRegion.SetSize(k, static_cast<SizeValueType>(last - first + 1));
+    }
+  }
+
+  if (!overlap)
+  {
+    // No output pixel maps into the input. The interpolator never samples this single pixel.
+    typename InputImageRegionType::SizeType size;
+    size.Fill(1);
+    inputRegion = InputImageRegionType(inputPtr->GetLargestPossibleRegion().GetIndex(), size);
+  }
+  inputPtr->SetRequestedRegion(inputRegion);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::BeforeThreadedGenerateData()
+{
+  if (!m_Interpolator)
+  {
+    itkExceptionMacro(<< "Interpolator not set");
+  }
+  m_Interpolator->SetInputImage(this->GetInput());
+
+  m_InPlaneMap.clear();
+  if (m_UseInPlaneMap && ImageDimension > 2 && this->IsInPlaneSeparable())
+  {
+    this->BuildInPlaneMap();
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::DynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  if (outputRegionForThread.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+  if (!m_InPlaneMap.empty())
+  {
+    this->GenerateDataWithInPlaneMap(outputRegionForThread);
+    return;
+  }
+
+  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType *      outputPtr = this->GetOutput();
+
+  // The continuous index of a polar point p in the input is M * (p - origin),
+  // with p = (alpha, r, x_2, ...), or p = (alpha, log(r), x_2, ...) when LogPolar is On.
+  // Columns 0 and 1 of M are the alpha and radius directions.
+  const auto & matrix = inputPtr->GetPhysicalPointToIndexMatrix();
+  const auto & inputOrigin = inputPtr->GetOrigin();
+
+  // Cartesian output points advance by a constant step along a scanline.
+  const auto & indexToPoint = outputPtr->GetIndexToPhysicalPoint();
+
+  ContinuousIndexType alphaDirection;
+  ContinuousIndexType radiusDirection;
+  ContinuousIndexType passThroughStep;
+  for (unsigned int k = 0; k < ImageDimension; ++k)
+  {
+    alphaDirection[k] = matrix[k][0];
+    radiusDirection[k] = matrix[k][1];
+    passThroughStep[k] = 0.0;
+    for (unsigned int d = 2; d < ImageDimension; ++d)
+    {
+      passThroughStep[k] += matrix[k][d] * indexToPoint[d][0];
+    }
+  }
+  const ScalarType stepX = indexToPoint[0][0];
+  const ScalarType stepY = indexToPoint[1][0];
+
+  // Polar coordinates <alpha,radius> of the current scanline.
+  const SizeValueType     lineLength = outputRegionForThread.GetSize(0);
+  std::vector<ScalarType> lineAlpha(lineLength);
+  std::vector<ScalarType> lineRadius(lineLength);
+
+  ImageScanlineIterator<OutputImageType> outIt(outputPtr, outputRegionForThread);
+
+  PolarTransformTally tally;
+
+  while (!outIt.IsAtEnd())
+  {
+    auto      start = PolarTransformTally::Now();
+    PointType linePoint;
+    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), linePoint);
+
+    // Contribution of the pass-through dimensions at the start of the line.
+    ContinuousIndexType passThroughIndex;
+    for (unsigned int k = 0; k < ImageDimension; ++k)
+    {
+      passThroughIndex[k] = -(matrix[k][0] * inputOrigin[0] + matrix[k][1] * inputOrigin[1]);
+      for (unsigned int d = 2; d < ImageDimension; ++d)
+      {
+        passThroughIndex[k] += matrix[k][d] * (linePoint[d] - inputOrigin[d]);
+      }
+    }
+
+    this->ComputeLinePolarCoordinates(
+      linePoint[0] - m_Center[0], linePoint[1] - m_Center[1], stepX, stepY, lineAlpha, lineRadius);
+    tally.AddTransformTime(start);
+
+    for (SizeValueType i = 0; !outIt.IsAtEndOfLine(); ++i)
+    {
+      const ScalarType alpha = lineAlpha[i];
+      const ScalarType radius = lineRadius[i];
+      const ScalarType period = m_ConstArcIncr ? ScalarType(Math::twopi) * radius : ScalarType(Math::twopi);
+      const ScalarType rho = m_LogPolar ? std::log(radius) : radius;
+
+      ContinuousIndexType inputIndex;
+      for (unsigned int k = 0; k < ImageDimension; ++k)
+      {
+        inputIndex[k] = passThroughIndex[k] + alpha * alphaDirection[k] + rho * radiusDirection[k];
+      }
+
+      const bool inside = this->FindPeriodicSample(inputIndex, alphaDirection, period);
+      tally.CountSample(inside);
+      if (radius == 0.0)
+      {
+        tally.CountDegenerateCenter(1);
+      }
+      if (inside)
+      {
+        outIt.Set(PolarImageFilterHelpers::CastPixelWithClamping<PixelType>(
+          m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+      }
+      else
+      {
+        outIt.Set(m_DefaultPixelValue);
+      }
+
+      for (unsigned int k = 0; k < ImageDimension; ++k)
+      {
+        passThroughIndex[k] += passThroughStep[k];
+      }
+
+      ++outIt;
+    }
+    tally.AddInterpolationTime(start);
+    outIt.NextLine();
+  }
+
+  m_EvaluationCounters.Add(tally);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::AfterThreadedGenerateData()
+{
+  m_Interpolator->SetInputImage(nullptr);
+  std::vector<ScalarType>().swap(m_InPlaneMap);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::ComputeLinePolarCoordinates(
+  ScalarType                x,
+  ScalarType                y,
+  const ScalarType          stepX,
+  const ScalarType          stepY,
+  std::vector<ScalarType> & lineAlpha,
+  std::vector<ScalarType> & lineRadius) const
+{
+  const auto lineLength = static_cast<SizeValueType>(lineAlpha.size());
+
+  // Cartesian coordinates relative to the center, converted in place.
+  for (SizeValueType i = 0; i < lineLength; ++i)
+  {
+    lineAlpha[i] = x;
+    lineRadius[i] = y;
+    x += stepX;
+    y += stepY;
+  }
+
+  if (m_AngleEvaluation == AngleEvaluationEnum::Approximate)
+  {
+    PolarTransformKernels::Parameters<ScalarType> kernelParameters;
+    kernelParameters.AngleOffset = m_AngleOffset;
+    kernelParameters.ConstArcIncr = m_ConstArcIncr;
+    PolarTransformKernels::CartesianToPolar(
+      lineAlpha.data(), lineRadius.data(), lineAlpha.data(), lineRadius.data(), lineLength, kernelParameters);
+    return;
+  }
+
+  for (SizeValueType i = 0; i < lineLength; ++i)
+  {
+    const ScalarType dx = lineAlpha[i];
+    const ScalarType dy = lineRadius[i];
+    const ScalarType radius = std::sqrt(dx * dx + dy * dy); // r= sqrt(x^2 + y^2)
+    ScalarType       alpha = std::atan2(dy, dx);            // alpha in (-pi,pi]
+    if (alpha < 0.0)
+    {
+      alpha += Math::twopi;
+    }
+    if (m_AngleOffset != 0.0)
+    {
+      alpha -= m_AngleOffset;
+      alpha -= Math::twopi * std::floor(alpha / Math::twopi);
+    }
+    if (m_ConstArcIncr)
+    {
+      alpha *= radius; // arc= r*alpha
+    }
+    lineAlpha[i] = alpha;
+    lineRadius[i] = radius;
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+bool
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::FindPeriodicSample(
+  ContinuousIndexType &       inputIndex,
+  const ContinuousIndexType & alphaDirection,
+  const ScalarType            period) const
+{
+  if (m_Interpolator->IsInsideBuffer(inputIndex))
+  {
+    return true;
+  }
+  for (const ScalarType shift : { -period, period })
+  {
+    ContinuousIndexType shiftedIndex;
+    for (unsigned int k = 0; k < ImageDimension; ++k)
+    {
+      shiftedIndex[k] = inputIndex[k] + shift * alphaDirection[k];
+    }
+    if (m_Interpolator->IsInsideBuffer(shiftedIndex))
+    {
+      inputIndex = shiftedIndex;
+      return true;
+    }
+  }
+  return false;
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+bool
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::IsInPlaneSeparable() const
+{
+  const auto & matrix = this->GetInput()->GetPhysicalPointToIndexMatrix();
+  const auto & indexToPoint = this->GetOutput()->GetIndexToPhysicalPoint();
+  for (unsigned int k = 0; k < ImageDimension; ++k)
+  {
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if ((k < 2) != (d < 2) && (matrix[k][d] != 0.0 || indexToPoint[k][d] != 0.0))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::BuildInPlaneMap()
+{
+  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType *      outputPtr = this->GetOutput();
+
+  m_InPlaneMapRegion = outputPtr->GetRequestedRegion();
+  const SizeValueType lineLength = m_InPlaneMapRegion.GetSize(0);
+  const SizeValueType numberOfLines = m_InPlaneMapRegion.GetSize(1);
+  m_InPlaneMap.resize(2 * lineLength * numberOfLines);
+
+  // Same arithmetic as DynamicThreadedGenerateData(), where the pass-through terms vanish in the first two dimensions.
+  const auto & matrix = inputPtr->GetPhysicalPointToIndexMatrix();
+  const auto & inputOrigin = inputPtr->GetOrigin();
+  const auto & indexToPoint = outputPtr->GetIndexToPhysicalPoint();
+  const auto & bufferStart = inputPtr->GetBufferedRegion().GetIndex();
+
+  // The other dimensions are set to the start of the buffer, so that the buffer test only checks the plane.
+  ContinuousIndexType planeBase;
+  ContinuousIndexType alphaDirection;
+  for (unsigned int k = 0; k < ImageDimension; ++k)
+  {
+    planeBase[k] = k < 2 ? -(matrix[k][0] * inputOrigin[0] + matrix[k][1] * inputOrigin[1])
+                         : static_cast<ScalarType>(bufferStart[k]);
+    alphaDirection[k] = k < 2 ? matrix[k][0] : 0.0;
+  }
+  const ScalarType stepX = indexToPoint[0][0];
+  const ScalarType stepY = indexToPoint[1][0];
+
+  ImageRegion<1> lines;
+  lines.SetSize(0, numberOfLines);
+
+  this->GetMultiThreader()->template ParallelizeImageRegion<1>(
+    lines,
+    [&](const ImageRegion<1> & linesForThread) {
+      std::vector<ScalarType> lineAlpha(lineLength);
+      std::vector<ScalarType> lineRadius(lineLength);
+
+      PolarTransformTally tally;
+      auto                start = PolarTransformTally::Now();
+
+      IndexType lineIndex = m_InPlaneMapRegion.GetIndex();
+      for (IndexValueType line = linesForThread.GetIndex(0); line <= linesForThread.GetUpperIndex()[0]; ++line)
+      {
+        lineIndex[1] = m_InPlaneMapRegion.GetIndex(1) + line;
+        PointType linePoint;
+        outputPtr->TransformIndexToPhysicalPoint(lineIndex, linePoint);
+
+        this->ComputeLinePolarCoordinates(
+          linePoint[0] - m_Center[0], linePoint[1] - m_Center[1], stepX, stepY, lineAlpha, lineRadius);
+
+        ScalarType * mapLine = m_InPlaneMap.data() + 2 * lineLength * static_cast<SizeValueType>(line);
+        for (SizeValueType i = 0; i < lineLength; ++i)
+        {
+          const ScalarType alpha = lineAlpha[i];
+          const ScalarType radius = lineRadius[i];
+          const ScalarType period = m_ConstArcIncr ? ScalarType(Math::twopi) * radius : ScalarType(Math::twopi);
+          const ScalarType rho = m_LogPolar ? std::log(radius) : radius;
+
+          ContinuousIndexType inputIndex = planeBase;
+          for (unsigned int k = 0; k < 2; ++k)
+          {
+            inputIndex[k] = planeBase[k] + alpha * matrix[k][0] + rho * matrix[k][1];
+          }
+
+          const bool inside = this->FindPeriodicSample(inputIndex, alphaDirection, period);
+          mapLine[2 * i] = inside ? inputIndex[0] : std::numeric_limits<ScalarType>::quiet_NaN();
+          mapLine[2 * i + 1] = inputIndex[1];
+        }
+      }
+
+      tally.AddTransformTime(start);
+      m_EvaluationCounters.Add(tally);
+    },
+    nullptr);
+}
+
+
+template <typename TInputImage, typename TOutputImage, typename TInterpolatorPrecisionType>
+void
+PolarToCartesianImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::GenerateDataWithInPlaneMap(
+  const OutputImageRegionType & outputRegionForThread)
+{
+  const InputImageType * inputPtr = this->GetInput();
+  OutputImageType *      outputPtr = this->GetOutput();
+
+  const auto &        matrix = inputPtr->GetPhysicalPointToIndexMatrix();
+  const auto &        inputOrigin = inputPtr->GetOrigin();
+  const auto &        bufferStart = inputPtr->GetBufferedRegion().GetIndex();
+  const IndexType &   mapStart = m_InPlaneMapRegion.GetIndex();
+  const SizeValueType mapLineLength = m_InPlaneMapRegion.GetSize(0);
+
+  ImageScanlineIterator<OutputImageType> outIt(outputPtr, outputRegionForThread);
+
+  PolarTransformTally tally;
+
+  while (!outIt.IsAtEnd())
+  {
+    const IndexType lineIndex = outIt.GetIndex();
+    auto            start = PolarTransformTally::Now();
+    PointType       linePoint;
+    outputPtr->TransformIndexToPhysicalPoint(lineIndex, linePoint);
+
+    // Input index of the slice in the other dimensions. The first two are set to the start of the buffer, so that
+    // the buffer test only checks the slice.
+    ContinuousIndexType inputIndex;
+    for (unsigned int k = 0; k < ImageDimension; ++k)
+    {
+      inputIndex[k] = k < 2 ? static_cast<ScalarType>(bufferStart[k]) : 0.0;
+    }
+    for (unsigned int k = 2; k < ImageDimension; ++k)
+    {
+      for (unsigned int d = 2; d < ImageDimension; ++d)
+      {
+        inputIndex[k] += matrix[k][d] * (linePoint[d] - inputOrigin[d]);
+      }
+    }
+    const bool sliceInside = m_Interpolator->IsInsideBuffer(inputIndex);
+
+    const ScalarType * mapPixel =
+      m_InPlaneMap.data() +
+      2 * (static_cast<SizeValueType>(lineIndex[1] - mapStart[1]) * mapLineLength +
+           static_cast<SizeValueType>(lineIndex[0] - mapStart[0]));
+    for (; !outIt.IsAtEndOfLine(); ++outIt, mapPixel += 2)
+    {
+      const bool inside = sliceInside && !std::isnan(mapPixel[0]);
+      tally.CountSample(inside);
+      if (inside)
+      {
+        inputIndex[0] = mapPixel[0];
+        inputIndex[1] = mapPixel[1];
+        outIt.Set(PolarImageFilterHelpers::CastPixelWithClamping<PixelType>(
+          m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+      }
+      else
+      {
+        outIt.Set(m_DefaultPixelValue);
+      }
+    }
+    tally.AddInterpolationTime(start);
+    outIt.NextLine();
+  }
+
+  m_EvaluationCounters.Add(tally);
+}
+
+} // namespace itk
+
+#endif
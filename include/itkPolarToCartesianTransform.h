@@ -22,22 +22,33 @@
 #include "itkTransform.h"
 #include "itkMacro.h"
 #include "itkMatrix.h"
+#include "itkPolarTransformKernels.h"
+#include "itkPolarTransformEnums.h"
+#include "itkPolarTransformInstrumentation.h"
+#include "itkPolarMappingFunctors.h"
 
 namespace itk
 {
 
+template <typename TParametersValueType, unsigned int NDimensions>
+class CartesianToPolarTransform;
+
 /** \class PolarToCartesianTransform
  *
  * \brief Polar transformation of a vector space (e.g. space coordinates).
  *
  * Transforms first two coordinates form polar space <alpha,radius> to cartesian
  * coordinates. Other dimensions are left unchanges. In fact this is generalized
- * cylindric transform:
- * \f[          x_1 = r cos( \alpha ) \f]
- * \f[          x_2 = r sin( \alpha ) \f]
+ * cylindric transform, with c the Center and \f$ \alpha_0 \f$ the AngleOffset:
+ * \f[          x_0 = c_0 + r cos( \alpha + \alpha_0 ) \f]
+ * \f[          x_1 = c_1 + r sin( \alpha + \alpha_0 ) \f]
  * \f[          x_n = x_n, \mbox{ n>=2 } \f]
  *
  * \par
+ * Release 1.2 and earlier also added the Center to the dimensions n >= 2.
+ * SetUseLegacyConvention() restores that mapping.
+ *
+ * \par
  * Center of the polar transform is can be specified with SetCenter().
  * The default is center of coordinate system < 0, 0 >.
  *
@@ -79,6 +90,8 @@ public:
 
   /** Standard Jacobian container. */
   using JacobianType = typename Superclass::JacobianType;
+  using JacobianPositionType = typename Superclass::JacobianPositionType;
+  using InverseJacobianPositionType = typename Superclass::InverseJacobianPositionType;
 
   /** Standard parameters container. */
   using ParametersType = typename Superclass::ParametersType;
@@ -99,14 +112,44 @@ public:
   using InputPointType = Point<TParametersValueType, Self::SpaceDimension>;
   using OutputPointType = Point<TParametersValueType, Self::SpaceDimension>;
 
+  /** Inverse transform type alias. */
+  using InverseTransformType = CartesianToPolarTransform<TParametersValueType, NDimensions>;
+  using InverseTransformBasePointer = typename Superclass::InverseTransformBasePointer;
+
+  using AngleEvaluationEnum = PolarTransformEnums::AngleEvaluation;
+
   /** Method to transform a point.
    * This method transforms first two dimensions of a point from polar
-   * coordinates <alpha,radius> to cartesian coordinates.
+   * coordinates <alpha,radius> to cartesian coordinates. The sine and cosine
+   * are evaluated as selected by SetAngleEvaluation().
    */
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
-  /** Method to transform a vector - not applicable for this type of transform. */
+  /** Method to transform a batch of points stored contiguously (array of structures).
+   *
+   * Evaluates the angles as selected by SetAngleEvaluation(), with the vectorized
+   * PolarTransformKernels in Approximate mode and with libm per point otherwise,
+   * so the results agree with TransformPoint() up to vectorization. The output
+   * may be the same buffer as the input. Both batch overloads are virtual, so
+   * subclasses are batch-transformed correctly through a pointer to this class.
+   */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const;
+
+  /** Method to transform a batch of points stored as a structure of arrays.
+   *
+   * inputComponents[d][i] is coordinate d of point i. Each output component
+   * may be the same buffer as the corresponding input component.
+   */
+  virtual void
+  TransformPoints(const ScalarType * const * inputComponents,
+                  ScalarType * const *       outputComponents,
+                  SizeValueType              numberOfPoints) const;
+
+  /** Method to transform a vector - only the overloads at a point apply to this type of transform. */
   OutputVectorType
   TransformVector(const InputVectorType &) const override
   {
@@ -114,7 +157,7 @@ public:
     return OutputVectorType();
   }
 
-  /** Method to transform a vnl_vector - not applicable for this type of transform. */
+  /** Method to transform a vnl_vector - only the overloads at a point apply to this type of transform. */
   OutputVnlVectorType
   TransformVector(const InputVnlVectorType &) const override
   {
@@ -122,17 +165,9 @@ public:
     return OutputVnlVectorType();
   }
 
-  /** Method to transform a vector - not applicable for this type of transform. */
-  typename Superclass::OutputVectorPixelType
-  TransformVector(const typename Superclass::InputVectorPixelType &, const InputPointType &) const override
-  {
-    itkExceptionMacro(<< "Method not applicable for this type of transform.");
-    return typename Superclass::OutputVectorPixelType();
-  }
-
   using Superclass::TransformVector;
 
-  /** Method to transform a CovariantVector - not applicable for this type of transform */
+  /** Method to transform a CovariantVector - only the overloads at a point apply to this type of transform. */
   OutputCovariantVectorType
   TransformCovariantVector(const InputCovariantVectorType &) const override
   {
@@ -142,12 +177,67 @@ public:
 
   using Superclass::TransformCovariantVector;
 
+  /** The transform has no parameters, so the Jacobian has no columns. */
   void
-  ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override
+  ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType & jacobian) const override
   {
-    itkExceptionMacro(<< "Method not implemented yet.");
+    jacobian.SetSize(SpaceDimension, 0);
   }
 
+  /** Compute the Jacobian of the transform with respect to the polar input point.
+   *
+   * With constant angular increment the in-plane block is
+   * \f[ \left( \begin{array}{cc} -r \sin\theta & \cos\theta \\ r \cos\theta & \sin\theta \end{array} \right) \f]
+   * with \f$ \theta = \alpha + \mbox{AngleOffset} \f$. With ConstArcIncr,
+   * \f$ \theta = \alpha / r + \mbox{AngleOffset} \f$ and the block is
+   * \f[ \left( \begin{array}{cc} -\sin\theta & \cos\theta + a \sin\theta \\ \cos\theta & \sin\theta - a \cos\theta
+   * \end{array} \right) \f]
+   * with \f$ a = \alpha / r \f$. The other dimensions are passed through. Where TransformPoint() returns NaN,
+   * so does the in-plane block.
+   *
+   * TransformVector() and TransformCovariantVector() at a point use these Jacobians.
+   */
+  void
+  ComputeJacobianWithRespectToPosition(const InputPointType & point, JacobianPositionType & jacobian) const override;
+
+  /** Compute the inverse of the Jacobian with respect to the polar input point in closed form.
+   *
+   * The Jacobian is singular at r = 0.
+   */
+  void
+  ComputeInverseJacobianWithRespectToPosition(const InputPointType &        point,
+                                              InverseJacobianPositionType & jacobian) const override;
+
+  using Superclass::ComputeJacobianWithRespectToPosition;
+  using Superclass::ComputeInverseJacobianWithRespectToPosition;
+
+  /** Fill a CartesianToPolarTransform with the Center, AngleOffset, ConstArcIncr, AngleEvaluation and
+   * UseLegacyConvention of this transform.
+   *
+   * The inverse maps back into [0,2*pi) for the angle. ReturnNaN has no counterpart.
+   */
+  bool
+  GetInverse(InverseTransformType * inverse) const;
+
+  /** Return a CartesianToPolarTransform inverting this transform. */
+  InverseTransformBasePointer
+  GetInverseTransform() const override;
+
+  /** Compute the bounding box of the cartesian points that the polar box [inputMinimum,inputMaximum] maps to.
+   *
+   * The in-plane bounds are those of the annulus sector [alpha0,alpha1] x [r0,r1]. Angle ranges of 2*pi or
+   * more cover the whole circle, any other range may wrap around 2*pi. Negative radii are mirrored through
+   * the center. With ConstArcIncr the angle range is that of arc/r over the corners of the box, so the bounds
+   * are not tight; they cover the whole circle when the radii include 0. Points mapped to NaN by ReturnNaN
+   * are not excluded. Dimensions other than the first two are passed through, shifted by the Center with
+   * UseLegacyConvention.
+   */
+  void
+  ComputeOutputBoundingBox(const InputPointType & inputMinimum,
+                           const InputPointType & inputMaximum,
+                           OutputPointType &      outputMinimum,
+                           OutputPointType &      outputMaximum) const;
+
   void
   SetParameters(const ParametersType &) override
   {}
@@ -172,7 +262,7 @@ public:
    * Defaults to Off
    */
   itkSetMacro(ConstArcIncr, bool);
-  itkGetMacro(ConstArcIncr, bool);
+  itkGetConstMacro(ConstArcIncr, bool);
   itkBooleanMacro(ConstArcIncr);
 
   /** Enable/Disable to return NaN in case alpha is outside [-pi,pi].
@@ -180,9 +270,46 @@ public:
    * Defaults to Off
    */
   itkSetMacro(ReturnNaN, bool);
-  itkGetMacro(ReturnNaN, bool);
+  itkGetConstMacro(ReturnNaN, bool);
   itkBooleanMacro(ReturnNaN);
 
+  /** Enable/Disable the convention of release 1.2 and earlier, which adds the Center to all dimensions.
+   *
+   * This is meant for the migration of existing code only: enabling it issues a deprecation warning, and it will
+   * be removed in a future release. See CartesianToPolarTransform::SetUseLegacyConvention() for the AngleOffset
+   * convention of the inverse. GetInverse() copies the setting.
+   *
+   * Defaults to Off
+   */
+  virtual void
+  SetUseLegacyConvention(bool useLegacyConvention);
+  itkGetConstMacro(UseLegacyConvention, bool);
+  itkBooleanMacro(UseLegacyConvention);
+
+  /** Select std::sin() and std::cos() (Exact) or the polynomial approximation of PolarTransformKernels
+   * (Approximate) in TransformPoint() and TransformPoints(). See PolarTransformEnums::AngleEvaluation for the error
+   * bounds.
+   *
+   * Defaults to Exact
+   */
+  itkSetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+  itkGetEnumMacro(AngleEvaluation, AngleEvaluationEnum);
+
+  /** Counts and times of the batch TransformPoints() since construction or the last ResetEvaluationStatistics().
+   * They are only collected when the module is configured with PolarTransform_USE_INSTRUMENTATION, see
+   * PolarTransformStatistics. */
+  PolarTransformStatistics
+  GetEvaluationStatistics() const
+  {
+    return m_EvaluationCounters.GetStatistics();
+  }
+
+  void
+  ResetEvaluationStatistics()
+  {
+    m_EvaluationCounters.Reset();
+  }
+
 protected:
   PolarToCartesianTransform();
   ~PolarToCartesianTransform() override;
@@ -191,11 +318,25 @@ protected:
   void
   PrintSelf(std::ostream & os, Indent indent) const override;
 
+  /** Settings of the batch kernels. */
+  PolarTransformKernels::Parameters<ScalarType>
+  GetKernelParameters() const;
+
+  /** Add the counts and times of a batch to the evaluation statistics. */
+  void
+  AddEvaluationTally(const PolarTransformTally & tally) const
+  {
+    m_EvaluationCounters.Add(tally);
+  }
+
 private:
   OutputPointType                    m_Center;
   typename InputPointType::ValueType m_AngleOffset = 0;
   bool                               m_ConstArcIncr = false;
   bool                               m_ReturnNaN = false;
+  bool                               m_UseLegacyConvention = false;
+  AngleEvaluationEnum                m_AngleEvaluation = AngleEvaluationEnum::Exact;
+  mutable PolarTransformCounters     m_EvaluationCounters;
 }; // class PolarToCartesianTransform
 
 } // namespace itk
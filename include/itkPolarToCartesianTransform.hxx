@@ -18,6 +18,8 @@
 #ifndef itkPolarToCartesianTransform_hxx
 #define itkPolarToCartesianTransform_hxx
 
+#include "itkCartesianToPolarTransform.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -40,6 +42,15 @@ PolarToCartesianTransform<TParametersValueType, NDimensions>::PrintSelf(std::ost
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Center: " << m_Center << std::endl;
+  os << indent << "AngleOffset: " << m_AngleOffset << std::endl;
+  os << indent << "ConstArcIncr: " << (m_ConstArcIncr ? "On" : "Off") << std::endl;
+  os << indent << "ReturnNaN: " << (m_ReturnNaN ? "On" : "Off") << std::endl;
+  os << indent << "UseLegacyConvention: " << (m_UseLegacyConvention ? "On" : "Off") << std::endl;
+  os << indent << "AngleEvaluation: " << m_AngleEvaluation << std::endl;
+  if (PolarTransformCounters::Enabled)
+  {
+    os << indent << "EvaluationStatistics: " << m_EvaluationCounters.GetStatistics() << std::endl;
+  }
 }
 
 
@@ -47,33 +58,361 @@ template <typename TParametersValueType, unsigned int NDimensions>
 typename PolarToCartesianTransform<TParametersValueType, NDimensions>::OutputPointType
 PolarToCartesianTransform<TParametersValueType, NDimensions>::TransformPoint(const InputPointType & inputPoint) const
 {
-  OutputPointType outputPoint(inputPoint);
+  // select the mapping specialized for the current options
+  OutputPointType outputPoint = Functor::DispatchPolarMappingFlags(
+    [&](auto constArcIncr, auto returnNaN, auto angleOffset, auto approximate) {
+      using MappingType = Functor::PolarToCartesianMapping<ScalarType,
+                                                           decltype(constArcIncr)::value,
+                                                           decltype(returnNaN)::value,
+                                                           decltype(angleOffset)::value,
+                                                           decltype(approximate)::value
+                                                             ? AngleEvaluationEnum::Approximate
+                                                             : AngleEvaluationEnum::Exact>;
+      return MappingType(m_Center[0], m_Center[1], m_AngleOffset)(inputPoint);
+    },
+    m_ConstArcIncr,
+    m_ReturnNaN,
+    m_AngleOffset != 0.0,
+    m_AngleEvaluation == AngleEvaluationEnum::Approximate);
+
+  if (m_UseLegacyConvention)
+  {
+    for (unsigned int d = 2; d < SpaceDimension; ++d)
+    {
+      outputPoint[d] += m_Center[d];
+    }
+  }
+  return outputPoint;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianTransform<TParametersValueType, NDimensions>::ComputeJacobianWithRespectToPosition(
+  const InputPointType & point,
+  JacobianPositionType & jacobian) const
+{
+  jacobian.set_identity();
 
-  double alpha = inputPoint[0];
+  const ScalarType radius = point[1];
+  ScalarType       alpha = point[0];
   if (m_ConstArcIncr)
   {
-    alpha /= inputPoint[1]; // alpha = arc/r
+    alpha /= radius; // alpha = arc/r
   }
 
   if (m_ReturnNaN && (alpha < -Math::pi || Math::pi < alpha))
   {
-    using PointNumericTraits = NumericTraits<typename OutputPointType::ValueType>;
-    outputPoint[0] = PointNumericTraits::quiet_NaN();
-    outputPoint[1] = PointNumericTraits::quiet_NaN();
-    return outputPoint;
+    const ScalarType nan = NumericTraits<ScalarType>::quiet_NaN();
+    jacobian(0, 0) = jacobian(0, 1) = jacobian(1, 0) = jacobian(1, 1) = nan;
+    return;
+  }
+
+  const ScalarType cosTheta = std::cos(alpha + m_AngleOffset);
+  const ScalarType sinTheta = std::sin(alpha + m_AngleOffset);
+  if (m_ConstArcIncr)
+  {
+    // d(theta)/d(arc) = 1/r and d(theta)/dr = -alpha/r
+    jacobian(0, 0) = -sinTheta;
+    jacobian(0, 1) = cosTheta + alpha * sinTheta;
+    jacobian(1, 0) = cosTheta;
+    jacobian(1, 1) = sinTheta - alpha * cosTheta;
+  }
+  else
+  {
+    jacobian(0, 0) = -radius * sinTheta;
+    jacobian(0, 1) = cosTheta;
+    jacobian(1, 0) = radius * cosTheta;
+    jacobian(1, 1) = sinTheta;
   }
+}
+
 
-  alpha += m_AngleOffset; // add offset after NaN return to keep values within [-pi,pi]
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianTransform<TParametersValueType, NDimensions>::ComputeInverseJacobianWithRespectToPosition(
+  const InputPointType &        point,
+  InverseJacobianPositionType & jacobian) const
+{
+  jacobian.set_identity();
 
-  outputPoint[0] = inputPoint[1] * std::cos(alpha); // r*cos(alpha)
-  outputPoint[1] = inputPoint[1] * std::sin(alpha); // r*sin(alpha)
+  const ScalarType radius = point[1];
+  ScalarType       alpha = point[0];
+  if (m_ConstArcIncr)
+  {
+    alpha /= radius; // alpha = arc/r
+  }
 
-  for (unsigned int ii = 0; ii < SpaceDimension; ++ii)
+  if (m_ReturnNaN && (alpha < -Math::pi || Math::pi < alpha))
   {
-    outputPoint[ii] = this->m_Center[ii] + outputPoint[ii];
+    const ScalarType nan = NumericTraits<ScalarType>::quiet_NaN();
+    jacobian(0, 0) = jacobian(0, 1) = jacobian(1, 0) = jacobian(1, 1) = nan;
+    return;
   }
 
-  return outputPoint;
+  const ScalarType cosTheta = std::cos(alpha + m_AngleOffset);
+  const ScalarType sinTheta = std::sin(alpha + m_AngleOffset);
+  if (m_ConstArcIncr)
+  {
+    // the determinant of the forward Jacobian is -1
+    jacobian(0, 0) = alpha * cosTheta - sinTheta;
+    jacobian(0, 1) = alpha * sinTheta + cosTheta;
+  }
+  else
+  {
+    // the determinant of the forward Jacobian is -r
+    jacobian(0, 0) = -sinTheta / radius;
+    jacobian(0, 1) = cosTheta / radius;
+  }
+  jacobian(1, 0) = cosTheta;
+  jacobian(1, 1) = sinTheta;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+PolarToCartesianTransform<TParametersValueType, NDimensions>::GetInverse(InverseTransformType * inverse) const
+{
+  if (!inverse)
+  {
+    return false;
+  }
+
+  inverse->SetCenter(m_Center);
+  inverse->SetAngleOffset(m_AngleOffset);
+  inverse->SetConstArcIncr(m_ConstArcIncr);
+  inverse->SetAngleEvaluation(m_AngleEvaluation);
+  inverse->SetUseLegacyConvention(m_UseLegacyConvention);
+  return true;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+PolarToCartesianTransform<TParametersValueType, NDimensions>::GetInverseTransform() const -> InverseTransformBasePointer
+{
+  const auto inverse = InverseTransformType::New();
+  return this->GetInverse(inverse) ? inverse.GetPointer() : nullptr;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianTransform<TParametersValueType, NDimensions>::SetUseLegacyConvention(const bool useLegacyConvention)
+{
+  if (m_UseLegacyConvention == useLegacyConvention)
+  {
+    return;
+  }
+  if (useLegacyConvention)
+  {
+    itkWarningMacro(<< "UseLegacyConvention is deprecated and will be removed in a future release. Add the "
+                       "Center to the dimensions beyond the first two instead.");
+  }
+  m_UseLegacyConvention = useLegacyConvention;
+  this->Modified();
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianTransform<TParametersValueType, NDimensions>::ComputeOutputBoundingBox(
+  const InputPointType & inputMinimum,
+  const InputPointType & inputMaximum,
+  OutputPointType &      outputMinimum,
+  OutputPointType &      outputMaximum) const
+{
+  using C = PolarTransformKernels::Constants<ScalarType>;
+
+  outputMinimum = inputMinimum;
+  outputMaximum = inputMaximum;
+
+  const ScalarType alpha0 = inputMinimum[0];
+  const ScalarType alpha1 = inputMaximum[0];
+  const ScalarType radius0 = inputMinimum[1];
+  const ScalarType radius1 = inputMaximum[1];
+
+  // angle range [theta0,theta1] of the sector
+  ScalarType theta0 = alpha0;
+  ScalarType theta1 = alpha1;
+  if (m_ConstArcIncr)
+  {
+    if (radius0 > 0.0 || radius1 < 0.0)
+    {
+      // alpha = arc/r is monotonic in arc and r, so the extremes are at the corners
+      const ScalarType corners[] = { alpha0 / radius0, alpha0 / radius1, alpha1 / radius0, alpha1 / radius1 };
+      theta0 = *std::min_element(std::begin(corners), std::end(corners));
+      theta1 = *std::max_element(std::begin(corners), std::end(corners));
+    }
+    else
+    {
+      theta0 = 0.0;
+      theta1 = C::TwoPi;
+    }
+  }
+  theta0 += m_AngleOffset;
+  theta1 += m_AngleOffset;
+
+  outputMinimum[0] = NumericTraits<ScalarType>::max();
+  outputMinimum[1] = NumericTraits<ScalarType>::max();
+  outputMaximum[0] = NumericTraits<ScalarType>::NonpositiveMin();
+  outputMaximum[1] = NumericTraits<ScalarType>::NonpositiveMin();
+
+  // extend the box by the sector [start,end] x [innerRadius,outerRadius] with 0 <= innerRadius <= outerRadius
+  const auto extendBySector = [&](const ScalarType start,
+                                  const ScalarType end,
+                                  const ScalarType innerRadius,
+                                  const ScalarType outerRadius) {
+    const auto contains = [start, end](const ScalarType angle) {
+      const ScalarType turn = angle - start - C::TwoPi * std::floor((angle - start) / C::TwoPi);
+      return end - start >= C::TwoPi || turn <= end - start;
+    };
+    const ScalarType cosMaximum = contains(0.0) ? 1.0 : std::max(std::cos(start), std::cos(end));
+    const ScalarType cosMinimum = contains(C::Pi) ? -1.0 : std::min(std::cos(start), std::cos(end));
+    const ScalarType sinMaximum = contains(C::PiOver2) ? 1.0 : std::max(std::sin(start), std::sin(end));
+    const ScalarType sinMinimum = contains(-C::PiOver2) ? -1.0 : std::min(std::sin(start), std::sin(end));
+
+    // r*cos is extreme at the inner or the outer radius depending on the sign of cos
+    outputMinimum[0] = std::min<ScalarType>(outputMinimum[0],
+                                            m_Center[0] + (cosMinimum >= 0.0 ? innerRadius : outerRadius) * cosMinimum);
+    outputMaximum[0] = std::max<ScalarType>(outputMaximum[0],
+                                            m_Center[0] + (cosMaximum >= 0.0 ? outerRadius : innerRadius) * cosMaximum);
+    outputMinimum[1] = std::min<ScalarType>(outputMinimum[1],
+                                            m_Center[1] + (sinMinimum >= 0.0 ? innerRadius : outerRadius) * sinMinimum);
+    outputMaximum[1] = std::max<ScalarType>(outputMaximum[1],
+                                            m_Center[1] + (sinMaximum >= 0.0 ? outerRadius : innerRadius) * sinMaximum);
+  };
+
+  if (radius1 >= 0.0)
+  {
+    extendBySector(theta0, theta1, std::max<ScalarType>(radius0, 0.0), radius1);
+  }
+  if (radius0 < 0.0)
+  {
+    // a negative radius points in the opposite direction
+    extendBySector(theta0 + C::Pi, theta1 + C::Pi, -std::min<ScalarType>(radius1, 0.0), -radius0);
+  }
+
+  if (m_UseLegacyConvention)
+  {
+    for (unsigned int d = 2; d < SpaceDimension; ++d)
+    {
+      outputMinimum[d] += m_Center[d];
+      outputMaximum[d] += m_Center[d];
+    }
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianTransform<TParametersValueType, NDimensions>::TransformPoints(const InputPointType * inputPoints,
+                                                                              OutputPointType *      outputPoints,
+                                                                              SizeValueType numberOfPoints) const
+{
+  constexpr SizeValueType BlockSize = 256;
+
+  ScalarType alpha[BlockSize];
+  ScalarType radius[BlockSize];
+  ScalarType x[BlockSize];
+  ScalarType y[BlockSize];
+
+  const PolarTransformKernels::Parameters<ScalarType> parameters = this->GetKernelParameters();
+
+  PolarTransformTally tally;
+  auto                start = PolarTransformTally::Now();
+
+  for (SizeValueType begin = 0; begin < numberOfPoints; begin += BlockSize)
+  {
+    const SizeValueType count = std::min(BlockSize, numberOfPoints - begin);
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      alpha[i] = inputPoints[begin + i][0];
+      radius[i] = inputPoints[begin + i][1];
+    }
+
+    PolarTransformKernels::PolarToCartesian(alpha, radius, x, y, count, parameters);
+    tally.CountPolarInputs(alpha, radius, count, m_ConstArcIncr);
+    tally.CountNaN(x, y, count);
+
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      OutputPointType & outputPoint = outputPoints[begin + i];
+      if (&outputPoint != &inputPoints[begin + i])
+      {
+        outputPoint = inputPoints[begin + i];
+      }
+      outputPoint[0] = x[i];
+      outputPoint[1] = y[i];
+      if (m_UseLegacyConvention)
+      {
+        for (unsigned int d = 2; d < SpaceDimension; ++d)
+        {
+          outputPoint[d] += m_Center[d];
+        }
+      }
+    }
+  }
+
+  tally.AddTransformTime(start);
+  m_EvaluationCounters.Add(tally);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+PolarToCartesianTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const ScalarType * const * inputComponents,
+  ScalarType * const *       outputComponents,
+  SizeValueType              numberOfPoints) const
+{
+  PolarTransformTally tally;
+  auto                start = PolarTransformTally::Now();
+
+  // the output may be the input, so the inputs are counted first
+  tally.CountPolarInputs(inputComponents[0], inputComponents[1], numberOfPoints, m_ConstArcIncr);
+
+  PolarTransformKernels::PolarToCartesian(inputComponents[0],
+                                          inputComponents[1],
+                                          outputComponents[0],
+                                          outputComponents[1],
+                                          numberOfPoints,
+                                          this->GetKernelParameters());
+
+  for (unsigned int d = 2; d < SpaceDimension; ++d)
+  {
+    if (outputComponents[d] != inputComponents[d])
+    {
+      std::copy_n(inputComponents[d], numberOfPoints, outputComponents[d]);
+    }
+    if (m_UseLegacyConvention)
+    {
+      for (SizeValueType i = 0; i < numberOfPoints; ++i)
+      {
+        outputComponents[d][i] += m_Center[d];
+      }
+    }
+  }
+
+  tally.CountNaN(outputComponents[0], outputComponents[1], numberOfPoints);
+  tally.AddTransformTime(start);
+  m_EvaluationCounters.Add(tally);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+PolarToCartesianTransform<TParametersValueType, NDimensions>::GetKernelParameters() const
+  -> PolarTransformKernels::Parameters<ScalarType>
+{
+  PolarTransformKernels::Parameters<ScalarType> parameters;
+  parameters.CenterX = m_Center[0];
+  parameters.CenterY = m_Center[1];
+  parameters.AngleOffset = m_AngleOffset;
+  parameters.ExactAngles = m_AngleEvaluation != AngleEvaluationEnum::Approximate;
+  parameters.ConstArcIncr = m_ConstArcIncr;
+  parameters.ReturnNaN = m_ReturnNaN;
+  return parameters;
 }
 
 } // namespace itk
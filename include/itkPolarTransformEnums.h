@@ -0,0 +1,88 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarTransformEnums_h
+#define itkPolarTransformEnums_h
+
+#include <cstdint>
+#include <ostream>
+
+namespace itk
+{
+
+/** \class PolarTransformEnums
+ *
+ * \brief Enums used by the polar transforms and image filters.
+ *
+ * \ingroup PolarTransform
+ */
+class PolarTransformEnums
+{
+public:
+  /** \class AngleEvaluation
+   *
+   * \brief How angles and their sine and cosine are evaluated.
+   *
+   * Approximate uses the branch-free polynomial approximations of
+   * PolarTransformKernels. For double, the angle is within 2 ulp of the
+   * correctly rounded result, i.e. within 2e-15 rad for angles in [0,2*pi),
+   * and sine and cosine are within 2.3e-16. For float the angle is within
+   * 3 ulp, i.e. within 1.5e-6 rad for angles in [0,2*pi), and sine and cosine
+   * are within 1.2e-7.
+   *
+   * Incremental applies to the uniform angle grids of
+   * CartesianToPolarImageFilter: sine and cosine are advanced from sample to
+   * sample by the rotation of one grid step, and reseeded with std::sin() and
+   * std::cos() every 64 samples for double (16 for float). They stay within
+   * 3e-14 (double) or 4e-6 (float) of std::sin() and std::cos() for angles
+   * within [-4*pi,4*pi]. Everywhere else Incremental is the same as Exact.
+   *
+   * \ingroup PolarTransform
+   */
+  enum class AngleEvaluation : uint8_t
+  {
+    /** std::atan2(), std::sin() and std::cos(). */
+    Exact,
+    /** Polynomial approximations with the error bounds documented above. */
+    Approximate,
+    /** Rotation recurrence on uniform angle grids with the error bounds documented above, Exact elsewhere. */
+    Incremental
+  };
+};
+
+/** Define how to print enumerations. */
+inline std::ostream &
+operator<<(std::ostream & out, const PolarTransformEnums::AngleEvaluation value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case PolarTransformEnums::AngleEvaluation::Exact:
+        return "itk::PolarTransformEnums::AngleEvaluation::Exact";
+      case PolarTransformEnums::AngleEvaluation::Approximate:
+        return "itk::PolarTransformEnums::AngleEvaluation::Approximate";
+      case PolarTransformEnums::AngleEvaluation::Incremental:
+        return "itk::PolarTransformEnums::AngleEvaluation::Incremental";
+      default:
+        return "INVALID VALUE FOR itk::PolarTransformEnums::AngleEvaluation";
+    }
+  }();
+}
+
+} // namespace itk
+
+#endif
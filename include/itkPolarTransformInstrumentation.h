@@ -0,0 +1,318 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPolarTransformInstrumentation_h
+#define itkPolarTransformInstrumentation_h
+
+#include "itkIntTypes.h"
+#include "itkMath.h"
+#include "itkPolarTransformConfigure.h"
+#include <cmath>
+#include <ostream>
+
+#if ITK_POLAR_TRANSFORM_USE_INSTRUMENTATION
+#  include <atomic>
+#  include <chrono>
+#  include <cstdint>
+#endif
+
+namespace itk
+{
+
+/** \class PolarTransformStatistics
+ *
+ * \brief Counts and times of the evaluations of a polar transform or image filter.
+ *
+ * Evaluated is the number of points or output pixels. Of these, NaN counts
+ * the results that are NaN, OutOfRange the polar points with an angle outside
+ * [-pi,pi] and the output pixels that map outside the input, and
+ * DegenerateCenter the points at the center, where the angle is not defined.
+ *
+ * TransformSeconds is the time spent in the batch TransformPoints() and in
+ * the polar mapping of the image filters, InterpolationSeconds the time the
+ * image filters spend interpolating. The times are summed over threads.
+ *
+ * The statistics are only collected when the module is configured with
+ * PolarTransform_USE_INSTRUMENTATION, and are zero otherwise.
+ *
+ * \ingroup PolarTransform
+ */
+struct PolarTransformStatistics
+{
+  SizeValueType Evaluated = 0;
+  SizeValueType NaN = 0;
+  SizeValueType OutOfRange = 0;
+  SizeValueType DegenerateCenter = 0;
+  double        TransformSeconds = 0.0;
+  double        InterpolationSeconds = 0.0;
+};
+
+inline std::ostream &
+operator<<(std::ostream & os, const PolarTransformStatistics & statistics)
+{
+  return os << "[Evaluated: " << statistics.Evaluated << ", NaN: " << statistics.NaN
+            << ", OutOfRange: " << statistics.OutOfRange << ", DegenerateCenter: " << statistics.DegenerateCenter
+            << ", TransformSeconds: " << statistics.TransformSeconds
+            << ", InterpolationSeconds: " << statistics.InterpolationSeconds << "]";
+}
+
+#if ITK_POLAR_TRANSFORM_USE_INSTRUMENTATION
+
+/** \class PolarTransformTally
+ *
+ * \brief Counts and times of one thread, added to PolarTransformCounters once per batch or region.
+ *
+ * Without PolarTransform_USE_INSTRUMENTATION all members are empty inline
+ * functions, so the probes in the batch and resampling paths compile to
+ * nothing.
+ *
+ * \ingroup PolarTransform
+ */
+class PolarTransformTally
+{
+public:
+  using ClockType = std::chrono::steady_clock;
+  using TimePoint = ClockType::time_point;
+
+  /** Start of a timed section. */
+  static TimePoint
+  Now() noexcept
+  {
+    return ClockType::now();
+  }
+
+  /** Add the time since start to the transform time, and restart. */
+  void
+  AddTransformTime(TimePoint & start) noexcept
+  {
+    const TimePoint now = ClockType::now();
+    m_TransformTime += now - start;
+    start = now;
+  }
+
+  /** Add the time since start to the interpolation time, and restart. */
+  void
+  AddInterpolationTime(TimePoint & start) noexcept
+  {
+    const TimePoint now = ClockType::now();
+    m_InterpolationTime += now - start;
+    start = now;
+  }
+
+  /** Count polar inputs <alpha,radius> of the polar to cartesian mapping, before they are mapped. */
+  template <typename T>
+  void
+  CountPolarInputs(const T * alpha, const T * radius, SizeValueType count, bool constArcIncr) noexcept
+  {
+    const auto pi = static_cast<T>(Math::pi);
+    m_Evaluated += count;
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      const T angle = constArcIncr ? alpha[i] / radius[i] : alpha[i];
+      m_OutOfRange += (angle < -pi || pi < angle);
+      m_DegenerateCenter += (radius[i] == T(0));
+    }
+  }
+
+  /** Count polar outputs <alpha,radius> of the cartesian to polar mapping. */
+  template <typename T>
+  void
+  CountPolarOutputs(const T * alpha, const T * radius, SizeValueType count) noexcept
+  {
+    m_Evaluated += count;
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      m_NaN += (std::isnan(alpha[i]) || std::isnan(radius[i]));
+      m_DegenerateCenter += (radius[i] == T(0));
+    }
+  }
+
+  /** Count NaN outputs of the polar to cartesian mapping. */
+  template <typename T>
+  void
+  CountNaN(const T * x, const T * y, SizeValueType count) noexcept
+  {
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      m_NaN += (std::isnan(x[i]) || std::isnan(y[i]));
+    }
+  }
+
+  /** Count an output pixel of an image filter. */
+  void
+  CountSample(bool inside) noexcept
+  {
+    ++m_Evaluated;
+    m_OutOfRange += !inside;
+  }
+
+  /** Count output pixels of an image filter that map to the center. */
+  void
+  CountDegenerateCenter(SizeValueType count) noexcept
+  {
+    m_DegenerateCenter += count;
+  }
+
+private:
+  friend class PolarTransformCounters;
+
+  SizeValueType       m_Evaluated = 0;
+  SizeValueType       m_NaN = 0;
+  SizeValueType       m_OutOfRange = 0;
+  SizeValueType       m_DegenerateCenter = 0;
+  ClockType::duration m_TransformTime{};
+  ClockType::duration m_InterpolationTime{};
+};
+
+
+/** \class PolarTransformCounters
+ *
+ * \brief Counts and times of all threads, summed with relaxed atomic additions.
+ *
+ * Each batch TransformPoints() call or image filter thread fills its own
+ * PolarTransformTally and adds it once, so the counters are updated without
+ * locks and without contention in the inner loops. Without
+ * PolarTransform_USE_INSTRUMENTATION the class is empty.
+ *
+ * \ingroup PolarTransform
+ */
+class PolarTransformCounters
+{
+public:
+  /** Whether the module collects statistics. */
+  static constexpr bool Enabled = true;
+
+  void
+  Add(const PolarTransformTally & tally) noexcept
+  {
+    m_Evaluated.fetch_add(tally.m_Evaluated, std::memory_order_relaxed);
+    m_NaN.fetch_add(tally.m_NaN, std::memory_order_relaxed);
+    m_OutOfRange.fetch_add(tally.m_OutOfRange, std::memory_order_relaxed);
+    m_DegenerateCenter.fetch_add(tally.m_DegenerateCenter, std::memory_order_relaxed);
+    m_TransformNanoseconds.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(tally.m_TransformTime).count(), std::memory_order_relaxed);
+    m_InterpolationNanoseconds.fetch_add(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(tally.m_InterpolationTime).count(),
+      std::memory_order_relaxed);
+  }
+
+  PolarTransformStatistics
+  GetStatistics() const noexcept
+  {
+    PolarTransformStatistics statistics;
+    statistics.Evaluated = m_Evaluated.load(std::memory_order_relaxed);
+    statistics.NaN = m_NaN.load(std::memory_order_relaxed);
+    statistics.OutOfRange = m_OutOfRange.load(std::memory_order_relaxed);
+    statistics.DegenerateCenter = m_DegenerateCenter.load(std::memory_order_relaxed);
+    statistics.TransformSeconds = 1e-9 * static_cast<double>(m_TransformNanoseconds.load(std::memory_order_relaxed));
+    statistics.InterpolationSeconds =
+      1e-9 * static_cast<double>(m_InterpolationNanoseconds.load(std::memory_order_relaxed));
+    return statistics;
+  }
+
+  void
+  Reset() noexcept
+  {
+    m_Evaluated.store(0, std::memory_order_relaxed);
+    m_NaN.store(0, std::memory_order_relaxed);
+    m_OutOfRange.store(0, std::memory_order_relaxed);
+    m_DegenerateCenter.store(0, std::memory_order_relaxed);
+    m_TransformNanoseconds.store(0, std::memory_order_relaxed);
+    m_InterpolationNanoseconds.store(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<SizeValueType> m_Evaluated{ 0 };
+  std::atomic<SizeValueType> m_NaN{ 0 };
+  std::atomic<SizeValueType> m_OutOfRange{ 0 };
+  std::atomic<SizeValueType> m_DegenerateCenter{ 0 };
+  std::atomic<int64_t>       m_TransformNanoseconds{ 0 };
+  std::atomic<int64_t>       m_InterpolationNanoseconds{ 0 };
+};
+
+#else
+
+class PolarTransformTally
+{
+public:
+  struct TimePoint
+  {};
+
+  static TimePoint
+  Now() noexcept
+  {
+    return {};
+  }
+
+  void
+  AddTransformTime(TimePoint &) noexcept
+  {}
+
+  void
+  AddInterpolationTime(TimePoint &) noexcept
+  {}
+
+  template <typename T>
+  void
+  CountPolarInputs(const T *, const T *, SizeValueType, bool) noexcept
+  {}
+
+  template <typename T>
+  void
+  CountPolarOutputs(const T *, const T *, SizeValueType) noexcept
+  {}
+
+  template <typename T>
+  void
+  CountNaN(const T *, const T *, SizeValueType) noexcept
+  {}
+
+  void
+  CountSample(bool) noexcept
+  {}
+
+  void
+  CountDegenerateCenter(SizeValueType) noexcept
+  {}
+};
+
+
+class PolarTransformCounters
+{
+public:
+  static constexpr bool Enabled = false;
+
+  void
+  Add(const PolarTransformTally &) noexcept
+  {}
+
+  PolarTransformStatistics
+  GetStatistics() const noexcept
+  {
+    return {};
+  }
+
+  void
+  Reset() noexcept
+  {}
+};
+
+#endif
+
+} // namespace itk
+
+#endif
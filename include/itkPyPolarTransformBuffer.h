@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPyPolarTransformBuffer_h
+#define itkPyPolarTransformBuffer_h
+
+// The python header defines _POSIX_C_SOURCE without a preceding #undef
+#undef _POSIX_C_SOURCE
+#undef _XOPEN_SOURCE
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "itkMacro.h"
+#include "itkIntTypes.h"
+
+namespace itk
+{
+
+/** \class PyPolarTransformBuffer
+ *
+ * \brief Transform the points of NumPy arrays with the batch TransformPoints() of a polar transform.
+ *
+ * Calling TransformPoint() from Python for every point costs a round trip
+ * through the wrapping and an itk.Point per point, which dominates the time
+ * for large point sets. This helper takes the points as a C-contiguous
+ * buffer of shape (N, Dimension), such as a NumPy array, reads and writes
+ * it in place without copies, and transforms all points with the batch
+ * TransformPoints() of the transform. The GIL is released while the points
+ * are transformed, and large buffers are split over the threads of the
+ * default MultiThreaderBase, so other Python threads keep running.
+ *
+ * In Python:
+ *
+ * \code
+ * Buffer = itk.PyPolarTransformBuffer[type(transform)]
+ * cartesian = Buffer.TransformPoints(transform, polar)
+ * Buffer.TransformPoints(transform, polar, polar)  # in place
+ * \endcode
+ *
+ * The array is converted with numpy.ascontiguousarray() to the scalar type
+ * of the transform, which does not copy arrays that have this layout
+ * already. This class is only available with Python wrapping.
+ *
+ * \ingroup PolarTransform
+ */
+template <typename TTransform>
+class PyPolarTransformBuffer
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PyPolarTransformBuffer);
+
+  /** Standard class type alias. */
+  using Self = PyPolarTransformBuffer;
+
+  /** Transform type alias. */
+  using TransformType = TTransform;
+  using ScalarType = typename TransformType::ScalarType;
+  using InputPointType = typename TransformType::InputPointType;
+  using OutputPointType = typename TransformType::OutputPointType;
+
+  static constexpr unsigned int Dimension = TransformType::InputSpaceDimension;
+  static_assert(TransformType::OutputSpaceDimension == Dimension, "Input and output dimensions must agree.");
+
+  /** Number of points transformed by one work unit. */
+  static constexpr SizeValueType ChunkSize = 16384;
+
+  /** Transform the points of a C-contiguous buffer of shape (N, Dimension) into a writable buffer of the same shape,
+   * which may be the input buffer. Returns None, or nullptr with a Python exception set. */
+  static PyObject *
+  _TransformPoints(const TransformType * transform, PyObject * points, PyObject * output);
+
+protected:
+  PyPolarTransformBuffer() = default;
+  ~PyPolarTransformBuffer() = default;
+
+  /** Whether a buffer holds native ScalarType values in rows of Dimension. Sets a Python exception otherwise. */
+  static bool
+  CheckBuffer(const Py_buffer & buffer, const char * name);
+};
+
+} // namespace itk
+
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkPyPolarTransformBuffer.hxx"
+#endif
+
+#endif
@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPyPolarTransformBuffer_hxx
+#define itkPyPolarTransformBuffer_hxx
+
+#include "itkMultiThreaderBase.h"
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <type_traits>
+
+namespace itk
+{
+
+template <typename TTransform>
+bool
+PyPolarTransformBuffer<TTransform>::CheckBuffer(const Py_buffer & buffer, const char * name)
+{
+  // struct module format of native float or double, optionally with the native byte order prefix
+  const char   code = std::is_same<ScalarType, float>::value ? 'f' : 'd';
+  const char * format = buffer.format != nullptr ? buffer.format : "B";
+  if (format[0] == '@' || format[0] == '=')
+  {
+    ++format;
+  }
+  if (buffer.itemsize != static_cast<Py_ssize_t>(sizeof(ScalarType)) || format[0] != code || format[1] != '\0')
+  {
+    PyErr_Format(PyExc_TypeError,
+                 "%s must hold native %s values",
+                 name,
+                 std::is_same<ScalarType, float>::value ? "float32" : "float64");
+    return false;
+  }
+  if (buffer.ndim != 2 || buffer.shape == nullptr || buffer.shape[1] != static_cast<Py_ssize_t>(Dimension))
+  {
+    PyErr_Format(PyExc_ValueError, "%s must have the shape (N, %u)", name, Dimension);
+    return false;
+  }
+  return true;
+}
+
+
+template <typename TTransform>
+PyObject *
+PyPolarTransformBuffer<TTransform>::_TransformPoints(const TransformType * transform,
+                                                     PyObject *            points,
+                                                     PyObject *            output)
+{
+  if (transform == nullptr)
+  {
+    PyErr_SetString(PyExc_ValueError, "Transform not set");
+    return nullptr;
+  }
+
+  Py_buffer inputBuffer;
+  if (PyObject_GetBuffer(points, &inputBuffer, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1)
+  {
+    return nullptr;
+  }
+  Py_buffer outputBuffer;
+  if (PyObject_GetBuffer(output, &outputBuffer, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE) == -1)
+  {
+    PyBuffer_Release(&inputBuffer);
+    return nullptr;
+  }
+
+  bool valid = CheckBuffer(inputBuffer, "points") && CheckBuffer(outputBuffer, "output");
+  if (valid && outputBuffer.shape[0] != inputBuffer.shape[0])
+  {
+    PyErr_SetString(PyExc_ValueError, "points and output must have the same shape");
+    valid = false;
+  }
+
+  // The batch TransformPoints() allows the output to be the input, but not to overlap it otherwise.
+  const auto * inputBegin = static_cast<const char *>(inputBuffer.buf);
+  const auto * outputBegin = static_cast<const char *>(outputBuffer.buf);
+  if (valid && inputBegin != outputBegin && inputBegin < outputBegin + outputBuffer.len &&
+      outputBegin < inputBegin + inputBuffer.len)
+  {
+    PyErr_SetString(PyExc_ValueError, "output must either be points or not overlap with it");
+    valid = false;
+  }
+  if (!valid)
+  {
+    PyBuffer_Release(&outputBuffer);
+    PyBuffer_Release(&inputBuffer);
+    return nullptr;
+  }
+
+  // Point<T, Dimension> has the layout of T[Dimension].
+  const auto *        inputPoints = static_cast<const InputPointType *>(inputBuffer.buf);
+  auto *              outputPoints = static_cast<OutputPointType *>(outputBuffer.buf);
+  const SizeValueType numberOfPoints = inputBuffer.shape[0];
+  const SizeValueType numberOfChunks = (numberOfPoints + ChunkSize - 1) / ChunkSize;
+  std::string         error;
+
+  Py_BEGIN_ALLOW_THREADS;
+  try
+  {
+    const auto transformChunk = [&](SizeValueType chunk) {
+      const SizeValueType first = chunk * ChunkSize;
+      transform->TransformPoints(
+        inputPoints + first, outputPoints + first, std::min(ChunkSize, numberOfPoints - first));
+    };
+    if (numberOfChunks > 1)
+    {
+      MultiThreaderBase::New()->ParallelizeArray(0, numberOfChunks, transformChunk, nullptr);
+    }
+    else if (numberOfChunks == 1)
+    {
+      transformChunk(0);
+    }
+  }
+  catch (const std::exception & exception)
+  {
+    error = exception.what();
+  }
+  Py_END_ALLOW_THREADS;
+
+  PyBuffer_Release(&outputBuffer);
+  PyBuffer_Release(&inputBuffer);
+
+  if (!error.empty())
+  {
+    PyErr_SetString(PyExc_RuntimeError, error.c_str());
+    return nullptr;
+  }
+  Py_RETURN_NONE;
+}
+
+} // namespace itk
+
+#endif
@@ -0,0 +1,284 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkSphericalToCartesianTransform_hxx
+#define itkSphericalToCartesianTransform_hxx
+
+#include "itkMath.h"
+#include "itkCartesianToSphericalTransform.h"
+#include <algorithm>
+#include <cmath>
+
+namespace itk
+{
+
+template <typename TParametersValueType, unsigned int NDimensions>
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::SphericalToCartesianTransform()
+  : Superclass(ParametersDimension)
+{
+  this->m_Center.Fill(0.0);
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Center: " << m_Center << std::endl;
+  os << indent << "AngleOffset: " << m_AngleOffset << std::endl;
+  os << indent << "ReturnNaN: " << (m_ReturnNaN ? "On" : "Off") << std::endl;
+  os << indent << "AngleEvaluation: " << m_AngleEvaluation << std::endl;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+typename SphericalToCartesianTransform<TParametersValueType, NDimensions>::OutputPointType
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::TransformPoint(
+  const InputPointType & inputPoint) const
+{
+  OutputPointType result = inputPoint;
+
+  if (m_AngleEvaluation == AngleEvaluationEnum::Approximate)
+  {
+    // the scalar pack of the batch kernel
+    using ScalarPackType = PolarTransformKernels::ScalarPack<ScalarType>;
+    const auto parameters = this->GetKernelParameters();
+    PolarTransformKernels::SphericalToCartesianBlock<ScalarPackType>(
+      &inputPoint[0], &inputPoint[1], &inputPoint[2], &result[0], &result[1], &result[2], 0, parameters);
+    return result;
+  }
+
+  const ScalarType azimuth = inputPoint[0];
+  const ScalarType elevation = inputPoint[1];
+  const ScalarType radius = inputPoint[2];
+
+  if (m_ReturnNaN && (azimuth < -Math::pi || Math::pi < azimuth || elevation < -Math::pi_over_2 ||
+                      Math::pi_over_2 < elevation))
+  {
+    result[0] = result[1] = result[2] = NumericTraits<ScalarType>::quiet_NaN();
+    return result;
+  }
+
+  const ScalarType rho = radius * std::cos(elevation); // distance from the axis
+  result[0] = m_Center[0] + rho * std::cos(azimuth + m_AngleOffset);
+  result[1] = m_Center[1] + rho * std::sin(azimuth + m_AngleOffset);
+  result[2] = m_Center[2] + radius * std::sin(elevation);
+  return result;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::ComputeJacobianWithRespectToPosition(
+  const InputPointType & point,
+  JacobianPositionType & jacobian) const
+{
+  jacobian.set_identity();
+
+  const ScalarType azimuth = point[0];
+  const ScalarType elevation = point[1];
+  const ScalarType radius = point[2];
+
+  if (m_ReturnNaN && (azimuth < -Math::pi || Math::pi < azimuth || elevation < -Math::pi_over_2 ||
+                      Math::pi_over_2 < elevation))
+  {
+    const ScalarType nan = NumericTraits<ScalarType>::quiet_NaN();
+    for (unsigned int r = 0; r < 3; ++r)
+    {
+      for (unsigned int c = 0; c < 3; ++c)
+      {
+        jacobian(r, c) = nan;
+      }
+    }
+    return;
+  }
+
+  const ScalarType cosAlpha = std::cos(azimuth + m_AngleOffset);
+  const ScalarType sinAlpha = std::sin(azimuth + m_AngleOffset);
+  const ScalarType cosTheta = std::cos(elevation);
+  const ScalarType sinTheta = std::sin(elevation);
+
+  jacobian(0, 0) = -radius * cosTheta * sinAlpha;
+  jacobian(0, 1) = -radius * sinTheta * cosAlpha;
+  jacobian(0, 2) = cosTheta * cosAlpha;
+  jacobian(1, 0) = radius * cosTheta * cosAlpha;
+  jacobian(1, 1) = -radius * sinTheta * sinAlpha;
+  jacobian(1, 2) = cosTheta * sinAlpha;
+  jacobian(2, 0) = 0.0;
+  jacobian(2, 1) = radius * cosTheta;
+  jacobian(2, 2) = sinTheta;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::ComputeInverseJacobianWithRespectToPosition(
+  const InputPointType &        point,
+  InverseJacobianPositionType & jacobian) const
+{
+  jacobian.set_identity();
+
+  const ScalarType azimuth = point[0];
+  const ScalarType elevation = point[1];
+  const ScalarType radius = point[2];
+
+  if (m_ReturnNaN && (azimuth < -Math::pi || Math::pi < azimuth || elevation < -Math::pi_over_2 ||
+                      Math::pi_over_2 < elevation))
+  {
+    const ScalarType nan = NumericTraits<ScalarType>::quiet_NaN();
+    for (unsigned int r = 0; r < 3; ++r)
+    {
+      for (unsigned int c = 0; c < 3; ++c)
+      {
+        jacobian(r, c) = nan;
+      }
+    }
+    return;
+  }
+
+  const ScalarType cosAlpha = std::cos(azimuth + m_AngleOffset);
+  const ScalarType sinAlpha = std::sin(azimuth + m_AngleOffset);
+  const ScalarType cosTheta = std::cos(elevation);
+  const ScalarType sinTheta = std::sin(elevation);
+
+  // the determinant of the forward Jacobian is -r^2 cos(theta)
+  jacobian(0, 0) = -sinAlpha / (radius * cosTheta);
+  jacobian(0, 1) = cosAlpha / (radius * cosTheta);
+  jacobian(0, 2) = 0.0;
+  jacobian(1, 0) = -sinTheta * cosAlpha / radius;
+  jacobian(1, 1) = -sinTheta * sinAlpha / radius;
+  jacobian(1, 2) = cosTheta / radius;
+  jacobian(2, 0) = cosTheta * cosAlpha;
+  jacobian(2, 1) = cosTheta * sinAlpha;
+  jacobian(2, 2) = sinTheta;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+bool
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::GetInverse(InverseTransformType * inverse) const
+{
+  if (!inverse)
+  {
+    return false;
+  }
+
+  inverse->SetCenter(m_Center);
+  inverse->SetAngleOffset(m_AngleOffset);
+  inverse->SetAngleEvaluation(m_AngleEvaluation);
+  return true;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::GetInverseTransform() const
+  -> InverseTransformBasePointer
+{
+  const auto inverse = InverseTransformType::New();
+  return this->GetInverse(inverse) ? inverse.GetPointer() : nullptr;
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::TransformPoints(const InputPointType * inputPoints,
+                                                                                  OutputPointType *      outputPoints,
+                                                                                  SizeValueType numberOfPoints) const
+{
+  constexpr SizeValueType BlockSize = 256;
+
+  ScalarType azimuth[BlockSize];
+  ScalarType elevation[BlockSize];
+  ScalarType radius[BlockSize];
+
+  const PolarTransformKernels::Parameters<ScalarType> parameters = this->GetKernelParameters();
+
+  for (SizeValueType begin = 0; begin < numberOfPoints; begin += BlockSize)
+  {
+    const SizeValueType count = std::min(BlockSize, numberOfPoints - begin);
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      azimuth[i] = inputPoints[begin + i][0];
+      elevation[i] = inputPoints[begin + i][1];
+      radius[i] = inputPoints[begin + i][2];
+    }
+
+    // in place: x, y and z replace azimuth, elevation and radius
+    PolarTransformKernels::SphericalToCartesian(
+      azimuth, elevation, radius, azimuth, elevation, radius, count, parameters);
+
+    for (SizeValueType i = 0; i < count; ++i)
+    {
+      OutputPointType & outputPoint = outputPoints[begin + i];
+      if (&outputPoint != &inputPoints[begin + i])
+      {
+        outputPoint = inputPoints[begin + i];
+      }
+      outputPoint[0] = azimuth[i];
+      outputPoint[1] = elevation[i];
+      outputPoint[2] = radius[i];
+    }
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const ScalarType * const * inputComponents,
+  ScalarType * const *       outputComponents,
+  SizeValueType              numberOfPoints) const
+{
+  PolarTransformKernels::SphericalToCartesian(inputComponents[0],
+                                              inputComponents[1],
+                                              inputComponents[2],
+                                              outputComponents[0],
+                                              outputComponents[1],
+                                              outputComponents[2],
+                                              numberOfPoints,
+                                              this->GetKernelParameters());
+
+  for (unsigned int d = 3; d < SpaceDimension; ++d)
+  {
+    if (outputComponents[d] != inputComponents[d])
+    {
+      std::copy_n(inputComponents[d], numberOfPoints, outputComponents[d]);
+    }
+  }
+}
+
+
+template <typename TParametersValueType, unsigned int NDimensions>
+auto
+SphericalToCartesianTransform<TParametersValueType, NDimensions>::GetKernelParameters() const
+  -> PolarTransformKernels::Parameters<ScalarType>
+{
+  PolarTransformKernels::Parameters<ScalarType> parameters;
+  parameters.CenterX = m_Center[0];
+  parameters.CenterY = m_Center[1];
+  parameters.CenterZ = m_Center[2];
+  parameters.AngleOffset = m_AngleOffset;
+  parameters.ExactAngles = m_AngleEvaluation != AngleEvaluationEnum::Approximate;
+  parameters.ReturnNaN = m_ReturnNaN;
+  return parameters;
+}
+
+} // namespace itk
+
+#endif
@@ -14,8 +14,11 @@ file(READ "${MY_CURRENT_DIR}/README.rst" DOCUMENTATION)
 itk_module(PolarTransform
   COMPILE_DEPENDS
     ITKTransform
+    ITKImageFunction
   TEST_DEPENDS
     ITKTestKernel
+    ITKImageFilterBase
+    ITKImageGrid
   DESCRIPTION
     "${DOCUMENTATION}"
   EXCLUDE_FROM_DEFAULT
@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkCartesianToPolarImageFilter.h"
+#include "itkPolarToCartesianTransform.h"
+#include "itkResampleImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+int
+itkCartesianToPolarImageFilterTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+  const double           epsilon = 1e-4;
+
+  using ImageType = itk::Image<float, Dimension>;
+  using FilterType = itk::CartesianToPolarImageFilter<ImageType, ImageType>;
+  using TransformType = itk::PolarToCartesianTransform<double, Dimension>;
+  using ResampleFilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+
+  /* Create a smooth cartesian test image. */
+  ImageType::SizeType size;
+  size[0] = 64;
+  size[1] = 48;
+  size[2] = 3;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(size));
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<float>(std::sin(0.2 * index[0]) * std::cos(0.15 * index[1]) + index[2]));
+  }
+
+  /* Polar output grid: full circle, radii staying inside the input. */
+  ImageType::SizeType polarSize;
+  polarSize[0] = 90;
+  polarSize[1] = 20;
+  polarSize[2] = size[2];
+
+  ImageType::SpacingType polarSpacing;
+  polarSpacing[0] = itk::Math::twopi / polarSize[0];
+  polarSpacing[1] = 1.0;
+  polarSpacing[2] = 1.0;
+
+  ImageType::PointType polarOrigin;
+  polarOrigin[0] = 0.0;
+  polarOrigin[1] = 0.5;
+  polarOrigin[2] = 0.0;
+
+  ImageType::PointType center;
+  center[0] = 31.5;
+  center[1] = 23.25;
+  center[2] = 0.0;
+
+  auto filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, CartesianToPolarImageFilter, ImageToImageFilter);
+
+  filter->SetInput(image);
+  filter->SetSize(polarSize);
+  filter->SetOutputSpacing(polarSpacing);
+  filter->SetOutputOrigin(polarOrigin);
+  filter->SetCenter(center);
+  ITK_TEST_SET_GET_VALUE(center, filter->GetCenter());
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseInPlaneMap, false);
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseTiledTraversal, false);
+  ITK_TEST_EXPECT_EQUAL(filter->GetTileCacheSize(), 512u * 1024u);
+
+  /* Tiles of a few pixels, so that the small test image is split into many of them. */
+  filter->SetTileCacheSize(256);
+  ITK_TEST_SET_GET_VALUE(256u, filter->GetTileCacheSize());
+
+  auto transform = TransformType::New();
+  transform->SetCenter(center);
+
+  auto resample = ResampleFilterType::New();
+  resample->SetInput(image);
+  resample->SetTransform(transform);
+  resample->SetSize(polarSize);
+  resample->SetOutputSpacing(polarSpacing);
+  resample->SetOutputOrigin(polarOrigin);
+
+  /* Compare with ResampleImageFilter for all combinations of options. */
+  using AngleEvaluationEnum = itk::PolarTransformEnums::AngleEvaluation;
+  ITK_TEST_EXPECT_EQUAL(filter->GetAngleEvaluation(), AngleEvaluationEnum::Incremental);
+  for (const auto angleEvaluation :
+       { AngleEvaluationEnum::Exact, AngleEvaluationEnum::Approximate, AngleEvaluationEnum::Incremental })
+  {
+    filter->SetAngleEvaluation(angleEvaluation);
+    for (const double angleOffset : { 0.0, 0.4 })
+    {
+      for (const bool constArcIncr : { false, true })
+      {
+        for (const bool useInPlaneMap : { false, true })
+        {
+          for (const bool useTiledTraversal : { false, true })
+          {
+            filter->SetUseInPlaneMap(useInPlaneMap);
+            filter->SetUseTiledTraversal(useTiledTraversal);
+            filter->SetAngleOffset(angleOffset);
+            filter->SetConstArcIncr(constArcIncr);
+            transform->SetAngleOffset(angleOffset);
+            transform->SetConstArcIncr(constArcIncr);
+            resample->Modified();
+
+            ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+            ITK_TRY_EXPECT_NO_EXCEPTION(resample->Update());
+
+            itk::ImageRegionConstIterator<ImageType> filterIt(filter->GetOutput(),
+                                                              filter->GetOutput()->GetLargestPossibleRegion());
+            itk::ImageRegionConstIterator<ImageType> resampleIt(resample->GetOutput(),
+                                                                resample->GetOutput()->GetLargestPossibleRegion());
+            for (; !filterIt.IsAtEnd(); ++filterIt, ++resampleIt)
+            {
+              if (itk::Math::abs(filterIt.Get() - resampleIt.Get()) > epsilon)
+              {
+                std::cout << "Mismatch with ResampleImageFilter at " << filterIt.GetIndex() << " (" << angleEvaluation
+                          << ", AngleOffset " << angleOffset << ", ConstArcIncr " << constArcIncr
+                          << ", UseInPlaneMap " << useInPlaneMap << ", UseTiledTraversal " << useTiledTraversal
+                          << "): " << filterIt.Get() << " != " << resampleIt.Get() << std::endl;
+                return EXIT_FAILURE;
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,450 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkLogPolarToCartesianTransform.h"
+#include "itkCartesianToLogPolarTransform.h"
+#include "itkCartesianToPolarImageFilter.h"
+#include "itkPolarToCartesianImageFilter.h"
+#include "itkResampleImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <vector>
+
+namespace
+{
+
+/* Compare the Jacobians with central differences, the batch paths with TransformPoint, and map back with the
+ * inverse transform. */
+template <typename TTransform>
+bool
+CheckTransform(const TTransform * transform, const std::vector<typename TTransform::InputPointType> & points)
+{
+  using InputPointType = typename TTransform::InputPointType;
+  using OutputPointType = typename TTransform::OutputPointType;
+  using ScalarType = typename TTransform::ScalarType;
+  constexpr unsigned int Dimension = TTransform::SpaceDimension;
+  const double           step = 1e-6;
+  const double           epsilon = 1e-5;
+
+  const auto inverse = transform->GetInverseTransform();
+  if (inverse.IsNull())
+  {
+    std::cout << transform->GetNameOfClass() << ": no inverse transform." << std::endl;
+    return false;
+  }
+
+  std::vector<OutputPointType> batch(points.size());
+  transform->TransformPoints(points.data(), batch.data(), static_cast<itk::SizeValueType>(points.size()));
+
+  std::vector<std::vector<ScalarType>> components(Dimension, std::vector<ScalarType>(points.size()));
+  const ScalarType *                   inputComponents[Dimension];
+  ScalarType *                         outputComponents[Dimension];
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      components[d][i] = points[i][d];
+    }
+    inputComponents[d] = components[d].data();
+    outputComponents[d] = components[d].data();
+  }
+  transform->TransformPoints(inputComponents, outputComponents, static_cast<itk::SizeValueType>(points.size()));
+
+  for (size_t p = 0; p < points.size(); ++p)
+  {
+    const InputPointType & point = points[p];
+    const OutputPointType  expected = transform->TransformPoint(point);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const double tolerance = 1e-11 * (1.0 + itk::Math::abs(expected[d]));
+      if (itk::Math::abs(batch[p][d] - expected[d]) > tolerance ||
+          itk::Math::abs(components[d][p] - expected[d]) > tolerance)
+      {
+        std::cout << transform->GetNameOfClass() << ": batch transform of " << point << " differs from "
+                  << expected << std::endl;
+        return false;
+      }
+    }
+
+    typename TTransform::JacobianPositionType jacobian;
+    transform->ComputeJacobianWithRespectToPosition(point, jacobian);
+    typename TTransform::InverseJacobianPositionType inverseJacobian;
+    transform->ComputeInverseJacobianWithRespectToPosition(point, inverseJacobian);
+
+    for (unsigned int j = 0; j < Dimension; ++j)
+    {
+      InputPointType forward = point;
+      InputPointType backward = point;
+      forward[j] += step;
+      backward[j] -= step;
+      const OutputPointType forwardPoint = transform->TransformPoint(forward);
+      const OutputPointType backwardPoint = transform->TransformPoint(backward);
+      for (unsigned int i = 0; i < Dimension; ++i)
+      {
+        const double numerical = (forwardPoint[i] - backwardPoint[i]) / (2.0 * step);
+        if (itk::Math::abs(numerical - jacobian(i, j)) > epsilon * (1.0 + itk::Math::abs(numerical)))
+        {
+          std::cout << transform->GetNameOfClass() << ": Jacobian(" << i << "," << j << ") at " << point
+                    << " is " << jacobian(i, j) << ", numerically " << numerical << std::endl;
+          return false;
+        }
+      }
+    }
+
+    const auto product = inverseJacobian * jacobian;
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      for (unsigned int j = 0; j < Dimension; ++j)
+      {
+        if (itk::Math::abs(product(i, j) - (i == j ? 1.0 : 0.0)) > 1e-9)
+        {
+          std::cout << transform->GetNameOfClass() << ": inverse Jacobian at " << point << " is not an inverse."
+                    << std::endl;
+          return false;
+        }
+      }
+    }
+
+    const InputPointType roundTrip = inverse->TransformPoint(expected);
+    if (point.EuclideanDistanceTo(roundTrip) > 1e-9 * (1.0 + point.GetVectorFromOrigin().GetNorm()))
+    {
+      std::cout << transform->GetNameOfClass() << ": inverse transform maps " << point << " to " << roundTrip
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/* The batch paths called through a pointer to the polar superclass must apply the log-polar mapping. */
+template <typename TTransform>
+bool
+CheckBatchThroughSuperclass(const TTransform *                                       transform,
+                            const std::vector<typename TTransform::InputPointType> & points)
+{
+  using OutputPointType = typename TTransform::OutputPointType;
+  using ScalarType = typename TTransform::ScalarType;
+  using SuperclassType = typename TTransform::Superclass;
+  constexpr unsigned int Dimension = TTransform::SpaceDimension;
+
+  const SuperclassType * polarTransform = transform;
+  const auto             numberOfPoints = static_cast<itk::SizeValueType>(points.size());
+
+  std::vector<OutputPointType> batch(points.size());
+  polarTransform->TransformPoints(points.data(), batch.data(), numberOfPoints);
+
+  std::vector<std::vector<ScalarType>> components(Dimension, std::vector<ScalarType>(points.size()));
+  const ScalarType *                   inputComponents[Dimension];
+  ScalarType *                         outputComponents[Dimension];
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      components[d][i] = points[i][d];
+    }
+    inputComponents[d] = components[d].data();
+    outputComponents[d] = components[d].data();
+  }
+  polarTransform->TransformPoints(inputComponents, outputComponents, numberOfPoints);
+
+  for (size_t p = 0; p < points.size(); ++p)
+  {
+    const OutputPointType expected = transform->TransformPoint(points[p]);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const double tolerance = 1e-11 * (1.0 + itk::Math::abs(expected[d]));
+      if (itk::Math::abs(batch[p][d] - expected[d]) > tolerance ||
+          itk::Math::abs(components[d][p] - expected[d]) > tolerance)
+      {
+        std::cout << transform->GetNameOfClass() << ": batch transform of " << points[p]
+                  << " through the superclass differs from " << expected << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+
+/* Compare two images where the reference is not the default value. */
+template <typename TImage>
+bool
+CompareImages(const TImage *                   image,
+              const TImage *                   reference,
+              const typename TImage::PixelType defaultValue,
+              const double                     epsilon,
+              const char *                     name)
+{
+  unsigned int                          numberOfCompared = 0;
+  itk::ImageRegionConstIterator<TImage> imageIt(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<TImage> referenceIt(reference, reference->GetLargestPossibleRegion());
+  for (; !imageIt.IsAtEnd(); ++imageIt, ++referenceIt)
+  {
+    if (itk::Math::ExactlyEquals(referenceIt.Get(), defaultValue))
+    {
+      continue;
+    }
+    ++numberOfCompared;
+    if (itk::Math::abs(imageIt.Get() - referenceIt.Get()) > epsilon)
+    {
+      std::cout << name << ": mismatch with ResampleImageFilter at " << imageIt.GetIndex() << ": " << imageIt.Get()
+                << " != " << referenceIt.Get() << std::endl;
+      return false;
+    }
+  }
+  if (numberOfCompared == 0)
+  {
+    std::cout << name << ": no pixel to compare." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkLogPolarTransformTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using LP2CTransformType = itk::LogPolarToCartesianTransform<double, Dimension>;
+  using C2LPTransformType = itk::CartesianToLogPolarTransform<double, Dimension>;
+  using PointType = itk::Point<double, Dimension>;
+
+  auto lp2c = LP2CTransformType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(lp2c, LogPolarToCartesianTransform, PolarToCartesianTransform);
+  auto c2lp = C2LPTransformType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(c2lp, CartesianToLogPolarTransform, CartesianToPolarTransform);
+
+  PointType center;
+  center[0] = 1.0;
+  center[1] = 2.0;
+  center[2] = 0.0;
+  lp2c->SetCenter(center);
+  c2lp->SetCenter(center);
+
+  /* Known values: radius 3 straight up from the center. */
+  PointType logPolarPoint;
+  logPolarPoint[0] = itk::Math::pi_over_2;
+  logPolarPoint[1] = std::log(3.0);
+  logPolarPoint[2] = 5.0;
+  PointType cartesianPoint;
+  cartesianPoint[0] = 1.0;
+  cartesianPoint[1] = 5.0;
+  cartesianPoint[2] = 5.0;
+  ITK_TEST_EXPECT_TRUE(lp2c->TransformPoint(logPolarPoint).EuclideanDistanceTo(cartesianPoint) < 1e-12);
+  ITK_TEST_EXPECT_TRUE(c2lp->TransformPoint(cartesianPoint).EuclideanDistanceTo(logPolarPoint) < 1e-12);
+
+  /* A scaling around the center is a shift along rho. */
+  PointType scaledPoint = cartesianPoint;
+  scaledPoint[0] = center[0] + 2.0 * (cartesianPoint[0] - center[0]);
+  scaledPoint[1] = center[1] + 2.0 * (cartesianPoint[1] - center[1]);
+  ITK_TEST_EXPECT_TRUE(itk::Math::abs(c2lp->TransformPoint(scaledPoint)[1] - logPolarPoint[1] - std::log(2.0)) <
+                       1e-12);
+
+  /* Log-polar points with angles in [0,2*pi), where the inverse maps back. */
+  std::vector<PointType> logPolarPoints;
+  for (unsigned int i = 0; i < 12; ++i)
+  {
+    for (unsigned int j = 0; j < 6; ++j)
+    {
+      PointType p;
+      p[0] = 0.1 + 0.5 * i;
+      p[1] = -1.0 + 0.7 * j;
+      p[2] = 0.5 * j;
+      logPolarPoints.push_back(p);
+    }
+  }
+
+  for (const double angleOffset : { 0.0, 0.3 })
+  {
+    for (const bool constArcIncr : { false, true })
+    {
+      lp2c->SetAngleOffset(angleOffset);
+      lp2c->SetConstArcIncr(constArcIncr);
+      c2lp->SetAngleOffset(angleOffset);
+      c2lp->SetConstArcIncr(constArcIncr);
+
+      auto inverse = C2LPTransformType::New();
+      ITK_TEST_EXPECT_TRUE(lp2c->GetInverse(inverse));
+      ITK_TEST_EXPECT_EQUAL(inverse->GetConstArcIncr(), constArcIncr);
+
+      std::vector<PointType> lp2cPoints;
+      std::vector<PointType> c2lpPoints;
+      for (const PointType & polarPoint : logPolarPoints)
+      {
+        PointType point = polarPoint;
+        if (constArcIncr)
+        {
+          point[0] *= std::exp(point[1]);
+        }
+        lp2cPoints.push_back(point);
+        c2lpPoints.push_back(lp2c->TransformPoint(point));
+      }
+
+      if (!CheckTransform(lp2c.GetPointer(), lp2cPoints) || !CheckTransform(c2lp.GetPointer(), c2lpPoints) ||
+          !CheckBatchThroughSuperclass(lp2c.GetPointer(), lp2cPoints) ||
+          !CheckBatchThroughSuperclass(c2lp.GetPointer(), c2lpPoints))
+      {
+        std::cout << "AngleOffset " << angleOffset << ", ConstArcIncr " << constArcIncr << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  /* The filters in LogPolar mode match ResampleImageFilter driven by the log-polar transforms. */
+  using ImageType = itk::Image<float, Dimension>;
+  using C2PFilterType = itk::CartesianToPolarImageFilter<ImageType, ImageType>;
+  using P2CFilterType = itk::PolarToCartesianImageFilter<ImageType, ImageType>;
+  using ResampleFilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+  const double epsilon = 1e-4;
+  const float  defaultValue = -1000.0f;
+
+  ImageType::SizeType size;
+  size[0] = 64;
+  size[1] = 48;
+  size[2] = 2;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(size));
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<float>(std::sin(0.2 * index[0]) * std::cos(0.15 * index[1]) + index[2]));
+  }
+
+  /* log(radius) from 0 to about 3, radius 1 to 20. */
+  ImageType::SizeType logPolarSize;
+  logPolarSize[0] = 90;
+  logPolarSize[1] = 30;
+  logPolarSize[2] = size[2];
+
+  ImageType::SpacingType logPolarSpacing;
+  logPolarSpacing[0] = itk::Math::twopi / logPolarSize[0];
+  logPolarSpacing[1] = 0.1;
+  logPolarSpacing[2] = 1.0;
+
+  ImageType::PointType logPolarOrigin;
+  logPolarOrigin[0] = 0.0;
+  logPolarOrigin[1] = 0.0;
+  logPolarOrigin[2] = 0.0;
+
+  PointType imageCenter;
+  imageCenter[0] = 31.5;
+  imageCenter[1] = 23.25;
+  imageCenter[2] = 0.0;
+
+  auto c2pFilter = C2PFilterType::New();
+  c2pFilter->SetInput(image);
+  c2pFilter->SetSize(logPolarSize);
+  c2pFilter->SetOutputSpacing(logPolarSpacing);
+  c2pFilter->SetOutputOrigin(logPolarOrigin);
+  c2pFilter->SetCenter(imageCenter);
+  c2pFilter->SetDefaultPixelValue(defaultValue);
+  ITK_TEST_SET_GET_BOOLEAN(c2pFilter, LogPolar, false);
+  c2pFilter->LogPolarOn();
+
+  auto lp2cImageTransform = LP2CTransformType::New();
+  lp2cImageTransform->SetCenter(imageCenter);
+
+  auto c2pResample = ResampleFilterType::New();
+  c2pResample->SetInput(image);
+  c2pResample->SetTransform(lp2cImageTransform);
+  c2pResample->SetSize(logPolarSize);
+  c2pResample->SetOutputSpacing(logPolarSpacing);
+  c2pResample->SetOutputOrigin(logPolarOrigin);
+  c2pResample->SetDefaultPixelValue(defaultValue);
+
+  /* The log-polar image of the first filter goes back to cartesian around the center. */
+  ImageType::PointType cartesianOrigin;
+  cartesianOrigin[0] = imageCenter[0] - 25.0;
+  cartesianOrigin[1] = imageCenter[1] - 20.0;
+  cartesianOrigin[2] = 0.0;
+
+  ImageType::SpacingType cartesianSpacing;
+  cartesianSpacing.Fill(1.0);
+
+  ImageType::SizeType cartesianSize;
+  cartesianSize[0] = 50;
+  cartesianSize[1] = 40;
+  cartesianSize[2] = size[2];
+
+  auto p2cFilter = P2CFilterType::New();
+  p2cFilter->SetInput(c2pResample->GetOutput());
+  p2cFilter->SetSize(cartesianSize);
+  p2cFilter->SetOutputSpacing(cartesianSpacing);
+  p2cFilter->SetOutputOrigin(cartesianOrigin);
+  p2cFilter->SetCenter(imageCenter);
+  p2cFilter->SetDefaultPixelValue(defaultValue);
+  ITK_TEST_SET_GET_BOOLEAN(p2cFilter, LogPolar, false);
+  p2cFilter->LogPolarOn();
+
+  auto c2lpImageTransform = C2LPTransformType::New();
+  c2lpImageTransform->SetCenter(imageCenter);
+
+  auto p2cResample = ResampleFilterType::New();
+  p2cResample->SetInput(c2pResample->GetOutput());
+  p2cResample->SetTransform(c2lpImageTransform);
+  p2cResample->SetSize(cartesianSize);
+  p2cResample->SetOutputSpacing(cartesianSpacing);
+  p2cResample->SetOutputOrigin(cartesianOrigin);
+  p2cResample->SetDefaultPixelValue(defaultValue);
+
+  for (const double angleOffset : { 0.0, 0.4 })
+  {
+    for (const bool constArcIncr : { false, true })
+    {
+      for (const bool useInPlaneMap : { false, true })
+      {
+        c2pFilter->SetAngleOffset(angleOffset);
+        c2pFilter->SetConstArcIncr(constArcIncr);
+        c2pFilter->SetUseInPlaneMap(useInPlaneMap);
+        p2cFilter->SetAngleOffset(angleOffset);
+        p2cFilter->SetConstArcIncr(constArcIncr);
+        p2cFilter->SetUseInPlaneMap(useInPlaneMap);
+        lp2cImageTransform->SetAngleOffset(angleOffset);
+        lp2cImageTransform->SetConstArcIncr(constArcIncr);
+        c2lpImageTransform->SetAngleOffset(angleOffset);
+        c2lpImageTransform->SetConstArcIncr(constArcIncr);
+        c2pResample->Modified();
+        p2cResample->Modified();
+
+        ITK_TRY_EXPECT_NO_EXCEPTION(c2pFilter->Update());
+        ITK_TRY_EXPECT_NO_EXCEPTION(c2pResample->Update());
+        ITK_TRY_EXPECT_NO_EXCEPTION(p2cFilter->Update());
+        ITK_TRY_EXPECT_NO_EXCEPTION(p2cResample->Update());
+
+        if (!CompareImages<ImageType>(
+              c2pFilter->GetOutput(), c2pResample->GetOutput(), defaultValue, epsilon, "CartesianToPolarImageFilter") ||
+            !CompareImages<ImageType>(
+              p2cFilter->GetOutput(), p2cResample->GetOutput(), defaultValue, epsilon, "PolarToCartesianImageFilter"))
+        {
+          std::cout << "AngleOffset " << angleOffset << ", ConstArcIncr " << constArcIncr << ", UseInPlaneMap "
+                    << useInPlaneMap << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,298 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkAffineCartesianToPolarTransform.h"
+#include "itkPolarToCartesianAffineTransform.h"
+#include "itkCartesianToLogPolarTransform.h"
+#include "itkAffineTransform.h"
+#include "itkTranslationTransform.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <vector>
+
+namespace
+{
+
+/* Whether the values agree within epsilon relative to the expected value. */
+bool
+AreClose(const double value, const double expected, const double epsilon)
+{
+  return itk::Math::abs(value - expected) <= epsilon * (1.0 + itk::Math::abs(expected));
+}
+
+/* Compare a fused transform with the CompositeTransform it collapses: TransformPoint(), both batch layouts in
+ * place, and the Jacobian. The batch paths are called through the polar superclass, which must not drop the affine
+ * mapping. */
+template <typename TFused, typename TComposite>
+int
+CompareWithComposite(const TFused *                                       fused,
+                     const TComposite *                                   composite,
+                     const std::vector<typename TFused::InputPointType> & points,
+                     const double                                         epsilon)
+{
+  using PointType = typename TFused::OutputPointType;
+  using ScalarType = typename TFused::ScalarType;
+  constexpr unsigned int Dimension = TFused::SpaceDimension;
+
+  const typename TFused::Superclass * polarTransform = fused;
+  const auto                          numberOfPoints = static_cast<itk::SizeValueType>(points.size());
+
+  std::vector<PointType> batch(points);
+  polarTransform->TransformPoints(batch.data(), batch.data(), numberOfPoints);
+
+  std::vector<std::vector<ScalarType>> components(Dimension, std::vector<ScalarType>(points.size()));
+  const ScalarType *                   inputComponents[Dimension];
+  ScalarType *                         outputComponents[Dimension];
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      components[d][i] = points[i][d];
+    }
+    inputComponents[d] = components[d].data();
+    outputComponents[d] = components[d].data();
+  }
+  polarTransform->TransformPoints(inputComponents, outputComponents, numberOfPoints);
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const PointType expected = composite->TransformPoint(points[i]);
+    const PointType result = fused->TransformPoint(points[i]);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      if (!AreClose(result[d], expected[d], epsilon) || !AreClose(batch[i][d], expected[d], epsilon) ||
+          !AreClose(components[d][i], expected[d], epsilon))
+      {
+        std::cout << fused->GetNameOfClass() << ": " << points[i] << " maps to " << result[d] << " / " << batch[i][d]
+                  << " / " << components[d][i] << " in dimension " << d << " instead of " << expected[d]
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    typename TFused::JacobianPositionType expectedJacobian;
+    composite->ComputeJacobianWithRespectToPosition(points[i], expectedJacobian);
+    typename TFused::JacobianPositionType jacobian;
+    fused->ComputeJacobianWithRespectToPosition(points[i], jacobian);
+    typename TFused::InverseJacobianPositionType inverseJacobian;
+    fused->ComputeInverseJacobianWithRespectToPosition(points[i], inverseJacobian);
+    const auto product = inverseJacobian * jacobian;
+    for (unsigned int r = 0; r < Dimension; ++r)
+    {
+      for (unsigned int c = 0; c < Dimension; ++c)
+      {
+        if (!AreClose(jacobian(r, c), expectedJacobian(r, c), epsilon) ||
+            !AreClose(product(r, c), r == c ? 1.0 : 0.0, epsilon))
+        {
+          std::cout << fused->GetNameOfClass() << ": Jacobian at " << points[i] << " is " << jacobian
+                    << " instead of " << expectedJacobian << ", inverse times Jacobian " << product << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/* Two affine alignments, a polar transform with each option, and the fused transforms collapsing them. */
+template <typename TScalar, unsigned int VDimension>
+int
+TestFusedTransforms(const double epsilon)
+{
+  using C2PTransformType = itk::CartesianToPolarTransform<TScalar, VDimension>;
+  using P2CTransformType = itk::PolarToCartesianTransform<TScalar, VDimension>;
+  using FusedC2PTransformType = itk::AffineCartesianToPolarTransform<TScalar, VDimension>;
+  using FusedP2CTransformType = itk::PolarToCartesianAffineTransform<TScalar, VDimension>;
+  using CompositeTransformType = itk::CompositeTransform<TScalar, VDimension>;
+  using AffineTransformType = itk::AffineTransform<TScalar, VDimension>;
+  using PointType = itk::Point<TScalar, VDimension>;
+
+  auto rigid = AffineTransformType::New();
+  rigid->Rotate(0, 1, 0.4);
+  typename AffineTransformType::OutputVectorType translation;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    translation[d] = 1.25 - 0.75 * d;
+  }
+  rigid->Translate(translation);
+  auto affine = AffineTransformType::New();
+  affine->Shear(0, 1, 0.2);
+  affine->Scale(0.9);
+  if (VDimension > 2)
+  {
+    affine->Rotate(1, VDimension - 1, -0.3);
+  }
+
+  PointType center;
+  center.Fill(0.0);
+  center[0] = 1.5;
+  center[1] = -2.0;
+
+  /* Points on a lattice that does not come close to the center after the alignment. */
+  std::vector<PointType> cartesianPoints;
+  std::vector<PointType> polarPoints;
+  for (unsigned int i = 0; i < 23; ++i)
+  {
+    for (unsigned int j = 0; j < 19; ++j)
+    {
+      PointType p;
+      p.Fill(static_cast<TScalar>(0.5 + 0.1 * i));
+      p[0] = -14.13 + 1.27 * i;
+      p[1] = -11.71 + 1.31 * j;
+      cartesianPoints.push_back(p);
+      p[0] = -3.0 + 0.271 * i;
+      p[1] = 0.5 + 0.97 * j;
+      polarPoints.push_back(p);
+    }
+  }
+
+  auto c2p = C2PTransformType::New();
+  c2p->SetCenter(center);
+  c2p->SetAngleOffset(0.3);
+  auto c2pComposite = CompositeTransformType::New();
+  c2pComposite->AddTransform(c2p);
+  c2pComposite->AddTransform(affine);
+  c2pComposite->AddTransform(rigid);
+
+  auto p2c = P2CTransformType::New();
+  p2c->SetCenter(center);
+  p2c->SetAngleOffset(0.3);
+  auto p2cComposite = CompositeTransformType::New();
+  p2cComposite->AddTransform(rigid);
+  p2cComposite->AddTransform(affine);
+  p2cComposite->AddTransform(p2c);
+
+  auto fusedC2P = FusedC2PTransformType::New();
+  auto fusedP2C = FusedP2CTransformType::New();
+
+  for (const bool constArcIncr : { false, true })
+  {
+    c2p->SetConstArcIncr(constArcIncr);
+    ITK_TEST_EXPECT_TRUE(fusedC2P->SetFromCompositeTransform(c2pComposite));
+    ITK_TEST_EXPECT_EQUAL(fusedC2P->GetConstArcIncr(), constArcIncr);
+    if (CompareWithComposite(fusedC2P.GetPointer(), c2pComposite.GetPointer(), cartesianPoints, epsilon) ==
+        EXIT_FAILURE)
+    {
+      return EXIT_FAILURE;
+    }
+
+    p2c->SetConstArcIncr(constArcIncr);
+    ITK_TEST_EXPECT_TRUE(fusedP2C->SetFromCompositeTransform(p2cComposite));
+    ITK_TEST_EXPECT_EQUAL(fusedP2C->GetConstArcIncr(), constArcIncr);
+    if (CompareWithComposite(fusedP2C.GetPointer(), p2cComposite.GetPointer(), polarPoints, epsilon) == EXIT_FAILURE)
+    {
+      return EXIT_FAILURE;
+    }
+
+    /* The inverses map the points back. */
+    const auto inverseC2P = fusedC2P->GetInverseTransform();
+    const auto inverseP2C = fusedP2C->GetInverseTransform();
+    ITK_TEST_EXPECT_TRUE(inverseC2P != nullptr && inverseP2C != nullptr);
+    for (const auto & point : cartesianPoints)
+    {
+      const PointType viaC2P = inverseC2P->TransformPoint(fusedC2P->TransformPoint(point));
+      const PointType viaP2C = fusedP2C->TransformPoint(inverseP2C->TransformPoint(point));
+      for (unsigned int d = 0; d < VDimension; ++d)
+      {
+        ITK_TEST_EXPECT_TRUE(AreClose(viaC2P[d], point[d], 100 * epsilon));
+        ITK_TEST_EXPECT_TRUE(AreClose(viaP2C[d], point[d], 100 * epsilon));
+      }
+    }
+  }
+
+  /* The bounding boxes contain the mapped points of the boxes. */
+  PointType minimum = cartesianPoints.front();
+  PointType maximum = cartesianPoints.back();
+  PointType outputMinimum;
+  PointType outputMaximum;
+  fusedC2P->ComputeOutputBoundingBox(minimum, maximum, outputMinimum, outputMaximum);
+  for (const auto & point : cartesianPoints)
+  {
+    const PointType mapped = fusedC2P->TransformPoint(point);
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      ITK_TEST_EXPECT_TRUE(outputMinimum[d] - epsilon <= mapped[d] && mapped[d] <= outputMaximum[d] + epsilon);
+    }
+  }
+  minimum = polarPoints.front();
+  maximum = polarPoints.back();
+  fusedP2C->ComputeOutputBoundingBox(minimum, maximum, outputMinimum, outputMaximum);
+  for (const auto & point : polarPoints)
+  {
+    const PointType mapped = fusedP2C->TransformPoint(point);
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      ITK_TEST_EXPECT_TRUE(outputMinimum[d] - 1e3 * epsilon <= mapped[d] &&
+                           mapped[d] <= outputMaximum[d] + 1e3 * epsilon);
+    }
+  }
+
+  /* Composites of another structure are not collapsed and leave the transform unchanged. */
+  const auto matrix = fusedC2P->GetMatrix();
+  ITK_TEST_EXPECT_TRUE(!fusedC2P->SetFromCompositeTransform(p2cComposite));
+  ITK_TEST_EXPECT_TRUE(!fusedP2C->SetFromCompositeTransform(c2pComposite));
+  ITK_TEST_EXPECT_TRUE(!fusedC2P->SetFromCompositeTransform(CompositeTransformType::New()));
+  ITK_TEST_EXPECT_TRUE(!fusedC2P->SetFromCompositeTransform(nullptr));
+
+  auto logPolarComposite = CompositeTransformType::New();
+  logPolarComposite->AddTransform(itk::CartesianToLogPolarTransform<TScalar, VDimension>::New());
+  logPolarComposite->AddTransform(rigid);
+  ITK_TEST_EXPECT_TRUE(!fusedC2P->SetFromCompositeTransform(logPolarComposite));
+
+  auto translationComposite = CompositeTransformType::New();
+  translationComposite->AddTransform(c2p);
+  translationComposite->AddTransform(itk::TranslationTransform<TScalar, VDimension>::New());
+  ITK_TEST_EXPECT_TRUE(!fusedC2P->SetFromCompositeTransform(translationComposite));
+  ITK_TEST_EXPECT_EQUAL(fusedC2P->GetMatrix(), matrix);
+
+  /* A singular matrix has no inverse. */
+  typename FusedC2PTransformType::MatrixType singular;
+  singular.Fill(1.0);
+  fusedC2P->SetMatrix(singular);
+  ITK_TEST_EXPECT_TRUE(fusedC2P->GetInverseTransform() == nullptr);
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkPolarAffineTransformTest(int, char *[])
+{
+  auto fusedC2P = itk::AffineCartesianToPolarTransform<double, 3>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(fusedC2P, AffineCartesianToPolarTransform, CartesianToPolarTransform);
+  auto fusedP2C = itk::PolarToCartesianAffineTransform<double, 3>::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(fusedP2C, PolarToCartesianAffineTransform, PolarToCartesianTransform);
+
+  /* The defaults are the identity alignment. */
+  itk::AffineCartesianToPolarTransform<double, 3>::MatrixType identity;
+  identity.SetIdentity();
+  ITK_TEST_EXPECT_EQUAL(fusedC2P->GetMatrix(), identity);
+  ITK_TEST_EXPECT_EQUAL(fusedP2C->GetMatrix(), identity);
+  itk::AffineCartesianToPolarTransform<double, 3>::OffsetType offset;
+  offset.Fill(0.5);
+  fusedC2P->SetOffset(offset);
+  ITK_TEST_SET_GET_VALUE(offset, fusedC2P->GetOffset());
+
+  if (TestFusedTransforms<double, 3>(1e-9) == EXIT_FAILURE || TestFusedTransforms<double, 2>(1e-9) == EXIT_FAILURE ||
+      TestFusedTransforms<float, 2>(1e-4) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
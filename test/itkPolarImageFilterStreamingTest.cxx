@@ -0,0 +1,273 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkCartesianToPolarImageFilter.h"
+#include "itkPolarToCartesianImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionSplitterMultidimensional.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+
+/* The bounding box of a transform contains the images of the points of a fine grid in the input box. */
+template <typename TTransform>
+bool
+CheckBoundingBox(const TTransform *                          transform,
+                 const typename TTransform::InputPointType & minimum,
+                 const typename TTransform::InputPointType & maximum)
+{
+  typename TTransform::OutputPointType boxMinimum;
+  typename TTransform::OutputPointType boxMaximum;
+  transform->ComputeOutputBoundingBox(minimum, maximum, boxMinimum, boxMaximum);
+
+  constexpr unsigned int Steps = 200;
+  for (unsigned int i = 0; i <= Steps; ++i)
+  {
+    for (unsigned int j = 0; j <= Steps; ++j)
+    {
+      typename TTransform::InputPointType point;
+      point[0] = minimum[0] + (maximum[0] - minimum[0]) * i / Steps;
+      point[1] = minimum[1] + (maximum[1] - minimum[1]) * j / Steps;
+      const auto mapped = transform->TransformPoint(point);
+      for (unsigned int d = 0; d < Dimension; ++d)
+      {
+        if (mapped[d] < boxMinimum[d] - 1e-9 || mapped[d] > boxMaximum[d] + 1e-9)
+        {
+          std::cout << transform->GetNameOfClass() << ": " << point << " maps to " << mapped << ", outside of "
+                    << boxMinimum << " - " << boxMaximum << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+/* Stream the filter in tiles behind a filter that only produces the requested input region. Every tile must
+ * match the unstreamed output, and the last tile must not need the whole input. */
+template <typename TFilter>
+bool
+CheckStreaming(TFilter * filter, const ImageType * input)
+{
+  const double epsilon = 1e-4;
+
+  filter->SetInput(input);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->UpdateLargestPossibleRegion());
+  const ImageType::Pointer reference = filter->GetOutput();
+  reference->DisconnectPipeline();
+
+  auto cast = itk::CastImageFilter<ImageType, ImageType>::New();
+  cast->SetInput(input);
+  cast->InPlaceOff();
+  filter->SetInput(cast->GetOutput());
+
+  auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+  streamer->SetInput(filter->GetOutput());
+  streamer->SetRegionSplitter(itk::ImageRegionSplitterMultidimensional::New());
+  streamer->SetNumberOfStreamDivisions(16);
+  ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+  itk::ImageRegionConstIterator<ImageType> it(streamer->GetOutput(), reference->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> referenceIt(reference, reference->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it, ++referenceIt)
+  {
+    if (itk::Math::abs(it.Get() - referenceIt.Get()) > epsilon)
+    {
+      std::cout << filter->GetNameOfClass() << ": streamed output at " << it.GetIndex() << " is " << it.Get()
+                << " instead of " << referenceIt.Get() << std::endl;
+      return false;
+    }
+  }
+
+  const itk::SizeValueType lastTileInputPixels = cast->GetOutput()->GetBufferedRegion().GetNumberOfPixels();
+  if (lastTileInputPixels >= input->GetLargestPossibleRegion().GetNumberOfPixels())
+  {
+    std::cout << filter->GetNameOfClass() << ": the last tile requested the whole input." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+/* Create a smooth test image. */
+ImageType::Pointer
+CreateImage(const ImageType::SizeType &    size,
+            const ImageType::SpacingType & spacing,
+            const ImageType::PointType &   origin)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(size));
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<float>(std::sin(0.2 * index[0]) * std::cos(0.15 * index[1]) + 0.01 * index[1]));
+  }
+  return image;
+}
+
+} // namespace
+
+int
+itkPolarImageFilterStreamingTest(int, char *[])
+{
+  using C2PFilterType = itk::CartesianToPolarImageFilter<ImageType, ImageType>;
+  using P2CFilterType = itk::PolarToCartesianImageFilter<ImageType, ImageType>;
+  using P2CTransformType = itk::PolarToCartesianTransform<double, Dimension>;
+  using C2PTransformType = itk::CartesianToPolarTransform<double, Dimension>;
+  using PointType = itk::Point<double, Dimension>;
+
+  PointType center;
+  center[0] = 31.5;
+  center[1] = 23.25;
+
+  /* Bounding boxes: sectors wrapping around 2*pi, negative radii, boxes around and beside the center. */
+  auto p2c = P2CTransformType::New();
+  auto c2p = C2PTransformType::New();
+  p2c->SetCenter(center);
+  c2p->SetCenter(center);
+  for (const double angleOffset : { 0.0, 0.4 })
+  {
+    for (const bool constArcIncr : { false, true })
+    {
+      p2c->SetAngleOffset(angleOffset);
+      p2c->SetConstArcIncr(constArcIncr);
+      c2p->SetAngleOffset(angleOffset);
+      c2p->SetConstArcIncr(constArcIncr);
+
+      const double polarBoxes[][4] = { { 5.5, 2.0, 7.5, 10.0 }, { -1.0, -3.0, 1.0, 4.0 }, { -20.0, 5.0, 30.0, 12.0 } };
+      for (const auto & box : polarBoxes)
+      {
+        const PointType minimum = itk::MakePoint(box[0], box[1]);
+        const PointType maximum = itk::MakePoint(box[2], box[3]);
+        if (!CheckBoundingBox(p2c.GetPointer(), minimum, maximum))
+        {
+          return EXIT_FAILURE;
+        }
+      }
+
+      const double cartesianBoxes[][4] = { { 1.0, -4.0, 3.0, -1.0 },
+                                           { -2.0, -1.0, 3.0, 2.0 },
+                                           { 2.0, -1.0, 4.0, 1.0 } };
+      for (const auto & box : cartesianBoxes)
+      {
+        const PointType minimum = itk::MakePoint(center[0] + box[0], center[1] + box[1]);
+        const PointType maximum = itk::MakePoint(center[0] + box[2], center[1] + box[3]);
+        if (!CheckBoundingBox(c2p.GetPointer(), minimum, maximum))
+        {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  /* A box beside the center needs a sector only, one crossing the angle where alpha wraps needs [0,2*pi]. */
+  c2p->SetAngleOffset(0.0);
+  c2p->SetConstArcIncr(false);
+  PointType polarMinimum;
+  PointType polarMaximum;
+  c2p->ComputeOutputBoundingBox(itk::MakePoint(center[0] - 1.0, center[1] + 2.0),
+                                itk::MakePoint(center[0] + 1.0, center[1] + 4.0),
+                                polarMinimum,
+                                polarMaximum);
+  ITK_TEST_EXPECT_TRUE(polarMinimum[0] > 1.0 && polarMaximum[0] < 2.2);
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(polarMinimum[1], 2.0));
+  c2p->ComputeOutputBoundingBox(itk::MakePoint(center[0] + 2.0, center[1] - 1.0),
+                                itk::MakePoint(center[0] + 4.0, center[1] + 1.0),
+                                polarMinimum,
+                                polarMaximum);
+  ITK_TEST_EXPECT_EQUAL(polarMinimum[0], 0.0);
+  ITK_TEST_EXPECT_TRUE(itk::Math::FloatAlmostEqual(polarMaximum[0], itk::Math::twopi));
+
+  /* Cartesian input of CartesianToPolarImageFilter. */
+  ImageType::SizeType cartesianSize;
+  cartesianSize[0] = 64;
+  cartesianSize[1] = 48;
+  ImageType::SpacingType cartesianSpacing;
+  cartesianSpacing.Fill(1.0);
+  ImageType::PointType cartesianOrigin;
+  cartesianOrigin.Fill(0.0);
+  const ImageType::Pointer cartesianImage = CreateImage(cartesianSize, cartesianSpacing, cartesianOrigin);
+
+  /* Polar input of PolarToCartesianImageFilter covering [-pi,pi), so that samples are retried a period away. */
+  ImageType::SizeType polarSize;
+  polarSize[0] = 128;
+  polarSize[1] = 30;
+
+  for (const double angleOffset : { 0.0, 0.4 })
+  {
+    for (const bool constArcIncr : { false, true })
+    {
+      auto c2pFilter = C2PFilterType::New();
+
+      ImageType::SpacingType outputSpacing;
+      outputSpacing[0] = constArcIncr ? 0.5 : itk::Math::twopi / 96;
+      outputSpacing[1] = 1.0;
+      ImageType::PointType outputOrigin;
+      outputOrigin[0] = 0.0;
+      outputOrigin[1] = 0.5;
+      ImageType::SizeType outputSize;
+      outputSize[0] = 96;
+      outputSize[1] = 28;
+      c2pFilter->SetSize(outputSize);
+      c2pFilter->SetOutputSpacing(outputSpacing);
+      c2pFilter->SetOutputOrigin(outputOrigin);
+      c2pFilter->SetCenter(center);
+      c2pFilter->SetAngleOffset(angleOffset);
+      c2pFilter->SetConstArcIncr(constArcIncr);
+      c2pFilter->SetDefaultPixelValue(-1.0f);
+
+      const double           maximumRadius = static_cast<double>(polarSize[1]);
+      ImageType::SpacingType polarSpacing;
+      polarSpacing[0] = itk::Math::twopi * (constArcIncr ? maximumRadius : 1.0) / polarSize[0];
+      polarSpacing[1] = 1.0;
+      ImageType::PointType polarOrigin;
+      polarOrigin[0] = -itk::Math::pi * (constArcIncr ? maximumRadius : 1.0);
+      polarOrigin[1] = 0.0;
+      const ImageType::Pointer polarImage = CreateImage(polarSize, polarSpacing, polarOrigin);
+
+      auto p2cFilter = P2CFilterType::New();
+      p2cFilter->SetSize(cartesianSize);
+      p2cFilter->SetOutputSpacing(cartesianSpacing);
+      p2cFilter->SetOutputOrigin(cartesianOrigin);
+      p2cFilter->SetCenter(center);
+      p2cFilter->SetAngleOffset(angleOffset);
+      p2cFilter->SetConstArcIncr(constArcIncr);
+      p2cFilter->SetDefaultPixelValue(-1.0f);
+
+      if (!CheckStreaming(c2pFilter.GetPointer(), cartesianImage) ||
+          !CheckStreaming(p2cFilter.GetPointer(), polarImage))
+      {
+        std::cout << "AngleOffset " << angleOffset << ", ConstArcIncr " << constArcIncr << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,142 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolarMappingFunctors.h"
+#include "itkPolarToCartesianTransform.h"
+#include "itkCartesianToPolarTransform.h"
+#include "itkMath.h"
+#include <vector>
+
+namespace
+{
+
+constexpr unsigned int Dimension = 2;
+using PointType = itk::Point<double, Dimension>;
+using TransformBaseType = itk::Transform<double, Dimension, Dimension>;
+using AngleEvaluationEnum = itk::PolarTransformEnums::AngleEvaluation;
+
+/* The functor must give the results of the transform, which delegates to it. */
+template <typename TMapping>
+bool
+CompareWithTransform(const TMapping &               mapping,
+                     const TransformBaseType *      transform,
+                     const std::vector<PointType> & points)
+{
+  for (const PointType & point : points)
+  {
+    const PointType expected = transform->TransformPoint(point);
+    const PointType result = mapping(point);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const bool bothNaN = std::isnan(result[d]) && std::isnan(expected[d]);
+      if (!bothNaN && !(itk::Math::abs(result[d] - expected[d]) <= 1e-12 * (1.0 + itk::Math::abs(expected[d]))))
+      {
+        std::cout << transform->GetNameOfClass() << ": functor maps " << point << " to " << result << " instead of "
+                  << expected << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkPolarMappingFunctorTest(int, char *[])
+{
+  auto p2c = itk::PolarToCartesianTransform<double, Dimension>::New();
+  auto c2p = itk::CartesianToPolarTransform<double, Dimension>::New();
+
+  PointType center;
+  center[0] = 1.5;
+  center[1] = -0.5;
+  p2c->SetCenter(center);
+  c2p->SetCenter(center);
+
+  std::vector<PointType> polarPoints;
+  std::vector<PointType> cartesianPoints;
+  for (unsigned int i = 0; i < 40; ++i)
+  {
+    for (unsigned int j = 0; j < 10; ++j)
+    {
+      PointType p;
+      p[0] = -4.0 + 0.2 * i;
+      p[1] = 0.1 + 1.3 * j;
+      polarPoints.push_back(p);
+      p[0] = center[0] - 10.0 + 0.5 * i;
+      p[1] = center[1] - 10.0 + 2.1 * j;
+      cartesianPoints.push_back(p);
+    }
+  }
+  cartesianPoints.push_back(center);
+
+  /* Functors are literal types. */
+  constexpr itk::Functor::PolarToCartesianMapping<double, true, false, true> constantMapping(1.0, 2.0, 0.5);
+  static_assert(constantMapping.GetCenterY() == 2.0 && constantMapping.GetAngleOffset() == 0.5,
+                "PolarToCartesianMapping is not a literal type");
+
+  /* Compare every specialization with the transform. */
+  bool success = true;
+  for (const auto angleEvaluation : { AngleEvaluationEnum::Exact, AngleEvaluationEnum::Approximate })
+  {
+    for (const double angleOffset : { 0.0, 0.3 })
+    {
+      for (const bool constArcIncr : { false, true })
+      {
+        for (const bool returnNaN : { false, true })
+        {
+          p2c->SetAngleEvaluation(angleEvaluation);
+          p2c->SetAngleOffset(angleOffset);
+          p2c->SetConstArcIncr(constArcIncr);
+          p2c->SetReturnNaN(returnNaN);
+          success &= itk::Functor::DispatchPolarMappingFlags(
+            [&](auto c, auto n, auto o, auto a) {
+              using MappingType = itk::Functor::PolarToCartesianMapping<
+                double,
+                decltype(c)::value,
+                decltype(n)::value,
+                decltype(o)::value,
+                decltype(a)::value ? AngleEvaluationEnum::Approximate : AngleEvaluationEnum::Exact>;
+              return CompareWithTransform(MappingType(center[0], center[1], angleOffset), p2c, polarPoints);
+            },
+            constArcIncr,
+            returnNaN,
+            angleOffset != 0.0,
+            angleEvaluation == AngleEvaluationEnum::Approximate);
+        }
+
+        c2p->SetAngleEvaluation(angleEvaluation);
+        c2p->SetAngleOffset(angleOffset);
+        c2p->SetConstArcIncr(constArcIncr);
+        success &= itk::Functor::DispatchPolarMappingFlags(
+          [&](auto c, auto o, auto a) {
+            using MappingType = itk::Functor::CartesianToPolarMapping<
+              double,
+              decltype(c)::value,
+              decltype(o)::value,
+              decltype(a)::value ? AngleEvaluationEnum::Approximate : AngleEvaluationEnum::Exact>;
+            return CompareWithTransform(MappingType(center[0], center[1], angleOffset), c2p, cartesianPoints);
+          },
+          constArcIncr,
+          angleOffset != 0.0,
+          angleEvaluation == AngleEvaluationEnum::Approximate);
+      }
+    }
+  }
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,249 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolarProfileImageFilter.h"
+#include "itkCartesianToPolarTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+/* Image with an oblique direction and values depending on radius and angle about the center. */
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(const typename TImage::PointType & center)
+{
+  typename TImage::SizeType size;
+  size.Fill(3);
+  size[0] = 67;
+  size[1] = 53;
+
+  typename TImage::SpacingType spacing;
+  spacing.Fill(0.7);
+  spacing[1] = 0.55;
+
+  typename TImage::PointType origin;
+  origin.Fill(-3.0);
+
+  typename TImage::DirectionType direction;
+  direction.SetIdentity();
+  direction[0][0] = std::cos(0.2);
+  direction[0][1] = -std::sin(0.2);
+  direction[1][0] = std::sin(0.2);
+  direction[1][1] = std::cos(0.2);
+
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::RegionType(size));
+  image->SetSpacing(spacing);
+  image->SetOrigin(origin);
+  image->SetDirection(direction);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    typename TImage::PointType point;
+    image->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    const double x = point[0] - center[0];
+    const double y = point[1] - center[1];
+    it.Set(static_cast<typename TImage::PixelType>(std::sqrt(x * x + y * y) + 4.0 * std::sin(3.0 * std::atan2(y, x)) +
+                                                   (it.GetIndex()[0] % 3)));
+  }
+  return image;
+}
+
+/* Reference bins by mapping every pixel with CartesianToPolarTransform. */
+template <typename TFilter>
+std::vector<typename TFilter::BinStatistics>
+ComputeReferenceBins(const TFilter * filter, const typename TFilter::InputImageType * image)
+{
+  using TransformType = itk::CartesianToPolarTransform<double, 2>;
+  auto transform = TransformType::New();
+  TransformType::InputPointType center;
+  center[0] = filter->GetCenter()[0];
+  center[1] = filter->GetCenter()[1];
+  transform->SetCenter(center);
+  transform->SetAngleOffset(filter->GetAngleOffset());
+
+  const itk::SizeValueType numberOfRadiusBins = filter->GetNumberOfRadiusBins();
+  const itk::SizeValueType numberOfAngleBins = filter->GetNumberOfAngleBins();
+  const double             maximumRadius = filter->GetComputedMaximumRadius();
+
+  std::vector<typename TFilter::BinStatistics> bins(numberOfRadiusBins * numberOfAngleBins);
+  itk::ImageRegionConstIteratorWithIndex<typename TFilter::InputImageType> it(image,
+                                                                               image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    typename TFilter::PointType point;
+    image->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    TransformType::InputPointType inPlanePoint;
+    inPlanePoint[0] = point[0];
+    inPlanePoint[1] = point[1];
+    const auto polarPoint = transform->TransformPoint(inPlanePoint);
+    if (polarPoint[1] > maximumRadius)
+    {
+      continue;
+    }
+    const auto radiusBin = std::min(static_cast<itk::SizeValueType>(polarPoint[1] * numberOfRadiusBins / maximumRadius),
+                                    numberOfRadiusBins - 1);
+    const auto angleBin = std::min(
+      static_cast<itk::SizeValueType>(polarPoint[0] * numberOfAngleBins / itk::Math::twopi), numberOfAngleBins - 1);
+    auto &       bin = bins[radiusBin * numberOfAngleBins + angleBin];
+    const double value = it.Get();
+    ++bin.Count;
+    bin.Sum += value;
+    bin.SumOfSquares += value * value;
+    bin.Minimum = std::min(bin.Minimum, value);
+    bin.Maximum = std::max(bin.Maximum, value);
+  }
+  return bins;
+}
+
+/* The filter matches the reference, allowing countTolerance pixels in total to fall into neighboring bins. */
+template <typename TFilter>
+bool
+CheckBins(const TFilter *                                      filter,
+          const std::vector<typename TFilter::BinStatistics> & reference,
+          const itk::SizeValueType                             countTolerance)
+{
+  const auto &       bins = filter->GetBinStatistics();
+  itk::SizeValueType countDifference = 0;
+  for (size_t k = 0; k < reference.size(); ++k)
+  {
+    countDifference += bins[k].Count > reference[k].Count ? bins[k].Count - reference[k].Count
+                                                          : reference[k].Count - bins[k].Count;
+    if (countTolerance == 0 && (itk::Math::abs(bins[k].Sum - reference[k].Sum) > 1e-6 * (1.0 + reference[k].Sum) ||
+                                itk::Math::NotExactlyEquals(bins[k].Minimum, reference[k].Minimum) ||
+                                itk::Math::NotExactlyEquals(bins[k].Maximum, reference[k].Maximum)))
+    {
+      std::cout << "Bin " << k << ": sum " << bins[k].Sum << " min " << bins[k].Minimum << " max " << bins[k].Maximum
+                << ", expected " << reference[k].Sum << " " << reference[k].Minimum << " " << reference[k].Maximum
+                << std::endl;
+      return false;
+    }
+  }
+  if (countDifference > countTolerance)
+  {
+    std::cout << countDifference << " pixels in other bins than expected" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkPolarProfileImageFilterTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 2>;
+  using FilterType = itk::PolarProfileImageFilter<ImageType>;
+
+  ImageType::PointType center;
+  center[0] = 17.317;
+  center[1] = 11.093;
+  const auto image = CreateImage<ImageType>(center);
+
+  auto filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, PolarProfileImageFilter, ImageSink);
+
+  /* No bins before the first update. */
+  ITK_TRY_EXPECT_EXCEPTION(filter->GetCount(0, 0));
+
+  filter->SetInput(image);
+  filter->SetCenter(center);
+  ITK_TEST_SET_GET_VALUE(center, filter->GetCenter());
+  filter->SetAngleOffset(0.4);
+  ITK_TEST_SET_GET_VALUE(0.4, filter->GetAngleOffset());
+  filter->SetNumberOfRadiusBins(23);
+  ITK_TEST_SET_GET_VALUE(23u, filter->GetNumberOfRadiusBins());
+  filter->SetNumberOfAngleBins(12);
+  ITK_TEST_SET_GET_VALUE(12u, filter->GetNumberOfAngleBins());
+  ITK_TEST_EXPECT_EQUAL(filter->GetAngleEvaluation(), FilterType::AngleEvaluationEnum::Exact);
+
+  /* The default MaximumRadius includes every pixel. */
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  const auto reference = ComputeReferenceBins(filter.GetPointer(), image.GetPointer());
+  ITK_TEST_EXPECT_TRUE(CheckBins(filter.GetPointer(), reference, 0));
+  itk::SizeValueType total = 0;
+  for (const auto & bin : filter->GetBinStatistics())
+  {
+    total += bin.Count;
+  }
+  ITK_TEST_EXPECT_EQUAL(total, image->GetLargestPossibleRegion().GetNumberOfPixels());
+  ITK_TRY_EXPECT_EXCEPTION(filter->GetMean(23, 0));
+  ITK_TRY_EXPECT_EXCEPTION(filter->GetMean(0, 12));
+
+  /* The accessors agree with the accumulated statistics. */
+  const auto & bin = reference[5 * 12 + 7];
+  ITK_TEST_EXPECT_EQUAL(filter->GetCount(5, 7), bin.Count);
+  ITK_TEST_EXPECT_TRUE(itk::Math::abs(filter->GetMean(5, 7) - bin.Sum / bin.Count) < 1e-6);
+  const double variance = (bin.SumOfSquares - bin.Sum * bin.Sum / bin.Count) / (bin.Count - 1.0);
+  ITK_TEST_EXPECT_TRUE(itk::Math::abs(filter->GetVariance(5, 7) - variance) < 1e-6 * (1.0 + variance));
+  ITK_TEST_EXPECT_EQUAL(filter->GetMinimum(5, 7), bin.Minimum);
+  ITK_TEST_EXPECT_EQUAL(filter->GetMaximum(5, 7), bin.Maximum);
+
+  /* Streaming the input does not change the bins. */
+  filter->SetNumberOfStreamDivisions(7);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_TRUE(CheckBins(filter.GetPointer(), reference, 0));
+
+  /* An explicit MaximumRadius ignores the pixels beyond it. */
+  filter->SetMaximumRadius(15.0);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_EQUAL(filter->GetComputedMaximumRadius(), 15.0);
+  ITK_TEST_EXPECT_TRUE(
+    CheckBins(filter.GetPointer(), ComputeReferenceBins(filter.GetPointer(), image.GetPointer()), 0));
+
+  /* The approximate angles only move pixels lying on bin boundaries. */
+  filter->SetAngleEvaluation(FilterType::AngleEvaluationEnum::Approximate);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  ITK_TEST_EXPECT_TRUE(
+    CheckBins(filter.GetPointer(), ComputeReferenceBins(filter.GetPointer(), image.GetPointer()), 4));
+
+  /* A radial profile of a volume pools all slices. */
+  using VolumeType = itk::Image<float, 3>;
+  using VolumeFilterType = itk::PolarProfileImageFilter<VolumeType>;
+  VolumeType::PointType volumeCenter;
+  volumeCenter[0] = center[0];
+  volumeCenter[1] = center[1];
+  volumeCenter[2] = 0.0;
+  const auto volume = CreateImage<VolumeType>(volumeCenter);
+
+  auto volumeFilter = VolumeFilterType::New();
+  volumeFilter->SetInput(volume);
+  volumeFilter->SetCenter(volumeCenter);
+  volumeFilter->SetNumberOfRadiusBins(10);
+  ITK_TRY_EXPECT_NO_EXCEPTION(volumeFilter->Update());
+
+  filter->SetMaximumRadius(volumeFilter->GetComputedMaximumRadius());
+  filter->SetNumberOfRadiusBins(10);
+  filter->SetNumberOfAngleBins(1);
+  filter->SetAngleOffset(0.0);
+  filter->SetAngleEvaluation(FilterType::AngleEvaluationEnum::Exact);
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+  for (itk::SizeValueType r = 0; r < 10; ++r)
+  {
+    ITK_TEST_EXPECT_EQUAL(volumeFilter->GetCount(r, 0), 3 * filter->GetCount(r, 0));
+    ITK_TEST_EXPECT_TRUE(itk::Math::abs(volumeFilter->GetMean(r, 0) - filter->GetMean(r, 0)) < 1e-6);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,140 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolarRotationEstimator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+/* Image with a smooth, rotationally asymmetric pattern about the center, rotated counterclockwise by angle. */
+template <typename TImage>
+typename TImage::Pointer
+CreateRotatedImage(const typename TImage::PointType & center, const double angle, const double intensityOffset)
+{
+  typename TImage::SizeType size;
+  size.Fill(2);
+  size[0] = 96;
+  size[1] = 96;
+
+  typename TImage::SpacingType spacing;
+  spacing.Fill(0.5);
+
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::RegionType(size));
+  image->SetSpacing(spacing);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    typename TImage::PointType point;
+    image->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+    const double x = point[0] - center[0];
+    const double y = point[1] - center[1];
+    const double r = std::sqrt(x * x + y * y);
+    const double theta = std::atan2(y, x) - angle;
+    const double slice = TImage::ImageDimension > 2 ? point[TImage::ImageDimension - 1] : 0.0;
+    it.Set(static_cast<typename TImage::PixelType>(
+      intensityOffset + std::exp(-r * r / 300.0) * (std::cos(3.0 * theta) + 0.5 * std::sin(5.0 * theta + 1.0 + slice)) +
+      0.05 * r));
+  }
+  return image;
+}
+
+} // namespace
+
+int
+itkPolarRotationEstimatorTest(int, char *[])
+{
+  using ImageType = itk::Image<float, 2>;
+  using EstimatorType = itk::PolarRotationEstimator<ImageType>;
+
+  ImageType::PointType center;
+  center[0] = 23.6;
+  center[1] = 24.3;
+
+  auto estimator = EstimatorType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(estimator, PolarRotationEstimator, Object);
+
+  ITK_TEST_EXPECT_TRUE(EstimatorType::IsSupportedNumberOfAngles(360));
+  ITK_TEST_EXPECT_TRUE(EstimatorType::IsSupportedNumberOfAngles(512));
+  ITK_TEST_EXPECT_TRUE(!EstimatorType::IsSupportedNumberOfAngles(0));
+  ITK_TEST_EXPECT_TRUE(!EstimatorType::IsSupportedNumberOfAngles(7 * 32));
+
+  /* Images must be set. */
+  ITK_TRY_EXPECT_EXCEPTION(estimator->Compute());
+
+  const auto fixedImage = CreateRotatedImage<ImageType>(center, 0.0, 0.0);
+  estimator->SetFixedImage(fixedImage);
+  estimator->SetCenter(center);
+  ITK_TEST_SET_GET_VALUE(center, estimator->GetCenter());
+
+  /* The angle bins must suit vnl_fft_1d. */
+  estimator->SetMovingImage(fixedImage);
+  estimator->SetNumberOfAngles(7 * 32);
+  ITK_TRY_EXPECT_EXCEPTION(estimator->Compute());
+  estimator->SetNumberOfAngles(360);
+
+  /* Rotations within a fraction of the 1 degree bins, also across the cut at +-pi and with an intensity offset. */
+  const double tolerance = 5e-3;
+  for (const double angle : { 0.0, 0.3, -1.2, 2.9, -3.1, itk::Math::pi })
+  {
+    const auto movingImage = CreateRotatedImage<ImageType>(center, angle, 10.0);
+    estimator->SetMovingImage(movingImage);
+    ITK_TRY_EXPECT_NO_EXCEPTION(estimator->Compute());
+
+    double error = estimator->GetAngleOffset() - angle;
+    error -= itk::Math::twopi * std::round(error / itk::Math::twopi);
+    std::cout << "Rotation " << angle << ": AngleOffset " << estimator->GetAngleOffset() << ", Correlation "
+              << estimator->GetCorrelation() << std::endl;
+    if (itk::Math::abs(error) > tolerance || estimator->GetCorrelation() < 0.98)
+    {
+      std::cout << "Rotation " << angle << " estimated as " << estimator->GetAngleOffset() << std::endl;
+      return EXIT_FAILURE;
+    }
+    ITK_TEST_EXPECT_TRUE(estimator->GetAngleOffset() > -itk::Math::pi &&
+                         estimator->GetAngleOffset() <= itk::Math::pi);
+  }
+
+  /* An explicit annulus with coarser rings, and volumes accumulating all slices. */
+  estimator->SetMinimumRadius(3.0);
+  estimator->SetMaximumRadius(18.0);
+  estimator->SetNumberOfRadii(16);
+  estimator->SetNumberOfAngles(256);
+  estimator->SetMovingImage(CreateRotatedImage<ImageType>(center, 0.7, 0.0));
+  ITK_TRY_EXPECT_NO_EXCEPTION(estimator->Compute());
+  ITK_TEST_EXPECT_TRUE(itk::Math::abs(estimator->GetAngleOffset() - 0.7) < tolerance);
+
+  using VolumeType = itk::Image<float, 3>;
+  using VolumeEstimatorType = itk::PolarRotationEstimator<VolumeType>;
+  VolumeType::PointType volumeCenter;
+  volumeCenter[0] = center[0];
+  volumeCenter[1] = center[1];
+  volumeCenter[2] = 0.0;
+
+  auto volumeEstimator = VolumeEstimatorType::New();
+  volumeEstimator->SetFixedImage(CreateRotatedImage<VolumeType>(volumeCenter, 0.0, 0.0));
+  volumeEstimator->SetMovingImage(CreateRotatedImage<VolumeType>(volumeCenter, -0.45, 0.0));
+  volumeEstimator->SetCenter(volumeCenter);
+  ITK_TRY_EXPECT_NO_EXCEPTION(volumeEstimator->Compute());
+  ITK_TEST_EXPECT_TRUE(itk::Math::abs(volumeEstimator->GetAngleOffset() + 0.45) < tolerance);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,376 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolarSamplingMap.h"
+#include "itkPolarToCartesianTransform.h"
+#include "itkCartesianToPolarTransform.h"
+#include "itkResampleImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <random>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+
+/* Compare two images pixel by pixel. */
+template <typename TImage>
+bool
+CompareImages(const TImage * image, const TImage * baseline, double epsilon)
+{
+  itk::ImageRegionConstIterator<TImage> it(image, image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<TImage> baselineIt(baseline, baseline->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it, ++baselineIt)
+  {
+    if (itk::Math::abs(it.Get() - baselineIt.Get()) > epsilon)
+    {
+      std::cout << "Mismatch with ResampleImageFilter at " << it.GetIndex() << ": " << it.Get()
+                << " != " << baselineIt.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Scan convert an 8 bit polar frame, or a signed 16 bit frame with values around zero, with floating point and
+ * fixed-point weights. The fixed-point outputs may differ by the documented number of gray levels, and as both paths
+ * round the same way the differences average to about zero. */
+template <typename TPixel>
+int
+TestFixedPointScanConversion()
+{
+  using PolarImageType = itk::Image<TPixel, 2>;
+  using MapType = itk::PolarSamplingMap<PolarImageType>;
+  using TransformType = itk::CartesianToPolarTransform<double, 2>;
+
+  typename PolarImageType::SizeType polarSize;
+  polarSize[0] = 128;
+  polarSize[1] = 200;
+  typename PolarImageType::SpacingType polarSpacing;
+  polarSpacing[0] = 1.2 / polarSize[0];
+  polarSpacing[1] = 0.25;
+  typename PolarImageType::PointType polarOrigin;
+  polarOrigin[0] = 0.3;
+  polarOrigin[1] = 2.0;
+
+  auto frame = PolarImageType::New();
+  frame->SetRegions(typename PolarImageType::RegionType(polarSize));
+  frame->SetSpacing(polarSpacing);
+  frame->SetOrigin(polarOrigin);
+  frame->Allocate();
+  const int                                         shift = std::is_signed<TPixel>::value ? -128 : 0;
+  itk::ImageRegionIteratorWithIndex<PolarImageType> it(frame, frame->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const typename PolarImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<TPixel>((index[0] * 37 + index[1] * 11 + (index[0] * index[1]) % 7 * 29) % 256 + shift));
+  }
+
+  /* Sector image, including the corners outside the sector. */
+  typename PolarImageType::SizeType size;
+  size[0] = 160;
+  size[1] = 120;
+  typename PolarImageType::SpacingType spacing;
+  spacing.Fill(0.35);
+  typename PolarImageType::PointType origin;
+  origin[0] = -28.0;
+  origin[1] = 0.0;
+
+  auto transform = TransformType::New();
+  auto map = MapType::New();
+  map->SetTransform(transform);
+  map->SetSize(size);
+  map->SetOutputSpacing(spacing);
+  map->SetOutputOrigin(origin);
+  map->SetDefaultPixelValue(3);
+
+  auto reference = PolarImageType::New();
+  ITK_TRY_EXPECT_NO_EXCEPTION(map->Apply(frame, reference));
+  ITK_TEST_SET_GET_VALUE(0u, map->GetFixedPointWeightBits());
+  const itk::SizeValueType floatMapSizeInBytes = map->GetMapSizeInBytes();
+
+  for (const unsigned int bits : { 8u, 16u })
+  {
+    map->SetFixedPointWeightBits(bits);
+    ITK_TEST_EXPECT_TRUE(!map->IsUpToDate(frame));
+
+    auto output = PolarImageType::New();
+    ITK_TRY_EXPECT_NO_EXCEPTION(map->Apply(frame, output));
+    ITK_TEST_EXPECT_EQUAL(map->GetNumberOfSamples(), output->GetLargestPossibleRegion().GetNumberOfPixels());
+
+    /* A 32 bit offset and two 16 bit fractions per sample. */
+    ITK_TEST_EXPECT_EQUAL(map->GetMapSizeInBytes(), 8 * map->GetNumberOfSamples());
+    std::cout << "Q" << bits << " map: " << map->GetMapSizeInBytes() << " bytes, floating point map: "
+              << floatMapSizeInBytes << " bytes" << std::endl;
+
+    const int                                     tolerance = bits == 8 ? 2 : 1;
+    double                                        sumOfDifferences = 0.0;
+    itk::ImageRegionConstIterator<PolarImageType> outputIt(output, output->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<PolarImageType> referenceIt(reference, reference->GetLargestPossibleRegion());
+    for (; !outputIt.IsAtEnd(); ++outputIt, ++referenceIt)
+    {
+      const int difference = int{ outputIt.Get() } - int{ referenceIt.Get() };
+      if (std::abs(difference) > tolerance)
+      {
+        std::cout << "Q" << bits << " mismatch at " << outputIt.GetIndex() << ": " << int{ outputIt.Get() }
+                  << " != " << int{ referenceIt.Get() } << std::endl;
+        return EXIT_FAILURE;
+      }
+      sumOfDifferences += difference;
+    }
+
+    const double meanDifference = sumOfDifferences / output->GetLargestPossibleRegion().GetNumberOfPixels();
+    if (std::abs(meanDifference) > 0.02)
+    {
+      std::cout << "Q" << bits << " outputs are biased by " << meanDifference << " gray levels" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  map->SetFixedPointWeightBits(20);
+  ITK_TEST_SET_GET_VALUE(16u, map->GetFixedPointWeightBits());
+  return EXIT_SUCCESS;
+}
+
+/* The blocks of FixedPointGather(), vectorized when AVX2 is enabled, must reproduce the scalar
+ * FixedPointGatherSample() exactly, for samples outside the input, fractions of zero and one, and corners at the end
+ * of the buffer. */
+template <unsigned int VDimension, typename TPixel, typename TOutput>
+int
+TestFixedPointGather()
+{
+  namespace Kernels = itk::PolarTransformKernels;
+  constexpr unsigned int NumberOfCorners = 1u << VDimension;
+  const int              size[3] = { 37, 23, 5 };
+
+  std::mt19937 generator(17);
+  std::int32_t strides[VDimension];
+  std::size_t  inputSize = 1;
+  for (unsigned int d = 0; d < VDimension; ++d)
+  {
+    strides[d] = static_cast<std::int32_t>(inputSize);
+    inputSize *= size[d];
+  }
+  std::vector<TPixel> input(inputSize);
+  for (auto & pixel : input)
+  {
+    pixel = static_cast<TPixel>(generator());
+  }
+
+  for (unsigned int bits = 1; bits <= 16; ++bits)
+  {
+    Kernels::FixedPointGatherParameters<VDimension, TOutput> parameters;
+    for (unsigned int corner = 0; corner < NumberOfCorners; ++corner)
+    {
+      for (unsigned int d = 0; d < VDimension; ++d)
+      {
+        if (corner & (1u << d))
+        {
+          parameters.CornerOffsets[corner] += strides[d];
+        }
+      }
+    }
+    parameters.InputSize = inputSize;
+    parameters.Bits = bits;
+    parameters.DefaultValue = static_cast<TOutput>(generator());
+
+    std::vector<Kernels::FixedPointSample<VDimension>> samples(1003);
+    for (auto & sample : samples)
+    {
+      sample.BaseOffset = generator() % 7 == 0 ? -1 : 0;
+      for (unsigned int d = 0; d < VDimension; ++d)
+      {
+        const int index = generator() % 3 == 0 ? size[d] - 2 : static_cast<int>(generator() % (size[d] - 1));
+        if (sample.BaseOffset >= 0)
+        {
+          sample.BaseOffset += index * strides[d];
+        }
+        /* A quarter of the fractions are zero and another quarter one. */
+        const auto         choice = static_cast<unsigned int>(generator() % 4);
+        const unsigned int fraction =
+          choice < 2 ? choice << bits : static_cast<unsigned int>(generator() % (1u << bits));
+        sample.Fraction[d] = static_cast<std::uint16_t>(std::min(fraction, 65535u));
+      }
+    }
+
+    std::vector<TOutput> output(samples.size());
+    Kernels::FixedPointGather(samples.data(), 0, samples.size(), input.data(), parameters, output.data());
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+      const TOutput expected = Kernels::FixedPointGatherSample(samples[i], input.data(), parameters);
+      if (output[i] != expected)
+      {
+        std::cout << "FixedPointGather mismatch in " << VDimension << "-D with b = " << bits << " at sample " << i
+                  << ": " << static_cast<double>(output[i]) << " != " << static_cast<double>(expected) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkPolarSamplingMapTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+  const double           epsilon = 1e-4;
+
+  using ImageType = itk::Image<float, Dimension>;
+  using MapType = itk::PolarSamplingMap<ImageType>;
+  using TransformType = itk::PolarToCartesianTransform<double, Dimension>;
+  using ResampleFilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+
+  /* Two cartesian frames with the same geometry. */
+  ImageType::SizeType size;
+  size[0] = 64;
+  size[1] = 48;
+  size[2] = 3;
+
+  ImageType::PointType inputOrigin;
+  inputOrigin[0] = -2.0;
+  inputOrigin[1] = 1.0;
+  inputOrigin[2] = 0.0;
+
+  ImageType::Pointer frames[2];
+  for (unsigned int f = 0; f < 2; ++f)
+  {
+    frames[f] = ImageType::New();
+    frames[f]->SetRegions(ImageType::RegionType(size));
+    frames[f]->SetOrigin(inputOrigin);
+    frames[f]->Allocate();
+
+    itk::ImageRegionIteratorWithIndex<ImageType> it(frames[f], frames[f]->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const ImageType::IndexType index = it.GetIndex();
+      it.Set(static_cast<float>(std::sin(0.2 * index[0] + f) * std::cos(0.15 * index[1]) + index[2]));
+    }
+  }
+
+  /* Polar output grid: full circle, radii reaching outside the input to exercise the default value. */
+  ImageType::SizeType polarSize;
+  polarSize[0] = 90;
+  polarSize[1] = 40;
+  polarSize[2] = size[2];
+
+  ImageType::SpacingType polarSpacing;
+  polarSpacing[0] = itk::Math::twopi / polarSize[0];
+  polarSpacing[1] = 1.0;
+  polarSpacing[2] = 1.0;
+
+  ImageType::PointType polarOrigin;
+  polarOrigin[0] = 0.0;
+  polarOrigin[1] = 0.5;
+  polarOrigin[2] = 0.0;
+
+  ImageType::PointType center;
+  center[0] = 29.5;
+  center[1] = 24.25;
+  center[2] = 0.0;
+
+  auto transform = TransformType::New();
+  transform->SetCenter(center);
+
+  auto map = MapType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(map, PolarSamplingMap, Object);
+
+  map->SetTransform(transform);
+  map->SetSize(polarSize);
+  map->SetOutputSpacing(polarSpacing);
+  map->SetOutputOrigin(polarOrigin);
+  map->SetDefaultPixelValue(-1.0f);
+  ITK_TEST_SET_GET_VALUE(polarSize, map->GetSize());
+  ITK_TEST_EXPECT_TRUE(!map->IsUpToDate(frames[0]));
+
+  auto resample = ResampleFilterType::New();
+  resample->SetTransform(transform);
+  resample->SetSize(polarSize);
+  resample->SetOutputSpacing(polarSpacing);
+  resample->SetOutputOrigin(polarOrigin);
+  resample->SetDefaultPixelValue(-1.0f);
+
+  auto output = ImageType::New();
+  for (const double angleOffset : { 0.0, 0.4 })
+  {
+    for (const bool constArcIncr : { false, true })
+    {
+      /* Changing the transform invalidates the map. */
+      transform->SetAngleOffset(angleOffset);
+      transform->SetConstArcIncr(constArcIncr);
+      ITK_TEST_EXPECT_TRUE(!map->IsUpToDate(frames[0]));
+
+      for (const auto & frame : frames)
+      {
+        ITK_TRY_EXPECT_NO_EXCEPTION(map->Apply(frame, output));
+        ITK_TEST_EXPECT_TRUE(map->IsUpToDate(frame));
+        ITK_TEST_EXPECT_EQUAL(map->GetNumberOfSamples(), output->GetLargestPossibleRegion().GetNumberOfPixels());
+
+        resample->SetInput(frame);
+        resample->Modified();
+        ITK_TRY_EXPECT_NO_EXCEPTION(resample->Update());
+
+        if (!CompareImages(output.GetPointer(), resample->GetOutput(), epsilon))
+        {
+          std::cout << "AngleOffset " << angleOffset << ", ConstArcIncr " << constArcIncr << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  /* A frame with a different geometry invalidates the map as well. */
+  auto shifted = ImageType::New();
+  shifted->Graft(frames[1]);
+  inputOrigin[0] += 0.75;
+  shifted->SetOrigin(inputOrigin);
+  ITK_TEST_EXPECT_TRUE(!map->IsUpToDate(shifted));
+  ITK_TRY_EXPECT_NO_EXCEPTION(map->Apply(shifted, output));
+  resample->SetInput(shifted);
+  ITK_TRY_EXPECT_NO_EXCEPTION(resample->Update());
+  if (!CompareImages(output.GetPointer(), resample->GetOutput(), epsilon))
+  {
+    return EXIT_FAILURE;
+  }
+
+  /* Fixed-point weights need integer pixels. */
+  map->SetFixedPointWeightBits(16);
+  ITK_TRY_EXPECT_EXCEPTION(map->Apply(shifted, output));
+
+  if (TestFixedPointScanConversion<unsigned char>() == EXIT_FAILURE ||
+      TestFixedPointScanConversion<short>() == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  if (TestFixedPointGather<2, unsigned char, unsigned char>() == EXIT_FAILURE ||
+      TestFixedPointGather<2, signed char, short>() == EXIT_FAILURE ||
+      TestFixedPointGather<2, short, short>() == EXIT_FAILURE ||
+      TestFixedPointGather<2, unsigned short, unsigned char>() == EXIT_FAILURE ||
+      TestFixedPointGather<2, unsigned short, float>() == EXIT_FAILURE ||
+      TestFixedPointGather<3, unsigned char, unsigned char>() == EXIT_FAILURE ||
+      TestFixedPointGather<3, short, unsigned short>() == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
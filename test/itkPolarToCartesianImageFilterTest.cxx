@@ -0,0 +1,157 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolarToCartesianImageFilter.h"
+#include "itkCartesianToPolarTransform.h"
+#include "itkResampleImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+int
+itkPolarToCartesianImageFilterTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+  const double           epsilon = 1e-4;
+  const float            defaultValue = -1000.0f;
+
+  using ImageType = itk::Image<float, Dimension>;
+  using FilterType = itk::PolarToCartesianImageFilter<ImageType, ImageType>;
+  using TransformType = itk::CartesianToPolarTransform<double, Dimension>;
+  using ResampleFilterType = itk::ResampleImageFilter<ImageType, ImageType>;
+
+  /* Create a smooth polar test image covering the full circle. */
+  ImageType::SizeType polarSize;
+  polarSize[0] = 120;
+  polarSize[1] = 30;
+  polarSize[2] = 3;
+
+  ImageType::SpacingType polarSpacing;
+  polarSpacing[0] = itk::Math::twopi / polarSize[0];
+  polarSpacing[1] = 1.0;
+  polarSpacing[2] = 1.0;
+
+  auto polarImage = ImageType::New();
+  polarImage->SetRegions(ImageType::RegionType(polarSize));
+  polarImage->SetSpacing(polarSpacing);
+  polarImage->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(polarImage, polarImage->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<float>(std::cos(3.0 * index[0] * polarSpacing[0]) * index[1] + index[2]));
+  }
+
+  /* Cartesian output grid around the center. */
+  ImageType::SizeType size;
+  size[0] = 50;
+  size[1] = 40;
+  size[2] = polarSize[2];
+
+  ImageType::PointType origin;
+  origin[0] = -25.0;
+  origin[1] = -20.0;
+  origin[2] = 0.0;
+
+  ImageType::SpacingType spacing;
+  spacing.Fill(1.0);
+
+  ImageType::PointType center;
+  center[0] = 0.3;
+  center[1] = -0.2;
+  center[2] = 0.0;
+
+  auto filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, PolarToCartesianImageFilter, ImageToImageFilter);
+
+  filter->SetInput(polarImage);
+  filter->SetSize(size);
+  filter->SetOutputSpacing(spacing);
+  filter->SetOutputOrigin(origin);
+  filter->SetCenter(center);
+  filter->SetDefaultPixelValue(defaultValue);
+  ITK_TEST_SET_GET_VALUE(center, filter->GetCenter());
+  ITK_TEST_SET_GET_BOOLEAN(filter, UseInPlaneMap, false);
+
+  auto transform = TransformType::New();
+  transform->SetCenter(center);
+
+  auto resample = ResampleFilterType::New();
+  resample->SetInput(polarImage);
+  resample->SetTransform(transform);
+  resample->SetSize(size);
+  resample->SetOutputSpacing(spacing);
+  resample->SetOutputOrigin(origin);
+  resample->SetDefaultPixelValue(defaultValue);
+
+  /* Compare with ResampleImageFilter for all combinations of options. The filter
+   * additionally wraps the angle axis, so only compare where the transform hits the input. */
+  using AngleEvaluationEnum = itk::PolarTransformEnums::AngleEvaluation;
+  for (const auto angleEvaluation : { AngleEvaluationEnum::Exact, AngleEvaluationEnum::Approximate })
+  {
+    filter->SetAngleEvaluation(angleEvaluation);
+    for (const double angleOffset : { 0.0, 0.4 })
+    {
+      for (const bool constArcIncr : { false, true })
+      {
+        for (const bool useInPlaneMap : { false, true })
+        {
+          filter->SetUseInPlaneMap(useInPlaneMap);
+          filter->SetAngleOffset(angleOffset);
+          filter->SetConstArcIncr(constArcIncr);
+          transform->SetAngleOffset(angleOffset);
+          transform->SetConstArcIncr(constArcIncr);
+          resample->Modified();
+
+          ITK_TRY_EXPECT_NO_EXCEPTION(filter->Update());
+          ITK_TRY_EXPECT_NO_EXCEPTION(resample->Update());
+
+          unsigned int                             numberOfCompared = 0;
+          itk::ImageRegionConstIterator<ImageType> filterIt(filter->GetOutput(),
+                                                            filter->GetOutput()->GetLargestPossibleRegion());
+          itk::ImageRegionConstIterator<ImageType> resampleIt(resample->GetOutput(),
+                                                              resample->GetOutput()->GetLargestPossibleRegion());
+          for (; !filterIt.IsAtEnd(); ++filterIt, ++resampleIt)
+          {
+            if (itk::Math::ExactlyEquals(resampleIt.Get(), defaultValue))
+            {
+              continue;
+            }
+            ++numberOfCompared;
+            if (itk::Math::abs(filterIt.Get() - resampleIt.Get()) > epsilon)
+            {
+              std::cout << "Mismatch with ResampleImageFilter at " << filterIt.GetIndex() << " (" << angleEvaluation
+                        << ", AngleOffset " << angleOffset << ", ConstArcIncr " << constArcIncr << ", UseInPlaneMap "
+                        << useInPlaneMap << "): " << filterIt.Get() << " != " << resampleIt.Get() << std::endl;
+              return EXIT_FAILURE;
+            }
+          }
+
+          if (numberOfCompared == 0)
+          {
+            std::cout << "No output pixel maps inside the polar input." << std::endl;
+            return EXIT_FAILURE;
+          }
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
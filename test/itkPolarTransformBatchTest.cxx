@@ -0,0 +1,367 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolarToCartesianTransform.h"
+#include "itkCartesianToPolarTransform.h"
+#include "itkPolarTransformKernels.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+/* Compare the batch paths (array of structures and structure of arrays) with TransformPoint. */
+template <typename TTransform>
+bool
+CompareBatchWithTransformPoint(const TTransform *                                         transform,
+                               const std::vector<typename TTransform::InputPointType> & points,
+                               const double                                             epsilon)
+{
+  using PointType = typename TTransform::OutputPointType;
+  using ScalarType = typename TTransform::ScalarType;
+  constexpr unsigned int Dimension = TTransform::SpaceDimension;
+
+  const auto numberOfPoints = static_cast<itk::SizeValueType>(points.size());
+
+  std::vector<PointType> batch(points.size());
+  transform->TransformPoints(points.data(), batch.data(), numberOfPoints);
+
+  std::vector<std::vector<ScalarType>> components(Dimension, std::vector<ScalarType>(points.size()));
+  const ScalarType *                   inputComponents[Dimension];
+  ScalarType *                         outputComponents[Dimension];
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      components[d][i] = points[i][d];
+    }
+    inputComponents[d] = components[d].data();
+    outputComponents[d] = components[d].data();
+  }
+  transform->TransformPoints(inputComponents, outputComponents, numberOfPoints); // in-place
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const PointType expected = transform->TransformPoint(points[i]);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const double tolerance = epsilon * (1.0 + itk::Math::abs(expected[d]));
+      const bool   expectedNaN = std::isnan(expected[d]);
+      if (expectedNaN != std::isnan(batch[i][d]) || expectedNaN != std::isnan(components[d][i]) ||
+          (!expectedNaN && (itk::Math::abs(batch[i][d] - expected[d]) > tolerance ||
+                            itk::Math::abs(components[d][i] - expected[d]) > tolerance)))
+      {
+        std::cout << transform->GetNameOfClass() << ": batch result of " << points[i] << " differs in dimension "
+                  << d << ": " << batch[i][d] << " / " << components[d][i] << " != " << expected[d] << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/* Run the comparison for all options with transforms computing in TScalar. */
+template <typename TScalar>
+int
+TestBatchPrecision(const double epsilon)
+{
+  constexpr unsigned int Dimension = 3;
+
+  using P2CTransformType = itk::PolarToCartesianTransform<TScalar, Dimension>;
+  using C2PTransformType = itk::CartesianToPolarTransform<TScalar, Dimension>;
+  using PointType = itk::Point<TScalar, Dimension>;
+
+  auto p2c = P2CTransformType::New();
+  auto c2p = C2PTransformType::New();
+
+  PointType center;
+  center[0] = -1.0;
+  center[1] = 0.5;
+  center[2] = 0.0;
+  p2c->SetCenter(center);
+  c2p->SetCenter(center);
+
+  /* Polar points, including angles outside [-pi,pi] for ReturnNaN; an odd count exercises the remainder. */
+  std::vector<PointType> polarPoints;
+  for (unsigned int i = 0; i < 37; ++i)
+  {
+    for (unsigned int j = 0; j < 15; ++j)
+    {
+      PointType p;
+      p[0] = -4.0 + 0.2137 * i;
+      p[1] = 0.25 + 1.3 * j;
+      p[2] = 0.5 * j;
+      polarPoints.push_back(p);
+    }
+  }
+
+  /* Cartesian points around the center. */
+  std::vector<PointType> cartesianPoints;
+  for (unsigned int i = 0; i < 31; ++i)
+  {
+    for (unsigned int j = 0; j < 29; ++j)
+    {
+      PointType p;
+      p[0] = center[0] - 15.37 + 1.01 * i;
+      p[1] = center[1] - 14.71 + 1.02 * j;
+      p[2] = 3.0;
+      cartesianPoints.push_back(p);
+    }
+  }
+
+  using AngleEvaluationEnum = itk::PolarTransformEnums::AngleEvaluation;
+  for (const auto angleEvaluation : { AngleEvaluationEnum::Exact, AngleEvaluationEnum::Approximate })
+  {
+    p2c->SetAngleEvaluation(angleEvaluation);
+    c2p->SetAngleEvaluation(angleEvaluation);
+    ITK_TEST_SET_GET_VALUE(angleEvaluation, c2p->GetAngleEvaluation());
+
+    /* In Exact mode the batch paths evaluate libm per point like TransformPoint, up to contraction into FMA. */
+    const double tolerance =
+      angleEvaluation == AngleEvaluationEnum::Exact ? 4 * itk::NumericTraits<TScalar>::epsilon() : epsilon;
+
+    for (const double angleOffset : { 0.0, 0.3 })
+    {
+      for (const bool constArcIncr : { false, true })
+      {
+        for (const bool returnNaN : { false, true })
+        {
+          p2c->SetAngleOffset(angleOffset);
+          p2c->SetConstArcIncr(constArcIncr);
+          p2c->SetReturnNaN(returnNaN);
+          if (!CompareBatchWithTransformPoint(p2c.GetPointer(), polarPoints, tolerance))
+          {
+            return EXIT_FAILURE;
+          }
+        }
+
+        c2p->SetAngleOffset(angleOffset);
+        c2p->SetConstArcIncr(constArcIncr);
+        if (!CompareBatchWithTransformPoint(c2p.GetPointer(), cartesianPoints, tolerance))
+        {
+          return EXIT_FAILURE;
+        }
+      }
+    }
+
+    /* The center maps to angle 0 instead of NaN. */
+    c2p->SetAngleOffset(0.0);
+    c2p->SetConstArcIncr(false);
+    const PointType polarCenter = c2p->TransformPoint(center);
+    ITK_TEST_EXPECT_EQUAL(polarCenter[0], TScalar(0));
+    ITK_TEST_EXPECT_EQUAL(polarCenter[1], TScalar(0));
+  }
+
+  return EXIT_SUCCESS;
+}
+
+
+/* Compare the incremental sine and cosine of uniform angle grids with std::sin and std::cos, and check that a
+ * range split into pieces gives the same values as the whole range. */
+template <typename TScalar>
+int
+TestIncrementalSinCos(const double tolerance)
+{
+  const std::size_t n = 1000;
+  /* Angles within [-2.5,8.8], where the rounding of the angle itself stays below the bounds. */
+  for (const double angleStep : { 0.0009, 0.0063, -0.0045 })
+  {
+    const auto           firstAngle = static_cast<TScalar>(-2.5);
+    const auto           step = static_cast<TScalar>(angleStep);
+    std::vector<TScalar> c(n);
+    std::vector<TScalar> s(n);
+    itk::PolarTransformKernels::IncrementalSinCos(firstAngle, step, 0, n, c.data(), s.data());
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      const TScalar alpha = firstAngle + static_cast<TScalar>(i) * step;
+      if (itk::Math::abs(c[i] - std::cos(alpha)) > tolerance || itk::Math::abs(s[i] - std::sin(alpha)) > tolerance)
+      {
+        std::cout << "IncrementalSinCos at " << alpha << ": " << c[i] << ", " << s[i] << " instead of "
+                  << std::cos(alpha) << ", " << std::sin(alpha) << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    for (const std::size_t first : { std::size_t{ 1 }, std::size_t{ 17 }, std::size_t{ 64 }, std::size_t{ 333 } })
+    {
+      std::vector<TScalar> pieceCos(n - first);
+      std::vector<TScalar> pieceSin(n - first);
+      itk::PolarTransformKernels::IncrementalSinCos(
+        firstAngle, step, first, n - first, pieceCos.data(), pieceSin.data());
+      for (std::size_t i = first; i < n; ++i)
+      {
+        if (!itk::Math::ExactlyEquals(pieceCos[i - first], c[i]) ||
+            !itk::Math::ExactlyEquals(pieceSin[i - first], s[i]))
+        {
+          std::cout << "IncrementalSinCos starting at " << first << " differs at " << i << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+
+/* Distance in ulp of T between a kernel result and a long double reference. */
+template <typename T>
+long double
+UlpDistance(const T value, const long double reference, const T scale)
+{
+  const T magnitude = std::abs(scale);
+  const T ulp = std::nextafter(magnitude, std::numeric_limits<T>::infinity()) - magnitude;
+  return std::abs(static_cast<long double>(value) - reference) / ulp;
+}
+
+
+/* Check the accuracy documented in PolarTransformKernels against atan2l, sinl and cosl, with the pack type TPack.
+ * Where long double is no wider than double, the reference itself may be off by one ulp of double. */
+template <typename T, typename TPack>
+int
+TestKernelUlp(const long double atanUlp)
+{
+  namespace K = itk::PolarTransformKernels;
+  constexpr std::size_t Width = TPack::Width;
+  const long double     slack = std::numeric_limits<long double>::digits > std::numeric_limits<T>::digits ? 0 : 1;
+
+  /* Points over twelve decades and all octants, angles within [-4*pi,4*pi] including the zeros of sine and cosine. */
+  std::vector<T> x;
+  std::vector<T> y;
+  std::vector<T> angles;
+  for (int i = -600; i <= 600; ++i)
+  {
+    const double magnitude = std::pow(10.0, i / 100.0);
+    for (int j = 0; j < 64; ++j)
+    {
+      const double direction = (j + 0.37 * (i & 7)) * 2.0 * itk::Math::pi / 64;
+      x.push_back(static_cast<T>(magnitude * std::cos(direction)));
+      y.push_back(static_cast<T>(magnitude * std::sin(direction)));
+      angles.push_back(static_cast<T>(i * itk::Math::pi / 150 + j * 1e-3));
+    }
+  }
+  for (int k = -8; k <= 8; ++k)
+  {
+    for (const int step : { -2, -1, 0, 1, 2 })
+    {
+      T angle = static_cast<T>(k * itk::Math::pi_over_2);
+      for (int s = 0; s < std::abs(step); ++s)
+      {
+        angle = std::nextafter(angle, step < 0 ? T(-100) : T(100));
+      }
+      angles.push_back(angle);
+    }
+  }
+  const std::size_t n = std::max(x.size(), angles.size()) / Width * Width;
+  x.resize(n, T(1));
+  y.resize(n, T(1));
+  angles.resize(n, T(0));
+
+  std::vector<T> alpha(n);
+  std::vector<T> sine(n);
+  std::vector<T> cosine(n);
+  std::vector<T> radius(n, T(0));
+  std::vector<T> outX(n);
+  std::vector<T> outY(n);
+  for (std::size_t i = 0; i < n; i += Width)
+  {
+    K::Atan2(TPack::Load(&y[i]), TPack::Load(&x[i])).Store(&alpha[i]);
+    TPack s;
+    TPack c;
+    K::SinCos(TPack::Load(&angles[i]), s, c);
+    s.Store(&sine[i]);
+    c.Store(&cosine[i]);
+  }
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    radius[i] = std::hypot(x[i], y[i]);
+  }
+  const K::Parameters<T> parameters;
+  for (std::size_t i = 0; i < n; i += Width)
+  {
+    K::PolarToCartesianBlock<TPack>(alpha.data(), radius.data(), outX.data(), outY.data(), i, parameters);
+  }
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    const long double referenceAlpha = atan2l(y[i], x[i]);
+    if (UlpDistance(alpha[i], referenceAlpha, static_cast<T>(referenceAlpha)) > atanUlp + slack)
+    {
+      std::cout << "Atan2(" << y[i] << ", " << x[i] << ") = " << alpha[i] << " is more than " << atanUlp
+                << " ulp from " << static_cast<T>(referenceAlpha) << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    /* Absolute bound: within one ulp of 1, i.e. the machine epsilon. */
+    const long double referenceSine = sinl(angles[i]);
+    const long double referenceCosine = cosl(angles[i]);
+    if (UlpDistance(sine[i], referenceSine, T(1)) > 1 + slack ||
+        UlpDistance(cosine[i], referenceCosine, T(1)) > 1 + slack)
+    {
+      std::cout << "SinCos(" << angles[i] << ") = " << sine[i] << ", " << cosine[i] << " is more than 1 ulp of 1 from "
+                << static_cast<T>(referenceSine) << ", " << static_cast<T>(referenceCosine) << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    /* Coordinates relative to the center, from the kernel's own angle. */
+    const long double referenceX = radius[i] * cosl(alpha[i]);
+    const long double referenceY = radius[i] * sinl(alpha[i]);
+    if (UlpDistance(outX[i], referenceX, radius[i]) > 4 + slack ||
+        UlpDistance(outY[i], referenceY, radius[i]) > 4 + slack)
+    {
+      std::cout << "PolarToCartesian(" << alpha[i] << ", " << radius[i] << ") = " << outX[i] << ", " << outY[i]
+                << " is more than 4 ulp of the radius from " << static_cast<T>(referenceX) << ", "
+                << static_cast<T>(referenceY) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkPolarTransformBatchTest(int, char *[])
+{
+  /* Float transforms compute in single precision with the float kernels. */
+  if (TestBatchPrecision<double>(1e-11) == EXIT_FAILURE || TestBatchPrecision<float>(2e-5) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  /* The ulp bounds documented in PolarTransformKernels, for the native and the scalar pack. */
+  using NativeDoublePack = itk::PolarTransformKernels::NativePack<double>::Type;
+  using NativeFloatPack = itk::PolarTransformKernels::NativePack<float>::Type;
+  if (TestKernelUlp<double, NativeDoublePack>(2) == EXIT_FAILURE ||
+      TestKernelUlp<double, itk::PolarTransformKernels::ScalarPack<double>>(2) == EXIT_FAILURE ||
+      TestKernelUlp<float, NativeFloatPack>(3) == EXIT_FAILURE ||
+      TestKernelUlp<float, itk::PolarTransformKernels::ScalarPack<float>>(3) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  /* The error bounds documented in PolarTransformEnums::AngleEvaluation. */
+  if (TestIncrementalSinCos<double>(3e-14) == EXIT_FAILURE || TestIncrementalSinCos<float>(4e-6) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,967 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+/* Throughput benchmark of the polar transforms and image filters.
+ *
+ * Measures points per second of TransformPoint() and TransformPoints() in both
+ * directions for float and double, dimensions 2 to 4, the ConstArcIncr and
+ * ReturnNaN options and both angle evaluations, of the inlined mapping
+ * functors that TransformPoint() delegates to, of the fused affine and polar
+ * transforms and of the CompositeTransform they replace, and output pixels
+ * per second of both image filters for several image sizes, interpolators and
+ * thread counts, and of PolarSamplingMap with float, Q8 and Q16 weights. Every measurement is repeated and reports the best and the
+ * mean time. Results are printed and optionally written as CSV and JSON, to
+ * compare releases:
+ *
+ *   PolarTransformBenchmark [--csv file] [--json file] [--points n] [--repetitions n]
+ *                           [--sizes n,n,...] [--large-sizes n,n,...] [--threads n,n,...] [--quick]
+ *
+ * --quick selects small problems, as used by the Benchmark test.
+ *
+ * The tiled traversal of CartesianToPolarImageFilter is also compared with the
+ * scanline traversal on the --large-sizes, by default the smallest power of two
+ * whose float image is four times the last level cache (4096 with --quick).
+ * On Linux the filter benchmarks count the last level cache misses of all
+ * threads with perf_event_open(); they are reported per update, and as -1 where
+ * the counters are not available, e.g. when perf_event_paranoid is above 2.
+ */
+
+#include "itkCartesianToPolarImageFilter.h"
+#include "itkPolarToCartesianImageFilter.h"
+#include "itkAffineCartesianToPolarTransform.h"
+#include "itkPolarToCartesianAffineTransform.h"
+#include "itkPolarMappingFunctors.h"
+#include "itkPolarSamplingMap.h"
+#include "itkCartesianToPolarTransform.h"
+#include "itkAffineTransform.h"
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTimeProbe.h"
+#include "itkVersion.h"
+#include "itkMath.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#  include <dirent.h>
+#  include <linux/perf_event.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#  include <cstring>
+#  include <cstdlib>
+#endif
+
+namespace
+{
+
+/* Zero and empty values are replaced by defaults depending on --quick. */
+struct BenchmarkSettings
+{
+  itk::SizeValueType        numberOfPoints{ 0 };
+  unsigned int              repetitions{ 0 };
+  std::vector<unsigned int> sizes;
+  std::vector<unsigned int> largeSizes;
+  std::vector<unsigned int> threads;
+};
+
+struct BenchmarkResult
+{
+  std::string        benchmark;
+  std::string        className;
+  std::string        scalar;
+  unsigned int       dimension;
+  std::string        options;
+  std::string        interpolator;
+  unsigned int       size;
+  unsigned int       threads;
+  itk::SizeValueType items;
+  double             bestSeconds;
+  double             meanSeconds;
+  /* Last level cache misses per repetition, -1 when not counted. */
+  double cacheMisses{ -1.0 };
+
+  double
+  GetItemsPerSecond() const
+  {
+    return bestSeconds > 0.0 ? items / bestSeconds : 0.0;
+  }
+};
+
+/* Sum of results, printed at the end so that the compiler cannot drop the benchmarked work. */
+double checksum = 0.0;
+
+/* Counts the last level cache misses in user space of all threads that exist when Start() is called, with one
+ * perf_event_open() counter per thread. Stop() returns -1 when counting is not supported. */
+class CacheMissCounter
+{
+public:
+  CacheMissCounter() = default;
+  CacheMissCounter(const CacheMissCounter &) = delete;
+  CacheMissCounter &
+  operator=(const CacheMissCounter &) = delete;
+  ~CacheMissCounter() { this->Close(); }
+
+  void
+  Start()
+  {
+    this->Close();
+#if defined(__linux__)
+    DIR * tasks = opendir("/proc/self/task");
+    if (tasks == nullptr)
+    {
+      return;
+    }
+    while (const dirent * task = readdir(tasks))
+    {
+      if (task->d_name[0] == '.')
+      {
+        continue;
+      }
+      perf_event_attr attributes;
+      std::memset(&attributes, 0, sizeof(attributes));
+      attributes.size = sizeof(attributes);
+      attributes.type = PERF_TYPE_HARDWARE;
+      attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+      attributes.exclude_kernel = 1;
+      attributes.exclude_hv = 1;
+      const auto descriptor = static_cast<int>(
+        syscall(SYS_perf_event_open, &attributes, std::atoi(task->d_name), -1, -1, static_cast<unsigned long>(0)));
+      if (descriptor < 0)
+      {
+        closedir(tasks);
+        this->Close();
+        return;
+      }
+      m_Descriptors.push_back(descriptor);
+      m_Start.push_back(Read(descriptor));
+    }
+    closedir(tasks);
+#endif
+  }
+
+  double
+  Stop()
+  {
+    if (m_Descriptors.empty())
+    {
+      return -1.0;
+    }
+    std::uint64_t misses = 0;
+    for (size_t i = 0; i < m_Descriptors.size(); ++i)
+    {
+      misses += Read(m_Descriptors[i]) - m_Start[i];
+    }
+    this->Close();
+    return static_cast<double>(misses);
+  }
+
+private:
+  static std::uint64_t
+  Read(const int descriptor)
+  {
+    std::uint64_t value = 0;
+#if defined(__linux__)
+    if (read(descriptor, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value)))
+    {
+      value = 0;
+    }
+#endif
+    return value;
+  }
+
+  void
+  Close()
+  {
+#if defined(__linux__)
+    for (const int descriptor : m_Descriptors)
+    {
+      close(descriptor);
+    }
+#endif
+    m_Descriptors.clear();
+    m_Start.clear();
+  }
+
+  std::vector<int>           m_Descriptors;
+  std::vector<std::uint64_t> m_Start;
+};
+
+/* Smallest power of two size whose size x size float image is four times the last level cache, at most 16384.
+ * Assumes a 32 MiB cache where its size is unknown. */
+unsigned int
+GetSizeBeyondLastLevelCache()
+{
+  long cacheSize = 0;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+  cacheSize = std::max(sysconf(_SC_LEVEL2_CACHE_SIZE), sysconf(_SC_LEVEL3_CACHE_SIZE));
+#endif
+  if (cacheSize <= 0)
+  {
+    cacheSize = 32L << 20;
+  }
+  unsigned int size = 1024;
+  while (size < 16384 && static_cast<double>(size) * size * sizeof(float) < 4.0 * cacheSize)
+  {
+    size *= 2;
+  }
+  return size;
+}
+
+template <typename T>
+const char *
+GetScalarName()
+{
+  return std::is_same<T, float>::value ? "float" : "double";
+}
+
+std::string
+FormatOptions(const bool constArcIncr, const bool returnNaN, const bool approximate)
+{
+  std::ostringstream options;
+  options << "ConstArcIncr=" << constArcIncr << ";ReturnNaN=" << returnNaN
+          << ";AngleEvaluation=" << (approximate ? "Approximate" : "Exact");
+  return options.str();
+}
+
+void
+AddResult(std::vector<BenchmarkResult> & results, const BenchmarkResult & result)
+{
+  std::cout << std::left << std::setw(16) << result.benchmark << std::setw(28) << result.className << std::setw(7)
+            << result.scalar << result.dimension << "D " << std::setw(28) << result.options << std::setw(16)
+            << result.interpolator << std::right << std::setw(6) << result.size << std::setw(4) << result.threads
+            << std::setw(14) << std::setprecision(4) << result.GetItemsPerSecond() << " /s";
+  if (result.cacheMisses >= 0.0)
+  {
+    std::cout << std::setw(12) << result.cacheMisses << " LLC misses";
+  }
+  std::cout << std::endl;
+  results.push_back(result);
+}
+
+/* Time the virtual TransformPoint() and the batch TransformPoints() of a transform. */
+template <typename TTransform>
+void
+BenchmarkTransform(const TTransform *                                        transform,
+                   const std::vector<typename TTransform::InputPointType> & points,
+                   const std::string &                                       options,
+                   const BenchmarkSettings &                                 settings,
+                   std::vector<BenchmarkResult> &                            results)
+{
+  using TransformBaseType = typename TTransform::Superclass;
+  using ScalarType = typename TTransform::ScalarType;
+
+  const TransformBaseType *                          base = transform;
+  std::vector<typename TTransform::OutputPointType> output(points.size());
+
+  itk::TimeProbe pointProbe;
+  itk::TimeProbe batchProbe;
+  for (unsigned int repetition = 0; repetition < settings.repetitions; ++repetition)
+  {
+    pointProbe.Start();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      output[i] = base->TransformPoint(points[i]);
+    }
+    pointProbe.Stop();
+    checksum += output.back()[0];
+
+    batchProbe.Start();
+    transform->TransformPoints(points.data(), output.data(), static_cast<itk::SizeValueType>(points.size()));
+    batchProbe.Stop();
+    checksum += output.back()[0];
+  }
+
+  BenchmarkResult result{ "TransformPoint",
+                          transform->GetNameOfClass(),
+                          GetScalarName<ScalarType>(),
+                          TTransform::SpaceDimension,
+                          options,
+                          "",
+                          0,
+                          1,
+                          static_cast<itk::SizeValueType>(points.size()),
+                          pointProbe.GetMinimum(),
+                          pointProbe.GetMean() };
+  AddResult(results, result);
+
+  result.benchmark = "TransformPoints";
+  result.bestSeconds = batchProbe.GetMinimum();
+  result.meanSeconds = batchProbe.GetMean();
+  AddResult(results, result);
+}
+
+/* Time a mapping functor inlined into the loop, without the virtual call of TransformPoint(). */
+template <typename TMapping, typename TPoint>
+void
+BenchmarkFunctor(const TMapping &               mapping,
+                 const char *                   className,
+                 const std::vector<TPoint> &    points,
+                 const std::string &            options,
+                 const BenchmarkSettings &      settings,
+                 std::vector<BenchmarkResult> & results)
+{
+  std::vector<TPoint> output(points.size());
+
+  itk::TimeProbe probe;
+  for (unsigned int repetition = 0; repetition < settings.repetitions; ++repetition)
+  {
+    probe.Start();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      output[i] = mapping(points[i]);
+    }
+    probe.Stop();
+    checksum += output.back()[0];
+  }
+
+  const BenchmarkResult result{ "Functor",
+                                className,
+                                GetScalarName<typename TMapping::ScalarType>(),
+                                TPoint::PointDimension,
+                                options,
+                                "",
+                                0,
+                                1,
+                                static_cast<itk::SizeValueType>(points.size()),
+                                probe.GetMinimum(),
+                                probe.GetMean() };
+  AddResult(results, result);
+}
+
+/* Time the TransformPoint() of a CompositeTransform, which has no batch path. */
+template <typename TComposite>
+void
+BenchmarkCompositeTransform(const TComposite *                                        composite,
+                            const std::vector<typename TComposite::InputPointType> & points,
+                            const std::string &                                       options,
+                            const BenchmarkSettings &                                 settings,
+                            std::vector<BenchmarkResult> &                            results)
+{
+  std::vector<typename TComposite::OutputPointType> output(points.size());
+
+  itk::TimeProbe pointProbe;
+  for (unsigned int repetition = 0; repetition < settings.repetitions; ++repetition)
+  {
+    pointProbe.Start();
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      output[i] = composite->TransformPoint(points[i]);
+    }
+    pointProbe.Stop();
+    checksum += output.back()[0];
+  }
+
+  const BenchmarkResult result{ "TransformPoint",
+                                composite->GetNameOfClass(),
+                                GetScalarName<typename TComposite::ScalarType>(),
+                                TComposite::InputSpaceDimension,
+                                options,
+                                "",
+                                0,
+                                1,
+                                static_cast<itk::SizeValueType>(points.size()),
+                                pointProbe.GetMinimum(),
+                                pointProbe.GetMean() };
+  AddResult(results, result);
+}
+
+/* Both transforms with all their options for one scalar type and dimension. */
+template <typename TScalar, unsigned int VDimension>
+void
+BenchmarkTransforms(const BenchmarkSettings & settings, std::vector<BenchmarkResult> & results)
+{
+  using P2CTransformType = itk::PolarToCartesianTransform<TScalar, VDimension>;
+  using C2PTransformType = itk::CartesianToPolarTransform<TScalar, VDimension>;
+  using PointType = itk::Point<TScalar, VDimension>;
+
+  /* Polar points cover [-pi,pi] on 1024 radii, cartesian points a square around the center. */
+  const itk::SizeValueType numberOfPoints = settings.numberOfPoints;
+  std::vector<PointType>   polarPoints(numberOfPoints);
+  std::vector<PointType>   arcPoints(numberOfPoints);
+  std::vector<PointType>   cartesianPoints(numberOfPoints);
+  for (itk::SizeValueType i = 0; i < numberOfPoints; ++i)
+  {
+    const double angle = itk::Math::twopi * static_cast<double>(i % 1000) / 999.0 - itk::Math::pi;
+    const double radius = 1.0 + static_cast<double>((i / 1000) % 1024);
+    for (unsigned int d = 2; d < VDimension; ++d)
+    {
+      polarPoints[i][d] = static_cast<TScalar>(d);
+      cartesianPoints[i][d] = static_cast<TScalar>(d);
+    }
+    polarPoints[i][0] = static_cast<TScalar>(angle);
+    polarPoints[i][1] = static_cast<TScalar>(radius);
+    arcPoints[i] = polarPoints[i];
+    arcPoints[i][0] = static_cast<TScalar>(angle * radius);
+    cartesianPoints[i][0] = static_cast<TScalar>(static_cast<double>(i % 1000) - 500.0);
+    cartesianPoints[i][1] = static_cast<TScalar>(static_cast<double>((i / 1000) % 1024) - 512.0);
+  }
+
+  /* The batch paths use the vectorized kernels in Approximate mode and libm per point in Exact mode. */
+  using AngleEvaluationEnum = itk::PolarTransformEnums::AngleEvaluation;
+  auto p2c = P2CTransformType::New();
+  auto c2p = C2PTransformType::New();
+  for (const bool approximate : { false, true })
+  {
+    const AngleEvaluationEnum angleEvaluation =
+      approximate ? AngleEvaluationEnum::Approximate : AngleEvaluationEnum::Exact;
+    p2c->SetAngleEvaluation(angleEvaluation);
+    c2p->SetAngleEvaluation(angleEvaluation);
+    for (const bool constArcIncr : { false, true })
+    {
+      for (const bool returnNaN : { false, true })
+      {
+        p2c->SetConstArcIncr(constArcIncr);
+        p2c->SetReturnNaN(returnNaN);
+        BenchmarkTransform(p2c.GetPointer(),
+                           constArcIncr ? arcPoints : polarPoints,
+                           FormatOptions(constArcIncr, returnNaN, approximate),
+                           settings,
+                           results);
+      }
+
+      c2p->SetConstArcIncr(constArcIncr);
+      BenchmarkTransform(
+        c2p.GetPointer(), cartesianPoints, FormatOptions(constArcIncr, false, approximate), settings, results);
+    }
+
+    /* The functors that TransformPoint() delegates to, with the default options. */
+    if (approximate)
+    {
+      BenchmarkFunctor(
+        itk::Functor::PolarToCartesianMapping<TScalar, false, false, false, AngleEvaluationEnum::Approximate>(),
+        "PolarToCartesianMapping",
+        polarPoints,
+        FormatOptions(false, false, approximate),
+        settings,
+        results);
+      BenchmarkFunctor(itk::Functor::CartesianToPolarMapping<TScalar, false, false, AngleEvaluationEnum::Approximate>(),
+                       "CartesianToPolarMapping",
+                       cartesianPoints,
+                       FormatOptions(false, false, approximate),
+                       settings,
+                       results);
+    }
+    else
+    {
+      BenchmarkFunctor(itk::Functor::PolarToCartesianMapping<TScalar>(),
+                       "PolarToCartesianMapping",
+                       polarPoints,
+                       FormatOptions(false, false, approximate),
+                       settings,
+                       results);
+      BenchmarkFunctor(itk::Functor::CartesianToPolarMapping<TScalar>(),
+                       "CartesianToPolarMapping",
+                       cartesianPoints,
+                       FormatOptions(false, false, approximate),
+                       settings,
+                       results);
+    }
+  }
+
+  /* An affine alignment chained with the polar transforms, as composite and fused. */
+  auto affine = itk::AffineTransform<TScalar, VDimension>::New();
+  affine->Rotate(0, 1, 0.3);
+  affine->Scale(1.1);
+  typename itk::AffineTransform<TScalar, VDimension>::OutputVectorType translation;
+  translation.Fill(2.5);
+  affine->Translate(translation);
+  p2c->SetConstArcIncr(false);
+  p2c->SetReturnNaN(false);
+  c2p->SetConstArcIncr(false);
+
+  auto c2pComposite = itk::CompositeTransform<TScalar, VDimension>::New();
+  c2pComposite->AddTransform(c2p);
+  c2pComposite->AddTransform(affine);
+  BenchmarkCompositeTransform(c2pComposite.GetPointer(), cartesianPoints, "Affine+C2P", settings, results);
+  auto c2pFused = itk::AffineCartesianToPolarTransform<TScalar, VDimension>::New();
+  c2pFused->SetFromCompositeTransform(c2pComposite);
+  BenchmarkTransform(c2pFused.GetPointer(), cartesianPoints, "Affine+C2P", settings, results);
+
+  auto p2cComposite = itk::CompositeTransform<TScalar, VDimension>::New();
+  p2cComposite->AddTransform(affine);
+  p2cComposite->AddTransform(p2c);
+  BenchmarkCompositeTransform(p2cComposite.GetPointer(), polarPoints, "P2C+Affine", settings, results);
+  auto p2cFused = itk::PolarToCartesianAffineTransform<TScalar, VDimension>::New();
+  p2cFused->SetFromCompositeTransform(p2cComposite);
+  BenchmarkTransform(p2cFused.GetPointer(), polarPoints, "P2C+Affine", settings, results);
+}
+
+/* Time a filter with its current interpolator for each thread count, and count its cache misses. */
+template <typename TFilter>
+void
+BenchmarkFilterThreads(TFilter *                      filter,
+                       const unsigned int             size,
+                       const std::string &            options,
+                       const std::string &            interpolatorName,
+                       const BenchmarkSettings &      settings,
+                       std::vector<BenchmarkResult> & results)
+{
+  using ImageType = typename TFilter::InputImageType;
+
+  for (const unsigned int threads : settings.threads)
+  {
+    filter->GetMultiThreader()->SetMaximumNumberOfThreads(threads);
+    filter->SetNumberOfWorkUnits(threads);
+
+    // the first update starts the threads, which are only counted when they exist before the measurement
+    filter->Modified();
+    filter->Update();
+
+    CacheMissCounter counter;
+    counter.Start();
+    itk::TimeProbe probe;
+    for (unsigned int repetition = 0; repetition < settings.repetitions; ++repetition)
+    {
+      filter->Modified();
+      probe.Start();
+      filter->Update();
+      probe.Stop();
+    }
+    const double cacheMisses = counter.Stop();
+    checksum += filter->GetOutput()->GetBufferPointer()[0];
+
+    const BenchmarkResult result{ "Resample",
+                                  filter->GetNameOfClass(),
+                                  "float",
+                                  ImageType::ImageDimension,
+                                  options,
+                                  interpolatorName,
+                                  size,
+                                  threads,
+                                  filter->GetOutput()->GetLargestPossibleRegion().GetNumberOfPixels(),
+                                  probe.GetMinimum(),
+                                  probe.GetMean(),
+                                  cacheMisses < 0.0 ? cacheMisses : cacheMisses / settings.repetitions };
+    AddResult(results, result);
+  }
+}
+
+/* Time a filter with each interpolator and thread count. */
+template <typename TFilter>
+void
+BenchmarkFilter(TFilter *                      filter,
+                const unsigned int             size,
+                const std::string &            options,
+                const BenchmarkSettings &      settings,
+                std::vector<BenchmarkResult> & results)
+{
+  using ImageType = typename TFilter::InputImageType;
+  using InterpolatorType = typename TFilter::InterpolatorType;
+
+  std::vector<std::pair<std::string, typename InterpolatorType::Pointer>> interpolators;
+  interpolators.emplace_back("NearestNeighbor", itk::NearestNeighborInterpolateImageFunction<ImageType, double>::New());
+  interpolators.emplace_back("Linear", itk::LinearInterpolateImageFunction<ImageType, double>::New());
+  interpolators.emplace_back("BSpline3", itk::BSplineInterpolateImageFunction<ImageType, double, double>::New());
+
+  for (const auto & interpolator : interpolators)
+  {
+    filter->SetInterpolator(interpolator.second);
+    BenchmarkFilterThreads(filter, size, options, interpolator.first, settings, results);
+  }
+}
+
+/* A size x size float image with a smooth pattern. */
+itk::Image<float, 2>::Pointer
+MakeCartesianImage(const unsigned int size)
+{
+  using ImageType = itk::Image<float, 2>;
+
+  ImageType::SizeType imageSize;
+  imageSize.Fill(size);
+
+  auto cartesianImage = ImageType::New();
+  cartesianImage->SetRegions(ImageType::RegionType(imageSize));
+  cartesianImage->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(cartesianImage, cartesianImage->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(static_cast<float>(std::sin(0.05 * index[0]) * std::cos(0.03 * index[1])));
+  }
+  return cartesianImage;
+}
+
+/* Resample size x size images between a square cartesian grid and a full polar grid. */
+void
+BenchmarkFilters(const BenchmarkSettings & settings, std::vector<BenchmarkResult> & results)
+{
+  using ImageType = itk::Image<float, 2>;
+  using C2PFilterType = itk::CartesianToPolarImageFilter<ImageType, ImageType>;
+  using P2CFilterType = itk::PolarToCartesianImageFilter<ImageType, ImageType>;
+
+  for (const unsigned int size : settings.sizes)
+  {
+    ImageType::SizeType imageSize;
+    imageSize.Fill(size);
+
+    const ImageType::Pointer cartesianImage = MakeCartesianImage(size);
+
+    ImageType::PointType center;
+    center.Fill(0.5 * (size - 1));
+
+    ImageType::SpacingType polarSpacing;
+    polarSpacing[0] = itk::Math::twopi / size;
+    polarSpacing[1] = 0.5;
+    ImageType::PointType polarOrigin;
+    polarOrigin.Fill(0.0);
+
+    auto c2p = C2PFilterType::New();
+    c2p->SetInput(cartesianImage);
+    c2p->SetSize(imageSize);
+    c2p->SetOutputSpacing(polarSpacing);
+    c2p->SetOutputOrigin(polarOrigin);
+    c2p->SetCenter(center);
+    BenchmarkFilter(c2p.GetPointer(), size, "ConstArcIncr=0", settings, results);
+
+    /* Scanlines at large radii read distant input rows, which the tiles keep in cache. */
+    c2p->UseTiledTraversalOn();
+    BenchmarkFilter(c2p.GetPointer(), size, "ConstArcIncr=0;TiledTraversal=1", settings, results);
+    c2p->UseTiledTraversalOff();
+
+    /* The polar image resampled back. */
+    c2p->SetInterpolator(C2PFilterType::DefaultInterpolatorType::New());
+    c2p->Update();
+    const ImageType::Pointer polarImage = c2p->GetOutput();
+    polarImage->DisconnectPipeline();
+
+    auto p2c = P2CFilterType::New();
+    p2c->SetInput(polarImage);
+    p2c->SetSize(imageSize);
+    p2c->SetOutputSpacing(cartesianImage->GetSpacing());
+    p2c->SetOutputOrigin(cartesianImage->GetOrigin());
+    p2c->SetCenter(center);
+    BenchmarkFilter(p2c.GetPointer(), size, "ConstArcIncr=0", settings, results);
+  }
+}
+
+/* Compare the tiled and the scanline traversal of CartesianToPolarImageFilter on images beyond the last level
+ * cache, where the scanlines at large radii evict the input rows before the next scanline reads them again. */
+void
+BenchmarkTiledTraversal(const BenchmarkSettings & settings, std::vector<BenchmarkResult> & results)
+{
+  using ImageType = itk::Image<float, 2>;
+  using C2PFilterType = itk::CartesianToPolarImageFilter<ImageType, ImageType>;
+
+  for (const unsigned int size : settings.largeSizes)
+  {
+    ImageType::SizeType imageSize;
+    imageSize.Fill(size);
+
+    ImageType::PointType center;
+    center.Fill(0.5 * (size - 1));
+
+    ImageType::SpacingType polarSpacing;
+    polarSpacing[0] = itk::Math::twopi / size;
+    polarSpacing[1] = 0.5;
+    ImageType::PointType polarOrigin;
+    polarOrigin.Fill(0.0);
+
+    auto c2p = C2PFilterType::New();
+    c2p->SetInput(MakeCartesianImage(size));
+    c2p->SetSize(imageSize);
+    c2p->SetOutputSpacing(polarSpacing);
+    c2p->SetOutputOrigin(polarOrigin);
+    c2p->SetCenter(center);
+    BenchmarkFilterThreads(c2p.GetPointer(), size, "ConstArcIncr=0;TiledTraversal=0", "Linear", settings, results);
+
+    c2p->UseTiledTraversalOn();
+    BenchmarkFilterThreads(c2p.GetPointer(), size, "ConstArcIncr=0;TiledTraversal=1", "Linear", settings, results);
+  }
+}
+
+/* Scan convert size x size 8 bit polar frames into size x size sector images with a PolarSamplingMap, with float,
+ * Q8 and Q16 weights. The map is built before the measurement, which times Apply() only. */
+void
+BenchmarkSamplingMap(const BenchmarkSettings & settings, std::vector<BenchmarkResult> & results)
+{
+  using ImageType = itk::Image<unsigned char, 2>;
+  using MapType = itk::PolarSamplingMap<ImageType>;
+  using TransformType = itk::CartesianToPolarTransform<double, 2>;
+
+  const unsigned int defaultThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  for (const unsigned int size : settings.sizes)
+  {
+    ImageType::SizeType imageSize;
+    imageSize.Fill(size);
+
+    /* Angles over a quarter turn along the first axis, radii along the second. */
+    ImageType::SpacingType polarSpacing;
+    polarSpacing[0] = 0.5 * itk::Math::pi / size;
+    polarSpacing[1] = 1.0;
+    ImageType::PointType polarOrigin;
+    polarOrigin[0] = 0.25 * itk::Math::pi;
+    polarOrigin[1] = 0.0;
+
+    auto frame = ImageType::New();
+    frame->SetRegions(ImageType::RegionType(imageSize));
+    frame->SetSpacing(polarSpacing);
+    frame->SetOrigin(polarOrigin);
+    frame->Allocate();
+    itk::ImageRegionIteratorWithIndex<ImageType> it(frame, frame->GetLargestPossibleRegion());
+    for (; !it.IsAtEnd(); ++it)
+    {
+      const ImageType::IndexType index = it.GetIndex();
+      it.Set(static_cast<unsigned char>((index[0] * 37 + index[1] * 11) % 256));
+    }
+
+    ImageType::PointType origin;
+    origin[0] = -0.5 * size;
+    origin[1] = 0.0;
+
+    auto map = MapType::New();
+    map->SetTransform(TransformType::New());
+    map->SetSize(imageSize);
+    map->SetOutputOrigin(origin);
+
+    auto output = ImageType::New();
+    for (const unsigned int bits : { 0u, 8u, 16u })
+    {
+      map->SetFixedPointWeightBits(bits);
+      map->Build(frame);
+      const std::string options = bits == 0 ? "Weights=float" : "Weights=Q" + std::to_string(bits);
+
+      for (const unsigned int threads : settings.threads)
+      {
+        /* Apply() splits the map over the global default number of threads. */
+        itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(threads);
+        map->Apply(frame, output);
+
+        CacheMissCounter counter;
+        counter.Start();
+        itk::TimeProbe probe;
+        for (unsigned int repetition = 0; repetition < settings.repetitions; ++repetition)
+        {
+          probe.Start();
+          map->Apply(frame, output);
+          probe.Stop();
+        }
+        const double cacheMisses = counter.Stop();
+        checksum += output->GetBufferPointer()[0];
+
+        const BenchmarkResult result{ "SamplingMap",
+                                      map->GetNameOfClass(),
+                                      "uchar",
+                                      2,
+                                      options,
+                                      "Linear",
+                                      size,
+                                      threads,
+                                      map->GetNumberOfSamples(),
+                                      probe.GetMinimum(),
+                                      probe.GetMean(),
+                                      cacheMisses < 0.0 ? cacheMisses : cacheMisses / settings.repetitions };
+        AddResult(results, result);
+      }
+    }
+  }
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(defaultThreads);
+}
+
+bool
+WriteCSV(const std::string & fileName, const std::vector<BenchmarkResult> & results)
+{
+  std::ofstream file(fileName);
+  file << "benchmark,class,scalar,dimension,options,interpolator,size,threads,items,best_seconds,mean_seconds,"
+          "items_per_second,cache_misses\n";
+  file << std::setprecision(9);
+  for (const BenchmarkResult & result : results)
+  {
+    file << result.benchmark << ',' << result.className << ',' << result.scalar << ',' << result.dimension << ','
+         << result.options << ',' << result.interpolator << ',' << result.size << ',' << result.threads << ','
+         << result.items << ',' << result.bestSeconds << ',' << result.meanSeconds << ','
+         << result.GetItemsPerSecond() << ',' << result.cacheMisses << '\n';
+  }
+  return static_cast<bool>(file);
+}
+
+bool
+WriteJSON(const std::string &                  fileName,
+          const BenchmarkSettings &            settings,
+          const std::vector<BenchmarkResult> & results)
+{
+  std::ofstream file(fileName);
+  file << std::setprecision(9);
+  file << "{\n";
+  file << "  \"itk_version\": \"" << itk::Version::GetITKVersion() << "\",\n";
+  file << "  \"double_pack_width\": " << itk::PolarTransformKernels::NativePack<double>::Type::Width << ",\n";
+  file << "  \"float_pack_width\": " << itk::PolarTransformKernels::NativePack<float>::Type::Width << ",\n";
+  file << "  \"repetitions\": " << settings.repetitions << ",\n";
+  file << "  \"results\": [\n";
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    const BenchmarkResult & result = results[i];
+    file << "    { \"benchmark\": \"" << result.benchmark << "\", \"class\": \"" << result.className
+         << "\", \"scalar\": \"" << result.scalar << "\", \"dimension\": " << result.dimension << ", \"options\": \""
+         << result.options << "\", \"interpolator\": \"" << result.interpolator << "\", \"size\": " << result.size
+         << ", \"threads\": " << result.threads << ", \"items\": " << result.items
+         << ", \"best_seconds\": " << result.bestSeconds << ", \"mean_seconds\": " << result.meanSeconds
+         << ", \"items_per_second\": " << result.GetItemsPerSecond() << ", \"cache_misses\": " << result.cacheMisses
+         << " }" << (i + 1 < results.size() ? "," : "") << '\n';
+  }
+  file << "  ]\n";
+  file << "}\n";
+  return static_cast<bool>(file);
+}
+
+std::vector<unsigned int>
+ParseList(const std::string & list)
+{
+  std::vector<unsigned int> values;
+  std::istringstream        stream(list);
+  std::string               value;
+  while (std::getline(stream, value, ','))
+  {
+    values.push_back(static_cast<unsigned int>(std::stoul(value)));
+  }
+  return values;
+}
+
+} // namespace
+
+int
+main(int argc, char * argv[])
+{
+  BenchmarkSettings settings;
+  std::string       csvFileName;
+  std::string       jsonFileName;
+  bool              quick = false;
+
+  try
+  {
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string argument = argv[i];
+      const bool        hasValue = i + 1 < argc;
+      if (argument == "--quick")
+      {
+        quick = true;
+      }
+      else if (argument == "--csv" && hasValue)
+      {
+        csvFileName = argv[++i];
+      }
+      else if (argument == "--json" && hasValue)
+      {
+        jsonFileName = argv[++i];
+      }
+      else if (argument == "--points" && hasValue)
+      {
+        settings.numberOfPoints = std::stoul(argv[++i]);
+      }
+      else if (argument == "--repetitions" && hasValue)
+      {
+        settings.repetitions = static_cast<unsigned int>(std::stoul(argv[++i]));
+      }
+      else if (argument == "--sizes" && hasValue)
+      {
+        settings.sizes = ParseList(argv[++i]);
+      }
+      else if (argument == "--large-sizes" && hasValue)
+      {
+        settings.largeSizes = ParseList(argv[++i]);
+      }
+      else if (argument == "--threads" && hasValue)
+      {
+        settings.threads = ParseList(argv[++i]);
+      }
+      else
+      {
+        throw std::invalid_argument(argument);
+      }
+    }
+  }
+  catch (const std::exception & exception)
+  {
+    std::cerr << "Invalid argument: " << exception.what() << std::endl;
+    std::cerr << "Usage: " << argv[0]
+              << " [--csv file] [--json file] [--points n] [--repetitions n] [--sizes n,n,...]"
+                 " [--large-sizes n,n,...] [--threads n,n,...] [--quick]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const unsigned int maximumThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  if (settings.numberOfPoints == 0)
+  {
+    settings.numberOfPoints = quick ? 1u << 14 : 1u << 20;
+  }
+  if (settings.repetitions == 0)
+  {
+    settings.repetitions = quick ? 2 : 5;
+  }
+  if (settings.sizes.empty())
+  {
+    settings.sizes = quick ? std::vector<unsigned int>{ 64, 128 } : std::vector<unsigned int>{ 256, 1024, 2048 };
+  }
+  if (settings.largeSizes.empty())
+  {
+    settings.largeSizes.push_back(quick ? 4096 : GetSizeBeyondLastLevelCache());
+  }
+  if (settings.threads.empty())
+  {
+    for (unsigned int threads = 1; threads < maximumThreads; threads *= quick ? maximumThreads : 2)
+    {
+      settings.threads.push_back(threads);
+    }
+    settings.threads.push_back(maximumThreads);
+  }
+
+  std::vector<BenchmarkResult> results;
+  try
+  {
+    BenchmarkTransforms<double, 2>(settings, results);
+    BenchmarkTransforms<double, 3>(settings, results);
+    BenchmarkTransforms<double, 4>(settings, results);
+    BenchmarkTransforms<float, 2>(settings, results);
+    BenchmarkTransforms<float, 3>(settings, results);
+    BenchmarkTransforms<float, 4>(settings, results);
+    BenchmarkFilters(settings, results);
+    BenchmarkTiledTraversal(settings, results);
+    BenchmarkSamplingMap(settings, results);
+  }
+  catch (const itk::ExceptionObject & exception)
+  {
+    std::cerr << exception << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Checksum: " << checksum << std::endl;
+
+  if (!csvFileName.empty() && !WriteCSV(csvFileName, results))
+  {
+    std::cerr << "Cannot write " << csvFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (!jsonFileName.empty() && !WriteJSON(jsonFileName, settings, results))
+  {
+    std::cerr << "Cannot write " << jsonFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
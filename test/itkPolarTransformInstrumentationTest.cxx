@@ -0,0 +1,156 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkCartesianToPolarImageFilter.h"
+#include "itkPolarToCartesianImageFilter.h"
+#include "itkPolarTransformInstrumentation.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <vector>
+
+namespace
+{
+
+/* The expected counts if the module collects statistics, and zero otherwise. */
+itk::SizeValueType
+Expected(const itk::SizeValueType count)
+{
+  return itk::PolarTransformCounters::Enabled ? count : 0;
+}
+
+} // namespace
+
+int
+itkPolarTransformInstrumentationTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 2;
+  using P2CTransformType = itk::PolarToCartesianTransform<double, Dimension>;
+  using C2PTransformType = itk::CartesianToPolarTransform<double, Dimension>;
+  using PointType = P2CTransformType::InputPointType;
+  using ImageType = itk::Image<float, Dimension>;
+
+  std::cout << "Instrumentation " << (itk::PolarTransformCounters::Enabled ? "enabled" : "disabled") << std::endl;
+
+  /* Polar points in range, outside [-pi,pi] and at the center, through both batch layouts. */
+  auto p2c = P2CTransformType::New();
+  p2c->ReturnNaNOn();
+  std::vector<PointType> polarPoints(4);
+  polarPoints[0][0] = 0.5;
+  polarPoints[0][1] = 1.0;
+  polarPoints[1][0] = 4.0;
+  polarPoints[1][1] = 2.0;
+  polarPoints[2][0] = -4.0;
+  polarPoints[2][1] = 1.0;
+  polarPoints[3][0] = 1.0;
+  polarPoints[3][1] = 0.0;
+
+  std::vector<PointType> cartesianPoints(polarPoints.size());
+  p2c->TransformPoints(polarPoints.data(), cartesianPoints.data(), polarPoints.size());
+
+  std::vector<double> alpha{ 0.5, 4.0, -4.0, 1.0 };
+  std::vector<double> radius{ 1.0, 2.0, 1.0, 0.0 };
+  const double *      inputComponents[Dimension] = { alpha.data(), radius.data() };
+  double * const      outputComponents[Dimension] = { alpha.data(), radius.data() };
+  p2c->TransformPoints(inputComponents, outputComponents, polarPoints.size());
+
+  itk::PolarTransformStatistics statistics = p2c->GetEvaluationStatistics();
+  std::cout << "PolarToCartesianTransform: " << statistics << std::endl;
+  ITK_TEST_EXPECT_EQUAL(statistics.Evaluated, Expected(8));
+  ITK_TEST_EXPECT_EQUAL(statistics.OutOfRange, Expected(4));
+  ITK_TEST_EXPECT_EQUAL(statistics.NaN, Expected(4));
+  ITK_TEST_EXPECT_EQUAL(statistics.DegenerateCenter, Expected(2));
+  ITK_TEST_EXPECT_TRUE(statistics.TransformSeconds >= 0.0);
+  ITK_TEST_EXPECT_EQUAL(statistics.InterpolationSeconds, 0.0);
+
+  /* TransformPoint() is not counted, and ResetEvaluationStatistics() clears the counts. */
+  p2c->TransformPoint(polarPoints[1]);
+  ITK_TEST_EXPECT_EQUAL(p2c->GetEvaluationStatistics().Evaluated, Expected(8));
+  p2c->ResetEvaluationStatistics();
+  ITK_TEST_EXPECT_EQUAL(p2c->GetEvaluationStatistics().Evaluated, 0);
+  ITK_TEST_EXPECT_EQUAL(p2c->GetEvaluationStatistics().TransformSeconds, 0.0);
+
+  /* Cartesian points, one at the center. */
+  auto      c2p = C2PTransformType::New();
+  PointType center;
+  center[0] = 1.0;
+  center[1] = 2.0;
+  c2p->SetCenter(center);
+  std::vector<PointType> points(3, center);
+  points[1][0] = 3.0;
+  points[2][1] = 5.0;
+  c2p->TransformPoints(points.data(), points.data(), points.size());
+
+  statistics = c2p->GetEvaluationStatistics();
+  std::cout << "CartesianToPolarTransform: " << statistics << std::endl;
+  ITK_TEST_EXPECT_EQUAL(statistics.Evaluated, Expected(3));
+  ITK_TEST_EXPECT_EQUAL(statistics.DegenerateCenter, Expected(1));
+  ITK_TEST_EXPECT_EQUAL(statistics.NaN, 0);
+  ITK_TEST_EXPECT_EQUAL(statistics.OutOfRange, 0);
+
+  /* A polar image whose first row is at the center and whose outer rows leave the input. */
+  ImageType::SizeType inputSize;
+  inputSize.Fill(32);
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(inputSize));
+  image->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(it.GetIndex()[0] + it.GetIndex()[1]));
+  }
+
+  center.Fill(15.5);
+  auto c2pFilter = itk::CartesianToPolarImageFilter<ImageType, ImageType>::New();
+  c2pFilter->SetInput(image);
+  c2pFilter->SetCenter(center);
+  ImageType::SizeType polarSize;
+  polarSize[0] = 64;
+  polarSize[1] = 24;
+  c2pFilter->SetSize(polarSize);
+  ImageType::SpacingType polarSpacing;
+  polarSpacing[0] = itk::Math::twopi / 64;
+  polarSpacing[1] = 1.0;
+  c2pFilter->SetOutputSpacing(polarSpacing);
+  ITK_TRY_EXPECT_NO_EXCEPTION(c2pFilter->Update());
+
+  statistics = c2pFilter->GetEvaluationStatistics();
+  std::cout << "CartesianToPolarImageFilter: " << statistics << std::endl;
+  c2pFilter->Print(std::cout);
+  ITK_TEST_EXPECT_EQUAL(statistics.Evaluated, Expected(64 * 24));
+  ITK_TEST_EXPECT_EQUAL(statistics.DegenerateCenter, Expected(64));
+  ITK_TEST_EXPECT_TRUE(statistics.OutOfRange > 0 || !itk::PolarTransformCounters::Enabled);
+  ITK_TEST_EXPECT_TRUE(statistics.OutOfRange < statistics.Evaluated || !itk::PolarTransformCounters::Enabled);
+  ITK_TEST_EXPECT_TRUE(statistics.TransformSeconds >= 0.0 && statistics.InterpolationSeconds >= 0.0);
+
+  /* The polar image back onto the cartesian grid of the input. */
+  auto p2cFilter = itk::PolarToCartesianImageFilter<ImageType, ImageType>::New();
+  p2cFilter->SetInput(c2pFilter->GetOutput());
+  p2cFilter->SetCenter(center);
+  p2cFilter->SetSize(inputSize);
+  ITK_TRY_EXPECT_NO_EXCEPTION(p2cFilter->Update());
+
+  statistics = p2cFilter->GetEvaluationStatistics();
+  std::cout << "PolarToCartesianImageFilter: " << statistics << std::endl;
+  ITK_TEST_EXPECT_EQUAL(statistics.Evaluated, Expected(32 * 32));
+  ITK_TEST_EXPECT_TRUE(statistics.OutOfRange < statistics.Evaluated || !itk::PolarTransformCounters::Enabled);
+
+  p2cFilter->ResetEvaluationStatistics();
+  ITK_TEST_EXPECT_EQUAL(p2cFilter->GetEvaluationStatistics().Evaluated, 0);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,213 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPolarToCartesianTransform.h"
+#include "itkCartesianToPolarTransform.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <vector>
+
+namespace
+{
+
+/* Compare the analytic Jacobians, vector transforms and the inverse transform with numerical results. */
+template <typename TTransform>
+bool
+CheckTransform(const TTransform * transform, const std::vector<typename TTransform::InputPointType> & points)
+{
+  using InputPointType = typename TTransform::InputPointType;
+  using OutputPointType = typename TTransform::OutputPointType;
+  constexpr unsigned int Dimension = TTransform::SpaceDimension;
+  const double           step = 1e-6;
+  const double           epsilon = 1e-5;
+
+  const auto inverse = transform->GetInverseTransform();
+  if (inverse.IsNull())
+  {
+    std::cout << transform->GetNameOfClass() << ": no inverse transform." << std::endl;
+    return false;
+  }
+
+  for (const InputPointType & point : points)
+  {
+    typename TTransform::JacobianPositionType jacobian;
+    transform->ComputeJacobianWithRespectToPosition(point, jacobian);
+    typename TTransform::InverseJacobianPositionType inverseJacobian;
+    transform->ComputeInverseJacobianWithRespectToPosition(point, inverseJacobian);
+
+    /* Central differences. */
+    for (unsigned int j = 0; j < Dimension; ++j)
+    {
+      InputPointType forward = point;
+      InputPointType backward = point;
+      forward[j] += step;
+      backward[j] -= step;
+      const OutputPointType forwardPoint = transform->TransformPoint(forward);
+      const OutputPointType backwardPoint = transform->TransformPoint(backward);
+      for (unsigned int i = 0; i < Dimension; ++i)
+      {
+        const double numerical = (forwardPoint[i] - backwardPoint[i]) / (2.0 * step);
+        if (itk::Math::abs(numerical - jacobian(i, j)) > epsilon * (1.0 + itk::Math::abs(numerical)))
+        {
+          std::cout << transform->GetNameOfClass() << ": Jacobian(" << i << "," << j << ") at " << point
+                    << " is " << jacobian(i, j) << ", numerically " << numerical << std::endl;
+          return false;
+        }
+      }
+    }
+
+    /* The inverse Jacobian inverts the Jacobian. */
+    const auto product = inverseJacobian * jacobian;
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      for (unsigned int j = 0; j < Dimension; ++j)
+      {
+        if (itk::Math::abs(product(i, j) - (i == j ? 1.0 : 0.0)) > 1e-9)
+        {
+          std::cout << transform->GetNameOfClass() << ": inverse Jacobian at " << point << " is not an inverse."
+                    << std::endl;
+          return false;
+        }
+      }
+    }
+
+    /* Vectors transform with the Jacobian, covariant vectors with its inverse transpose. */
+    typename TTransform::InputVectorType          vector;
+    typename TTransform::InputCovariantVectorType covariantVector;
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      vector[d] = 0.5 + d;
+      covariantVector[d] = 1.5 - d;
+    }
+    const auto transformedVector = transform->TransformVector(vector, point);
+    const auto transformedCovariantVector = transform->TransformCovariantVector(covariantVector, point);
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      double expectedVector = 0.0;
+      double expectedCovariantVector = 0.0;
+      for (unsigned int j = 0; j < Dimension; ++j)
+      {
+        expectedVector += jacobian(i, j) * vector[j];
+        expectedCovariantVector += inverseJacobian(j, i) * covariantVector[j];
+      }
+      if (itk::Math::abs(transformedVector[i] - expectedVector) > 1e-9 * (1.0 + itk::Math::abs(expectedVector)) ||
+          itk::Math::abs(transformedCovariantVector[i] - expectedCovariantVector) >
+            1e-9 * (1.0 + itk::Math::abs(expectedCovariantVector)))
+      {
+        std::cout << transform->GetNameOfClass() << ": vector transform at " << point << " differs." << std::endl;
+        return false;
+      }
+    }
+
+    /* The inverse transform maps back. */
+    const InputPointType roundTrip = inverse->TransformPoint(transform->TransformPoint(point));
+    if (point.EuclideanDistanceTo(roundTrip) > 1e-9 * (1.0 + point.GetVectorFromOrigin().GetNorm()))
+    {
+      std::cout << transform->GetNameOfClass() << ": inverse transform maps " << point << " to " << roundTrip
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int
+itkPolarTransformJacobianTest(int, char *[])
+{
+  constexpr unsigned int Dimension = 3;
+
+  using P2CTransformType = itk::PolarToCartesianTransform<double, Dimension>;
+  using C2PTransformType = itk::CartesianToPolarTransform<double, Dimension>;
+  using PointType = itk::Point<double, Dimension>;
+
+  auto p2c = P2CTransformType::New();
+  auto c2p = C2PTransformType::New();
+
+  PointType center;
+  center[0] = -1.0;
+  center[1] = 0.5;
+  center[2] = 0.0;
+  p2c->SetCenter(center);
+  c2p->SetCenter(center);
+
+  /* The transform has no parameters. */
+  P2CTransformType::JacobianType parameterJacobian;
+  p2c->ComputeJacobianWithRespectToParameters(center, parameterJacobian);
+  ITK_TEST_EXPECT_EQUAL(parameterJacobian.rows(), Dimension);
+  ITK_TEST_EXPECT_EQUAL(parameterJacobian.cols(), 0u);
+
+  /* Polar points with angles in [0,2*pi), where the inverse maps back. */
+  std::vector<PointType> polarPoints;
+  for (unsigned int i = 0; i < 12; ++i)
+  {
+    for (unsigned int j = 0; j < 6; ++j)
+    {
+      PointType p;
+      p[0] = 0.1 + 0.5 * i;
+      p[1] = 1.0 + 1.7 * j;
+      p[2] = 0.5 * j;
+      polarPoints.push_back(p);
+    }
+  }
+
+  for (const double angleOffset : { 0.0, 0.3 })
+  {
+    for (const bool constArcIncr : { false, true })
+    {
+      p2c->SetAngleOffset(angleOffset);
+      p2c->SetConstArcIncr(constArcIncr);
+      c2p->SetAngleOffset(angleOffset);
+      c2p->SetConstArcIncr(constArcIncr);
+
+      /* The inverse transforms pair up. */
+      auto inverse = C2PTransformType::New();
+      ITK_TEST_EXPECT_TRUE(p2c->GetInverse(inverse));
+      ITK_TEST_EXPECT_EQUAL(inverse->GetCenter(), center);
+      ITK_TEST_EXPECT_EQUAL(inverse->GetAngleOffset(), angleOffset);
+      ITK_TEST_EXPECT_EQUAL(inverse->GetConstArcIncr(), constArcIncr);
+
+      std::vector<PointType> p2cPoints;
+      std::vector<PointType> c2pPoints;
+      for (const PointType & polarPoint : polarPoints)
+      {
+        PointType point = polarPoint;
+        if (constArcIncr)
+        {
+          point[0] *= point[1];
+        }
+        p2cPoints.push_back(point);
+
+        /* Cartesian points away from the cut where the angle wraps. */
+        const double angle = polarPoint[0];
+        if (angle > 1e-3 && angle < itk::Math::twopi - 1e-3)
+        {
+          c2pPoints.push_back(p2c->TransformPoint(point));
+        }
+      }
+
+      if (!CheckTransform(p2c.GetPointer(), p2cPoints) || !CheckTransform(c2p.GetPointer(), c2pPoints))
+      {
+        std::cout << "AngleOffset " << angleOffset << ", ConstArcIncr " << constArcIncr << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
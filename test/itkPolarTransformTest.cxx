@@ -18,6 +18,7 @@
 #include "itkPolarToCartesianTransform.h"
 #include "itkCartesianToPolarTransform.h"
 #include "itkMath.h"
+#include "itkTestingMacros.h"
 
 int
 itkPolarTransformTest(int, char *[])
@@ -97,5 +98,99 @@ itkPolarTransformTest(int, char *[])
     }
   }
 
+  /* With an angle offset the cartesian to polar angle is wrapped into [0,2*pi),
+   * and the center only shifts the first two dimensions. */
+  const double angleOffset = itk::Math::pi / 2.0;
+  center[1] = 0.5;
+  center[2] = 2.0;
+  center[3] = -3.0;
+  p2c->SetCenter(center);
+  c2p->SetCenter(center);
+  p2c->SetAngleOffset(angleOffset);
+  c2p->SetAngleOffset(angleOffset);
+
+  p[0] = 5.0 * itk::Math::pi / 3.0;
+  p[1] = 2.0;
+  c[0] = center[0] + std::sqrt(3.0); // r*cos(pi/6)
+  c[1] = center[1] + 1.0;            // r*sin(pi/6)
+  for (unsigned int i = 2; i < Dimension; ++i)
+  {
+    c[i] = 3.0;
+    p[i] = c[i];
+  }
+
+  tmp = p2c->TransformPoint(p);
+  for (unsigned int i = 0; i < Dimension; ++i)
+  {
+    if (itk::Math::abs(tmp[i] - c[i]) > epsilon)
+    {
+      std::cout << "Invalid polar to cartesian computed with angle offset: " << tmp << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  tmp = c2p->TransformPoint(c);
+  for (unsigned int i = 0; i < Dimension; ++i)
+  {
+    if (itk::Math::abs(tmp[i] - p[i]) > epsilon)
+    {
+      std::cout << "Invalid cartesian to polar computed with angle offset: " << tmp << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  /* The legacy convention adds the offset above the center and subtracts it below, without wrapping,
+   * and shifts all dimensions by the center. The batch methods follow it too. */
+  p2c->UseLegacyConventionOn();
+  c2p->UseLegacyConventionOn();
+  ITK_TEST_EXPECT_TRUE(p2c->GetUseLegacyConvention());
+  ITK_TEST_EXPECT_TRUE(c2p->GetUseLegacyConvention());
+  ITK_TEST_EXPECT_TRUE(c2p->GetInverseTransform() != nullptr);
+
+  itk::Point<double, Dimension> below(c);
+  below[1] = center[1] - 1.0;
+
+  C2PTransformType::OutputPointType legacyPolar[2];
+  legacyPolar[0] = c;
+  legacyPolar[0][0] = itk::Math::pi / 6.0 + angleOffset;
+  legacyPolar[1] = c;
+  legacyPolar[1][0] = 11.0 * itk::Math::pi / 6.0 - angleOffset;
+  legacyPolar[0][1] = legacyPolar[1][1] = 2.0;
+
+  C2PTransformType::InputPointType  cartesianPoints[2] = { c, below };
+  C2PTransformType::OutputPointType polarPoints[2];
+  c2p->TransformPoints(cartesianPoints, polarPoints, 2);
+  for (unsigned int n = 0; n < 2; ++n)
+  {
+    tmp = c2p->TransformPoint(cartesianPoints[n]);
+    for (unsigned int i = 0; i < Dimension; ++i)
+    {
+      if (itk::Math::abs(tmp[i] - legacyPolar[n][i]) > epsilon ||
+          itk::Math::abs(polarPoints[n][i] - legacyPolar[n][i]) > epsilon)
+      {
+        std::cout << "Invalid legacy cartesian to polar computed: " << tmp << ", " << polarPoints[n] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  P2CTransformType::OutputPointType legacyCartesian(c);
+  P2CTransformType::OutputPointType batchCartesian;
+  for (unsigned int i = 2; i < Dimension; ++i)
+  {
+    legacyCartesian[i] += center[i];
+  }
+  tmp = p2c->TransformPoint(p);
+  p2c->TransformPoints(&p, &batchCartesian, 1);
+  for (unsigned int i = 0; i < Dimension; ++i)
+  {
+    if (itk::Math::abs(tmp[i] - legacyCartesian[i]) > epsilon ||
+        itk::Math::abs(batchCartesian[i] - legacyCartesian[i]) > epsilon)
+    {
+      std::cout << "Invalid legacy polar to cartesian computed: " << tmp << ", " << batchCartesian << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,74 @@
+# ==========================================================================
+#
+#   Copyright NumFOCUS
+#
+#   Licensed under the Apache License, Version 2.0 (the "License");
+#   you may not use this file except in compliance with the License.
+#   You may obtain a copy of the License at
+#
+#          https://www.apache.org/licenses/LICENSE-2.0.txt
+#
+#   Unless required by applicable law or agreed to in writing, software
+#   distributed under the License is distributed on an "AS IS" BASIS,
+#   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#   See the License for the specific language governing permissions and
+#   limitations under the License.
+#
+# ==========================================================================*/
+
+import itk
+import numpy as np
+
+
+def check(transform, points, tolerance):
+    Buffer = itk.PyPolarTransformBuffer[type(transform)]
+    expected = np.array([list(transform.TransformPoint(point.tolist())) for point in points])
+
+    result = Buffer.TransformPoints(transform, points)
+    assert result.shape == points.shape and result.dtype == points.dtype
+    assert np.allclose(result, expected, rtol=tolerance, atol=tolerance), np.abs(result - expected).max()
+
+    # An explicit output array is filled in place, and so is the input itself.
+    output = np.zeros_like(points)
+    assert Buffer.TransformPoints(transform, points, output) is output
+    assert np.array_equal(output, result)
+    inplace = points.copy()
+    Buffer.TransformPoints(transform, inplace, inplace)
+    assert np.array_equal(inplace, result)
+
+    # Mismatching shapes and overlapping but distinct arrays are rejected.
+    for source, target in ((points, np.zeros((len(points) + 1, points.shape[1]), points.dtype)),
+                           (inplace[:-1], inplace[1:])):
+        try:
+            Buffer.TransformPoints(transform, source, target)
+        except ValueError:
+            pass
+        else:
+            raise AssertionError("expected a ValueError")
+
+rng = np.random.default_rng(17)
+# More points than one chunk, so the work is split over threads.
+count = 40000
+
+for pixel, dtype, tolerance in ((itk.D, np.float64, 1e-12), (itk.F, np.float32, 1e-5)):
+    polar = np.column_stack((rng.uniform(0.0, 2.0 * np.pi, count), rng.uniform(0.0, 50.0, count))).astype(dtype)
+    cartesian = rng.uniform(-50.0, 50.0, (count, 2)).astype(dtype)
+
+    p2c = itk.PolarToCartesianTransform[pixel, 2].New()
+    p2c.SetCenter([3.5, -1.25])
+    p2c.SetAngleOffset(0.3)
+    check(p2c, polar, tolerance)
+
+    c2p = itk.CartesianToPolarTransform[pixel, 2].New()
+    c2p.SetCenter([3.5, -1.25])
+    check(c2p, cartesian, tolerance)
+
+    lp2c = itk.LogPolarToCartesianTransform[pixel, 2].New()
+    check(lp2c, np.column_stack((polar[:, 0], np.log1p(polar[:, 1]))).astype(dtype), tolerance)
+
+    c2lp = itk.CartesianToLogPolarTransform[pixel, 2].New()
+    check(c2lp, cartesian, tolerance)
+
+# Lists are converted to arrays of the scalar type of the transform.
+result = itk.PyPolarTransformBuffer[type(c2p)].TransformPoints(c2p, [[1.0, 0.0], [0.0, 1.0]])
+assert result.dtype == np.float32 and result.shape == (2, 2)
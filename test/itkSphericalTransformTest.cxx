@@ -0,0 +1,306 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         https://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkCartesianToSphericalTransform.h"
+#include "itkSphericalToCartesianTransform.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+/* Whether the values agree within epsilon relative to the expected value. */
+bool
+AreClose(const double value, const double expected, const double epsilon)
+{
+  return itk::Math::abs(value - expected) <= epsilon * (1.0 + itk::Math::abs(expected));
+}
+
+/* Compare both batch layouts, in place, with TransformPoint() of the same transform. */
+template <typename TTransform>
+int
+CompareBatchWithTransformPoint(const TTransform *                                       transform,
+                               const std::vector<typename TTransform::InputPointType> & points,
+                               const double                                             epsilon)
+{
+  using PointType = typename TTransform::OutputPointType;
+  using ScalarType = typename TTransform::ScalarType;
+  constexpr unsigned int Dimension = TTransform::SpaceDimension;
+
+  const auto numberOfPoints = static_cast<itk::SizeValueType>(points.size());
+
+  std::vector<PointType> batch(points);
+  transform->TransformPoints(batch.data(), batch.data(), numberOfPoints);
+
+  std::vector<std::vector<ScalarType>> components(Dimension, std::vector<ScalarType>(points.size()));
+  const ScalarType *                   inputComponents[Dimension];
+  ScalarType *                         outputComponents[Dimension];
+  for (unsigned int d = 0; d < Dimension; ++d)
+  {
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+      components[d][i] = points[i][d];
+    }
+    inputComponents[d] = components[d].data();
+    outputComponents[d] = components[d].data();
+  }
+  transform->TransformPoints(inputComponents, outputComponents, numberOfPoints);
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const PointType expected = transform->TransformPoint(points[i]);
+    for (unsigned int d = 0; d < Dimension; ++d)
+    {
+      const bool bothNaN = std::isnan(expected[d]) && std::isnan(batch[i][d]) && std::isnan(components[d][i]);
+      if (!bothNaN &&
+          (!AreClose(batch[i][d], expected[d], epsilon) || !AreClose(components[d][i], expected[d], epsilon)))
+      {
+        std::cout << transform->GetNameOfClass() << ": " << points[i] << " maps to " << batch[i][d] << " / "
+                  << components[d][i] << " in dimension " << d << " instead of " << expected[d] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/* Compare the Jacobian with central differences of TransformPoint(), and the inverse Jacobian with its inverse. */
+template <typename TTransform>
+int
+CompareJacobians(const TTransform * transform, const typename TTransform::InputPointType & point)
+{
+  using PointType = typename TTransform::InputPointType;
+  constexpr unsigned int Dimension = TTransform::SpaceDimension;
+  constexpr double       step = 1e-6;
+
+  typename TTransform::JacobianPositionType jacobian;
+  transform->ComputeJacobianWithRespectToPosition(point, jacobian);
+  typename TTransform::InverseJacobianPositionType inverseJacobian;
+  transform->ComputeInverseJacobianWithRespectToPosition(point, inverseJacobian);
+  const auto product = inverseJacobian * jacobian;
+
+  for (unsigned int c = 0; c < Dimension; ++c)
+  {
+    PointType forward = point;
+    PointType backward = point;
+    forward[c] += step;
+    backward[c] -= step;
+    const PointType mappedForward = transform->TransformPoint(forward);
+    const PointType mappedBackward = transform->TransformPoint(backward);
+    for (unsigned int r = 0; r < Dimension; ++r)
+    {
+      const double difference = (mappedForward[r] - mappedBackward[r]) / (2.0 * step);
+      if (!AreClose(jacobian(r, c), difference, 1e-6) || !AreClose(product(r, c), r == c ? 1.0 : 0.0, 1e-9))
+      {
+        std::cout << transform->GetNameOfClass() << ": Jacobian at " << point << " is " << jacobian
+                  << ", inverse times Jacobian " << product << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+/* Round trips, the batch layouts in every AngleEvaluation mode, and ReturnNaN. */
+template <typename TScalar, unsigned int VDimension>
+int
+TestSphericalTransforms(const double epsilon)
+{
+  using C2STransformType = itk::CartesianToSphericalTransform<TScalar, VDimension>;
+  using S2CTransformType = itk::SphericalToCartesianTransform<TScalar, VDimension>;
+  using PointType = itk::Point<TScalar, VDimension>;
+  using AngleEvaluationEnum = itk::PolarTransformEnums::AngleEvaluation;
+
+  PointType center;
+  center.Fill(0.0);
+  center[0] = 1.5;
+  center[1] = -2.0;
+  center[2] = 0.75;
+
+  auto c2s = C2STransformType::New();
+  c2s->SetCenter(center);
+  c2s->SetAngleOffset(0.3);
+  auto s2c = S2CTransformType::New();
+  ITK_TEST_EXPECT_TRUE(c2s->GetInverse(s2c));
+  ITK_TEST_EXPECT_EQUAL(s2c->GetCenter(), center);
+
+  /* A lattice that avoids the axis through the center, the poles and the seam of the azimuth. */
+  std::vector<PointType> cartesianPoints;
+  std::vector<PointType> sphericalPoints;
+  for (unsigned int i = 0; i < 17; ++i)
+  {
+    for (unsigned int j = 0; j < 13; ++j)
+    {
+      for (unsigned int k = 0; k < 11; ++k)
+      {
+        PointType p;
+        p.Fill(static_cast<TScalar>(0.5 + 0.1 * k));
+        p[0] = -7.13 + 0.87 * i;
+        p[1] = -8.71 + 1.31 * j;
+        p[2] = -4.37 + 0.79 * k;
+        cartesianPoints.push_back(p);
+        p[0] = -3.0 + 0.37 * i;
+        p[1] = -1.5 + 0.25 * j;
+        p[2] = 0.5 + 0.97 * k;
+        sphericalPoints.push_back(p);
+      }
+    }
+  }
+
+  for (const auto angleEvaluation : { AngleEvaluationEnum::Exact, AngleEvaluationEnum::Approximate })
+  {
+    c2s->SetAngleEvaluation(angleEvaluation);
+    s2c->SetAngleEvaluation(angleEvaluation);
+    if (CompareBatchWithTransformPoint(c2s.GetPointer(), cartesianPoints, epsilon) == EXIT_FAILURE ||
+        CompareBatchWithTransformPoint(s2c.GetPointer(), sphericalPoints, epsilon) == EXIT_FAILURE)
+    {
+      return EXIT_FAILURE;
+    }
+
+    for (const auto & point : cartesianPoints)
+    {
+      const PointType spherical = c2s->TransformPoint(point);
+      ITK_TEST_EXPECT_TRUE(0.0 <= spherical[0] && spherical[0] < itk::Math::twopi);
+      ITK_TEST_EXPECT_TRUE(-itk::Math::pi_over_2 <= spherical[1] && spherical[1] <= itk::Math::pi_over_2);
+      const PointType roundTrip = s2c->TransformPoint(spherical);
+      for (unsigned int d = 0; d < VDimension; ++d)
+      {
+        ITK_TEST_EXPECT_TRUE(AreClose(roundTrip[d], point[d], 10 * epsilon));
+      }
+    }
+  }
+
+  /* With ReturnNaN, angles outside [-pi,pi] and [-pi/2,pi/2] map to NaN, in the batch as well. */
+  s2c->ReturnNaNOn();
+  ITK_TEST_EXPECT_TRUE(s2c->GetReturnNaN());
+  for (const auto angleEvaluation : { AngleEvaluationEnum::Exact, AngleEvaluationEnum::Approximate })
+  {
+    s2c->SetAngleEvaluation(angleEvaluation);
+    if (CompareBatchWithTransformPoint(s2c.GetPointer(), sphericalPoints, epsilon) == EXIT_FAILURE)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  PointType outside;
+  outside.Fill(1.0);
+  outside[1] = 1.6;
+  ITK_TEST_EXPECT_TRUE(std::isnan(s2c->TransformPoint(outside)[0]));
+  outside[0] = -3.2;
+  outside[1] = 0.0;
+  ITK_TEST_EXPECT_TRUE(std::isnan(s2c->TransformPoint(outside)[2]));
+  outside[0] = 3.1;
+  ITK_TEST_EXPECT_TRUE(!std::isnan(s2c->TransformPoint(outside)[2]));
+
+  /* The inverse maps back. */
+  s2c->ReturnNaNOff();
+  const auto inverse = s2c->GetInverseTransform();
+  ITK_TEST_EXPECT_TRUE(inverse != nullptr);
+  for (const auto & point : cartesianPoints)
+  {
+    const PointType roundTrip = s2c->TransformPoint(inverse->TransformPoint(point));
+    for (unsigned int d = 0; d < VDimension; ++d)
+    {
+      ITK_TEST_EXPECT_TRUE(AreClose(roundTrip[d], point[d], 10 * epsilon));
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int
+itkSphericalTransformTest(int, char *[])
+{
+  using C2STransformType = itk::CartesianToSphericalTransform<double, 3>;
+  using S2CTransformType = itk::SphericalToCartesianTransform<double, 3>;
+  using PointType = C2STransformType::InputPointType;
+
+  auto c2s = C2STransformType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(c2s, CartesianToSphericalTransform, Transform);
+  auto s2c = S2CTransformType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(s2c, SphericalToCartesianTransform, Transform);
+
+  /* Known values around the origin: the axes and a diagonal. */
+  PointType point;
+  point[0] = 0.0;
+  point[1] = 0.0;
+  point[2] = 2.0;
+  PointType spherical = c2s->TransformPoint(point);
+  ITK_TEST_EXPECT_TRUE(AreClose(spherical[1], itk::Math::pi_over_2, 1e-15));
+  ITK_TEST_EXPECT_TRUE(AreClose(spherical[2], 2.0, 1e-15));
+  point[0] = 0.0;
+  point[1] = -3.0;
+  point[2] = 0.0;
+  spherical = c2s->TransformPoint(point);
+  ITK_TEST_EXPECT_TRUE(AreClose(spherical[0], 1.5 * itk::Math::pi, 1e-15));
+  ITK_TEST_EXPECT_TRUE(AreClose(spherical[1], 0.0, 1e-15));
+  ITK_TEST_EXPECT_TRUE(AreClose(spherical[2], 3.0, 1e-15));
+  point[0] = 1.0;
+  point[1] = 1.0;
+  point[2] = -itk::Math::sqrt2;
+  spherical = c2s->TransformPoint(point);
+  ITK_TEST_EXPECT_TRUE(AreClose(spherical[0], itk::Math::pi_over_4, 1e-15));
+  ITK_TEST_EXPECT_TRUE(AreClose(spherical[1], -itk::Math::pi_over_4, 1e-15));
+  ITK_TEST_EXPECT_TRUE(AreClose(spherical[2], 2.0, 1e-15));
+
+  /* The Jacobians away from the axis and the poles, with a center and an offset. */
+  PointType center;
+  center[0] = 0.5;
+  center[1] = -1.0;
+  center[2] = 2.0;
+  c2s->SetCenter(center);
+  c2s->SetAngleOffset(-0.7);
+  ITK_TEST_EXPECT_TRUE(c2s->GetInverse(s2c));
+  ITK_TEST_SET_GET_VALUE(-0.7, s2c->GetAngleOffset());
+  point[0] = 2.25;
+  point[1] = 1.5;
+  point[2] = 0.75;
+  if (CompareJacobians(c2s.GetPointer(), point) == EXIT_FAILURE ||
+      CompareJacobians(s2c.GetPointer(), c2s->TransformPoint(point)) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  /* Dimensions beyond the third are passed through. */
+  auto c2s4 = itk::CartesianToSphericalTransform<double, 4>::New();
+  auto s2c4 = itk::SphericalToCartesianTransform<double, 4>::New();
+
+  itk::Point<double, 4> point4;
+  point4[0] = 1.0;
+  point4[1] = 2.0;
+  point4[2] = 3.0;
+  point4[3] = -4.5;
+  const auto spherical4 = c2s4->TransformPoint(point4);
+  ITK_TEST_EXPECT_EQUAL(spherical4[3], -4.5);
+  const auto roundTrip4 = s2c4->TransformPoint(spherical4);
+  for (unsigned int d = 0; d < 4; ++d)
+  {
+    ITK_TEST_EXPECT_TRUE(AreClose(roundTrip4[d], point4[d], 1e-14));
+  }
+
+  if (TestSphericalTransforms<double, 3>(1e-11) == EXIT_FAILURE ||
+      TestSphericalTransforms<double, 4>(1e-11) == EXIT_FAILURE ||
+      TestSphericalTransforms<float, 3>(2e-5) == EXIT_FAILURE)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}